@@ -0,0 +1,489 @@
+// many machines at once: the registers of every lane kept as one array per register,
+// and the lanes stepped through the ROM together, eight to an AVX2 vector. Each lane
+// fetches and decodes its own control word, so lanes in different opcodes, halves or
+// steps stay in lockstep; the work of every field is done for all of them and blended
+// in only where the lane's word asks for it
+//
+// memory and the terminal stay in a machine_t per lane, which is also how lanes are
+// loaded and read back
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fake8080.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+bool batch_init (batch_t *b, int lanes, const uint32_t *rom)
+{
+	lanes = (lanes + BATCH_WIDTH - 1) / BATCH_WIDTH * BATCH_WIDTH;
+	if ((lanes <= 0) || ((size_t) lanes + 1 > INT32_MAX / sizeof (machine_t)))
+	{
+		// the memory gathers take 32 bit offsets from the first lane
+		fprintf (stderr, "Can't run %d lanes\n", lanes);
+		return false;
+	}
+	b->lanes = lanes;
+	b->rom = rom;
+	b->reg = calloc ((size_t) lanes * 16, sizeof (uint32_t));
+	b->step = calloc (lanes, sizeof (uint32_t));
+	b->cond = calloc (lanes, sizeof (uint32_t));
+	b->carry = calloc (lanes, sizeof (uint32_t));
+	b->zero = calloc (lanes, sizeof (uint32_t));
+	b->sign = calloc (lanes, sizeof (uint32_t));
+	b->icarry = calloc (lanes, sizeof (uint32_t));
+	b->flip = calloc (lanes, sizeof (uint32_t));
+	b->inte = calloc (lanes, sizeof (uint32_t));
+	b->why = malloc (lanes);
+	// one spare machine so a 32 bit gather of the last lane's last byte stays inside
+	b->m = calloc ((size_t) lanes + 1, sizeof (machine_t));
+	if ((b->reg == NULL) || (b->step == NULL) || (b->cond == NULL) || (b->carry == NULL) || (b->zero == NULL)
+		|| (b->sign == NULL) || (b->icarry == NULL) || (b->flip == NULL) || (b->inte == NULL)
+		|| (b->why == NULL) || (b->m == NULL))
+	{
+		fprintf (stderr, "No memory for %d lanes\n", lanes);
+		return false;
+	}
+	memset (b->why, -1, lanes);
+	return true;
+}
+
+void batch_free (batch_t *b)
+{
+	for (int lane = 0; lane < b->lanes; lane++)
+	{
+		free (b->m[lane].tty);
+	}
+	free (b->reg);
+	free (b->step);
+	free (b->cond);
+	free (b->carry);
+	free (b->zero);
+	free (b->sign);
+	free (b->icarry);
+	free (b->flip);
+	free (b->inte);
+	free (b->why);
+	free (b->m);
+}
+
+// a machine's registers into the lane's columns
+static void lane_put (batch_t *b, int lane, const machine_t *m)
+{
+	int n = b->lanes;
+
+	for (int r = 0; r < 16; r++)
+	{
+		b->reg[r * n + lane] = m->reg[r];
+	}
+	b->step[lane] = m->step;
+	b->cond[lane] = m->cond;
+	b->carry[lane] = m->carry;
+	b->zero[lane] = m->zero;
+	b->sign[lane] = m->sign;
+	b->icarry[lane] = m->icarry;
+	b->flip[lane] = m->flip;
+	b->inte[lane] = m->inte;
+}
+
+// start a lane as a copy of a machine; the lane gets its own terminal output
+void batch_load (batch_t *b, int lane, const machine_t *m)
+{
+	b->m[lane] = *m;
+	b->m[lane].rom = b->rom;
+	b->m[lane].tty = NULL;
+	b->m[lane].tty_len = 0;
+	b->m[lane].tty_cap = 0;
+	b->m[lane].echo = false;
+	lane_put (b, lane, m);
+	b->why[lane] = -1;
+}
+
+// put a lane's registers back into its machine_t, and return that
+machine_t *batch_lane (batch_t *b, int lane)
+{
+	int n = b->lanes;
+	machine_t *m = &b->m[lane];
+
+	for (int r = 0; r < 16; r++)
+	{
+		m->reg[r] = (uint8_t) b->reg[r * n + lane];
+	}
+	m->step = (uint8_t) b->step[lane];
+	m->cond = (uint8_t) b->cond[lane];
+	m->carry = (uint8_t) b->carry[lane];
+	m->zero = (uint8_t) b->zero[lane];
+	m->sign = (uint8_t) b->sign[lane];
+	m->icarry = (uint8_t) b->icarry[lane];
+	m->flip = (uint8_t) b->flip[lane];
+	m->inte = (uint8_t) b->inte[lane];
+	return m;
+}
+
+#ifdef __AVX2__
+
+const bool batch_simd = true;
+
+#define V(x)			_mm256_set1_epi32 (x)
+#define EQ(a, b)		_mm256_cmpeq_epi32 ((a), (b))
+#define AND(a, b)		_mm256_and_si256 ((a), (b))
+#define OR(a, b)		_mm256_or_si256 ((a), (b))
+#define ADD(a, b)		_mm256_add_epi32 ((a), (b))
+#define SUB(a, b)		_mm256_sub_epi32 ((a), (b))
+#define SHR(a, n)		_mm256_srli_epi32 ((a), (n))
+#define SHL(a, n)		_mm256_slli_epi32 ((a), (n))
+#define BLEND(a, b, m)	_mm256_blendv_epi8 ((a), (b), (m))			// b where m is set
+#define BITS(m)			_mm256_movemask_ps (_mm256_castsi256_ps (m))
+
+// the register code after the xchg alias: d, e, h and l swap with each other
+static inline __m256i remap (__m256i r, __m256i flipped)
+{
+	__m256i dehl = AND (_mm256_cmpgt_epi32 (r, V (1)), _mm256_cmpgt_epi32 (V (6), r));
+	return _mm256_xor_si256 (r, AND (AND (dehl, flipped), V (6)));
+}
+
+static inline __m256i load (const uint32_t *p)
+{
+	return _mm256_loadu_si256 ((const __m256i *) p);
+}
+
+static inline void store (uint32_t *p, __m256i v)
+{
+	_mm256_storeu_si256 ((__m256i *) p, v);
+}
+
+// one group of lanes from where they are until every one of them has stopped
+static void run_group (batch_t *b, int g, const run_limits_t *lim)
+{
+	const int n = b->lanes;
+	const int base = g * BATCH_WIDTH;
+	const int *reg = (const int *) b->reg;
+	const int *mem = (const int *) ((const uint8_t *) b->m + offsetof (machine_t, mem));
+	uint32_t *row[16];
+	uint64_t start[BATCH_WIDTH];
+	uint32_t counted[BATCH_WIDTH];
+	uint64_t deadline = UINT64_MAX;
+	uint64_t t = 0;
+
+	for (int r = 0; r < 16; r++)
+	{
+		row[r] = &b->reg[r * n + base];
+	}
+
+	__m256i which = _mm256_setr_epi32 (0, 1, 2, 3, 4, 5, 6, 7);
+	__m256i lane = ADD (V (base), which);
+	__m256i moff = _mm256_mullo_epi32 (lane, V ((int) sizeof (machine_t)));
+	__m256i step = load (&b->step[base]);
+	__m256i cond = load (&b->cond[base]);
+	__m256i carry = load (&b->carry[base]);
+	__m256i zero = load (&b->zero[base]);
+	__m256i sign = load (&b->sign[base]);
+	__m256i icarry = load (&b->icarry[base]);
+	__m256i flip = load (&b->flip[base]);
+	__m256i inte = load (&b->inte[base]);
+	__m256i insns = _mm256_setzero_si256 ();
+	__m256i active = V (-1);
+
+	// a lane already at the cycle limit doesn't move; the rest are looked at again once
+	// the nearest of them gets there
+	for (int l = 0; l < BATCH_WIDTH; l++)
+	{
+		start[l] = b->m[base + l].cycles;
+		if (lim->max_cycles && (start[l] >= lim->max_cycles))
+		{
+			b->why[base + l] = STOP_CYCLES;
+			active = _mm256_andnot_si256 (EQ (which, V (l)), active);
+		}
+		else if (lim->max_cycles && (lim->max_cycles - start[l] < deadline))
+		{
+			deadline = lim->max_cycles - start[l];
+		}
+	}
+
+	while (BITS (active))
+	{
+		__m256i ir = load (row[REG_IR]);
+		__m256i idx = OR (OR (SHL (ir, 6), SHL (cond, 5)), step);
+		__m256i w = _mm256_i32gather_epi32 ((const int *) b->rom, idx, 4);
+		__m256i flipped = EQ (flip, V (1));
+		__m256i src = AND (w, V (15));
+		__m256i dest = AND (SHR (w, 4), V (15));
+		__m256i sel = AND (SHR (w, 8), V (3));
+		__m256i op = AND (SHR (w, 10), V (15));
+
+		// the address: hl (or de) for select 0, then pc, sp and ma, the high register
+		// code being 6 + 2 * select; only worked out if some lane is using memory
+		__m256i addr = V (0);
+		if (BITS (AND (OR (EQ (src, V (REG_M)), EQ (dest, V (REG_M))), active)))
+		{
+			__m256i hi = ADD (V (6), ADD (sel, sel));
+			hi = BLEND (hi, BLEND (V (REG_H), V (REG_D), flipped), EQ (sel, V (0)));
+			__m256i row_off = _mm256_mullo_epi32 (hi, V (n));
+			addr = OR (SHL (_mm256_i32gather_epi32 (reg, ADD (row_off, lane), 4), 8),
+					   _mm256_i32gather_epi32 (reg, ADD (ADD (row_off, V (n)), lane), 4));
+		}
+
+		// the source onto the bus
+		__m256i is_m = AND (EQ (src, V (REG_M)), active);
+		__m256i bus = _mm256_i32gather_epi32 (reg, ADD (_mm256_mullo_epi32 (remap (src, flipped), V (n)), lane), 4);
+		if (BITS (is_m))
+		{
+			__m256i byte = AND (_mm256_mask_i32gather_epi32 (V (0), mem, ADD (moff, addr), is_m, 1), V (0xff));
+			int io = BITS (AND (is_m, EQ (addr, V (SER_IN))));
+			if (io)
+			{
+				uint32_t v[BATCH_WIDTH];
+				store (v, byte);
+				for (int l = 0; l < BATCH_WIDTH; l++)
+				{
+					if (io & (1 << l))
+					{
+						v[l] = machine_read_io (&b->m[base + l]);
+					}
+				}
+				byte = load (v);
+			}
+			bus = BLEND (bus, byte, is_m);
+		}
+		bus = BLEND (bus, OR (OR (carry, SHL (zero, 6)), SHL (sign, 7)), EQ (src, V (REG_FLAG)));
+		bus = BLEND (bus, AND (ir, V (0x38)), EQ (src, V (REG_IR)));
+		bus = AND (bus, V (0xff));
+
+		// the alu: every operation, then the one each lane asked for; the carry out is
+		// bit 8 of the untruncated result except for the rotates
+		// the ones that use the accumulator are left out when no lane wants them, which
+		// is most of the time
+		__m256i res = bus;
+		if (BITS (AND (_mm256_cmpgt_epi32 (V (ALU_INCL), op), active)))
+		{
+			__m256i a = load (row[REG_A]);
+			res = BLEND (res, ADD (a, bus), EQ (op, V (ALU_ADD)));
+			res = BLEND (res, ADD (ADD (a, bus), carry), EQ (op, V (ALU_ADC)));
+			res = BLEND (res, SUB (a, bus), OR (EQ (op, V (ALU_SUB)), EQ (op, V (ALU_CMP))));
+			res = BLEND (res, SUB (SUB (a, bus), carry), EQ (op, V (ALU_SBB)));
+			res = BLEND (res, AND (a, bus), EQ (op, V (ALU_AND)));
+			res = BLEND (res, _mm256_xor_si256 (a, bus), EQ (op, V (ALU_XOR)));
+			res = BLEND (res, OR (a, bus), EQ (op, V (ALU_OR)));
+		}
+		res = BLEND (res, ADD (bus, V (1)), EQ (op, V (ALU_INCL)));
+		res = BLEND (res, ADD (bus, icarry), EQ (op, V (ALU_INCH)));
+		res = BLEND (res, SUB (bus, V (1)), EQ (op, V (ALU_DECL)));
+		res = BLEND (res, SUB (bus, icarry), EQ (op, V (ALU_DECH)));
+		__m256i cout = AND (SHR (res, 8), V (1));
+		__m256i rotate = OR (EQ (op, V (ALU_RAR)), EQ (op, V (ALU_RRC)));
+		if (BITS (AND (rotate, active)))
+		{
+			res = BLEND (res, OR (SHR (bus, 1), SHL (carry, 7)), EQ (op, V (ALU_RAR)));
+			res = BLEND (res, OR (SHR (bus, 1), SHL (bus, 7)), EQ (op, V (ALU_RRC)));
+			cout = BLEND (cout, AND (bus, V (1)), rotate);
+		}
+		res = BLEND (res, V (0), EQ (op, V (ALU_ZERO)));
+		__m256i r = AND (res, V (0xff));
+
+		// the destination: registers and memory a lane at a time, there being no
+		// scatter in AVX2
+		__m256i to = remap (dest, flipped);
+		int writes = BITS (AND (_mm256_cmpgt_epi32 (V (REG_FLAG), dest), active));
+		if (writes)
+		{
+			uint32_t where[BATCH_WIDTH];
+			uint32_t at[BATCH_WIDTH];
+			uint32_t data[BATCH_WIDTH];
+			store (where, to);
+			store (at, addr);
+			store (data, r);
+			for (int l = 0; l < BATCH_WIDTH; l++)
+			{
+				if (writes & (1 << l))
+				{
+					if (where[l] == REG_M)
+					{
+						machine_write (&b->m[base + l], (uint16_t) at[l], (uint8_t) data[l]);
+					}
+					else
+					{
+						row[where[l]][l] = data[l];
+					}
+				}
+			}
+		}
+		__m256i to_ir = AND (EQ (dest, V (REG_IR)), active);
+		if (BITS (to_ir))
+		{
+			store (row[REG_IR], BLEND (ir, r, to_ir));
+		}
+		__m256i to_flag = AND (EQ (dest, V (REG_FLAG)), active);
+		if (BITS (to_ir))
+		{
+			// the condition: ir bits 5-4 pick zero, carry, parity (always clear) or sign
+			__m256i pick = AND (SHR (r, 4), V (3));
+			__m256i flag = BLEND (zero, carry, EQ (pick, V (1)));
+			flag = BLEND (flag, V (0), EQ (pick, V (2)));
+			flag = BLEND (flag, sign, EQ (pick, V (3)));
+			cond = BLEND (cond, _mm256_srli_epi32 (EQ (flag, AND (SHR (r, 3), V (1))), 31), to_ir);
+		}
+		carry = BLEND (carry, AND (r, V (1)), to_flag);
+		zero = BLEND (zero, AND (SHR (r, 6), V (1)), to_flag);
+		sign = BLEND (sign, SHR (r, 7), to_flag);
+
+		// the flag bits of the control word
+		__m256i cf = AND (EQ (AND (w, V (CW_CARRYF)), V (CW_CARRYF)), active);
+		__m256i newc = BLEND (cout, _mm256_xor_si256 (carry, V (1)), EQ (AND (w, V (CW_CMC)), V (CW_CMC)));
+		newc = BLEND (newc, V (1), EQ (AND (w, V (CW_STC)), V (CW_STC)));
+		carry = BLEND (carry, newc, cf);
+		__m256i zs = AND (EQ (AND (w, V (CW_ZSF)), V (CW_ZSF)), active);
+		zero = BLEND (zero, _mm256_srli_epi32 (EQ (r, V (0)), 31), zs);
+		sign = BLEND (sign, SHR (r, 7), zs);
+		icarry = BLEND (icarry, cout, active);
+		inte = BLEND (inte, V (1), AND (EQ (AND (w, V (CW_INTON)), V (CW_INTON)), active));
+		inte = BLEND (inte, V (0), AND (EQ (AND (w, V (CW_INTOFF)), V (CW_INTOFF)), active));
+		flip = _mm256_xor_si256 (flip, AND (SHR (w, 20), AND (active, V (1))));
+
+		// the pc counting on, which only the seq -v overlap variant asks for
+		__m256i pcinc = AND (EQ (AND (w, V (CW_PCINC)), V (CW_PCINC)), active);
+		if (BITS (pcinc))
+		{
+			__m256i pch = load (row[REG_PCH]);
+			__m256i pcl = load (row[REG_PCL]);
+			__m256i pc = ADD (OR (SHL (pch, 8), pcl), V (1));
+			store (row[REG_PCL], BLEND (pcl, AND (pc, V (0xff)), pcinc));
+			store (row[REG_PCH], BLEND (pch, AND (SHR (pc, 8), V (0xff)), pcinc));
+		}
+
+		// and the inc16 variant's pair incrementer, a lane at a time since each lane
+		// may be counting a different pair; the alias leaves a register's low bit alone
+		int pairs = BITS (AND (_mm256_cmpgt_epi32 (AND (w, V (CW_INC16 | CW_DEC16)), V (0)), active));
+		if (pairs)
+		{
+			uint32_t word[BATCH_WIDTH];
+			uint32_t where[BATCH_WIDTH];
+			uint32_t ic[BATCH_WIDTH];
+			store (word, w);
+			store (where, to);
+			store (ic, icarry);
+			for (int l = 0; l < BATCH_WIDTH; l++)
+			{
+				if (pairs & (1 << l))
+				{
+					uint32_t *high = &row[where[l] & ~1u][l];
+					uint32_t *low = &row[where[l] | 1][l];
+					uint32_t v = ((*high << 8) | *low) + ((word[l] & CW_DEC16) ? -1u : 1u);
+					*low = v & 0xff;
+					*high = (v >> 8) & 0xff;
+					ic[l] = (v >> 16) & 1;
+				}
+			}
+			icarry = load (ic);
+		}
+
+		// and the step counter
+		__m256i last = AND (_mm256_cmpgt_epi32 (V (0), w), active);
+		step = BLEND (step, BLEND (AND (ADD (step, V (1)), V (31)), V (0), last), active);
+		insns = SUB (insns, last);
+		t++;
+		if ((t & 0x3fffffff) == 0)
+		{
+			// keep the 32 bit instruction counts from wrapping
+			store (counted, insns);
+			for (int l = 0; l < BATCH_WIDTH; l++)
+			{
+				b->m[base + l].instructions += counted[l];
+			}
+			insns = _mm256_setzero_si256 ();
+		}
+
+		// the cycle limit every clock, the others at the end of an instruction
+		if (t >= deadline)
+		{
+			deadline = UINT64_MAX;
+			for (int l = 0; l < BATCH_WIDTH; l++)
+			{
+				if (b->why[base + l] < 0)
+				{
+					if (start[l] + t >= lim->max_cycles)
+					{
+						b->why[base + l] = STOP_CYCLES;
+						b->m[base + l].cycles = start[l] + t;
+						active = _mm256_andnot_si256 (EQ (which, V (l)), active);
+					}
+					else if (lim->max_cycles - start[l] < deadline)
+					{
+						deadline = lim->max_cycles - start[l];
+					}
+				}
+			}
+			last = AND (last, active);
+		}
+		int ends = BITS (last);
+		if (ends && ((lim->stop_pc >= 0) || lim->idle_polls))
+		{
+			for (int l = 0; l < BATCH_WIDTH; l++)
+			{
+				machine_t *m = &b->m[base + l];
+				int why = -1;
+				if (!(ends & (1 << l)))
+				{
+					continue;
+				}
+				if ((lim->stop_pc >= 0) && (((row[REG_PCH][l] << 8) | row[REG_PCL][l]) == (uint32_t) lim->stop_pc))
+				{
+					why = STOP_PC;
+				}
+				else if (lim->idle_polls && (m->kbd_pos == m->kbd_len) && (m->idle >= lim->idle_polls))
+				{
+					why = STOP_IDLE;
+				}
+				if (why >= 0)
+				{
+					b->why[base + l] = why;
+					m->cycles = start[l] + t;
+					active = _mm256_andnot_si256 (EQ (which, V (l)), active);
+				}
+			}
+		}
+	}
+
+	store (&b->step[base], step);
+	store (&b->cond[base], cond);
+	store (&b->carry[base], carry);
+	store (&b->zero[base], zero);
+	store (&b->sign[base], sign);
+	store (&b->icarry[base], icarry);
+	store (&b->flip[base], flip);
+	store (&b->inte[base], inte);
+	store (counted, insns);
+	for (int l = 0; l < BATCH_WIDTH; l++)
+	{
+		b->m[base + l].instructions += counted[l];
+	}
+}
+
+// run every lane until it reaches one of the limits; a lane left with nothing to stop
+// it would run forever, so the batch needs one
+void batch_run (batch_t *b, const run_limits_t *lim)
+{
+	for (int g = 0; g < b->lanes / BATCH_WIDTH; g++)
+	{
+		run_group (b, g, lim);
+	}
+}
+
+#else
+
+// without AVX2 the lanes run one after another on the plain engine
+const bool batch_simd = false;
+
+void batch_run (batch_t *b, const run_limits_t *lim)
+{
+	for (int lane = 0; lane < b->lanes; lane++)
+	{
+		machine_t *m = batch_lane (b, lane);
+		b->why[lane] = (int8_t) machine_run (m, lim);
+		lane_put (b, lane, m);
+	}
+}
+
+#endif
@@ -0,0 +1,646 @@
+// flattens a Logisim design into the netlist of netlist.h and prints it
+//
+// usage: circ [-s | -c] file.circ [circuit]
+//
+// the circuit is the file's main one unless another is named, so for the whole machine
+//
+//		./circ ALU_181_base.circ > fake8080.net
+//
+// prints every element on a line of its own, its kind (with invert, signed or falling
+// if it has those flags), its input nets, '>', its output nets and then the subcircuit
+// it came from and where it is in it; a ROM is followed by its contents as v2.0 raw
+// values. The named nets come first, as "net n name". -s prints only a count of each
+// kind of element instead, and -c writes the circuit as C for gates.h (see gatesim.c).
+// Either way, anything that looks wrong with the nets is reported on stderr
+//
+//		cc -O2 -o circ circ.c netlist.c
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "gates.h"
+#include "netlist.h"
+
+static void print_words (const uint32_t *w, uint32_t n)
+{
+	int on_line = 0;
+
+	for (uint32_t i = 0; i < n; )
+	{
+		uint32_t run = 1;
+		while ((i + run < n) && (w[i + run] == w[i]))
+		{
+			run++;
+		}
+		if (run > 1)
+		{
+			printf ("%s%u*%x", on_line ? " " : "    ", run, w[i]);
+		}
+		else
+		{
+			printf ("%s%x", on_line ? " " : "    ", w[i]);
+		}
+		if (++on_line == 8)
+		{
+			printf ("\n");
+			on_line = 0;
+		}
+		i += run;
+	}
+	if (on_line)
+	{
+		printf ("\n");
+	}
+}
+
+static void print_netlist (const netlist_t *nl, const char *path)
+{
+	printf ("# %s from %s: %u nets, %u elements\n", nl->top, path, nl->nets, nl->elements);
+	for (uint32_t n = 2; n < nl->nets; n++)
+	{
+		if (nl->net_name[n])
+		{
+			printf ("net %u %s\n", n, nl->names + nl->net_name[n]);
+		}
+	}
+	for (uint32_t i = 0; i < nl->elements; i++)
+	{
+		const nl_element_t *e = &nl->element[i];
+		const uint32_t *in = nl_in (nl, e);
+		const uint32_t *out = nl_out (nl, e);
+		printf ("%s%s%s%s", nl_kind_name[e->kind], (e->flags & NL_INVERT) ? " invert" : "",
+			(e->flags & NL_SIGNED) ? " signed" : "", (e->flags & NL_FALLING) ? " falling" : "");
+		for (uint32_t j = 0; j < e->ins; j++)
+		{
+			printf (" %u", in[j]);
+		}
+		printf (" >");
+		for (uint32_t j = 0; j < e->outs; j++)
+		{
+			printf (" %u", out[j]);
+		}
+		printf (" ; %s (%u,%u)\n", (nl->names[e->name] != 0) ? nl->names + e->name : nl->top, e->x, e->y);
+		if (e->kind == NL_ROM)
+		{
+			print_words (&nl->words[e->words], 1u << e->arg);
+		}
+	}
+}
+
+// ---- circ -c: the netlist as C, for gates.h
+
+// the value on nets, bit 0 first, read from array a
+static void emit_bus (const char *a, const uint32_t *nets, uint32_t width)
+{
+	printf ("(");
+	for (uint32_t b = 0; b < width; b++)
+	{
+		printf ((b == 0) ? "%s[%u]" : " | (unsigned) %s[%u] << %u", a, nets[b], b);
+	}
+	printf (")");
+}
+
+static void emit_bits (const char *fmt, const uint32_t *nets, uint32_t width, const char *value)
+{
+	for (uint32_t b = 0; b < width; b++)
+	{
+		printf ("\t");
+		printf (fmt, nets[b], value, b);
+		printf ("\n");
+	}
+}
+
+// the name of a net for the tables: its pin or tunnel, or for an input with no label
+// of its own the name of its bit 0, without the [0]
+static void emit_name (const char *s, size_t len)
+{
+	printf ("\t{ \"");
+	for (size_t i = 0; i < len; i++)
+	{
+		if ((s[i] == '"') || (s[i] == '\\'))
+		{
+			printf ("\\");
+		}
+		printf ("%c", s[i]);
+	}
+	printf ("\", ");
+}
+
+static int emit_gates (const netlist_t *nl, const char *path)
+{
+	uint32_t *order = malloc ((nl->elements + 1) * sizeof (uint32_t));
+	uint32_t *level = malloc ((nl->elements + 1) * sizeof (uint32_t));
+	uint32_t *state = malloc ((nl->elements + 1) * sizeof (uint32_t));		// first byte, or number
+	uint8_t *bus = calloc (nl->nets, 1);
+	uint8_t *cut = calloc (nl->nets, 1);
+	int ordered = nl_levelize (nl, order, level, cut);
+	if (ordered < 0)
+	{
+		return 1;
+	}
+
+	// a net a loop is cut at is driven into a shadow net after the real ones, and copied
+	// across after its last driver; until then its readers see what it was
+	uint32_t *to = malloc (nl->nets * sizeof (uint32_t));
+	uint32_t *last = calloc (nl->nets, sizeof (uint32_t));
+	uint32_t *mapped = malloc ((nl->npins + 1) * sizeof (uint32_t));
+	uint32_t nets = nl->nets;
+	for (uint32_t n = 0; n < nl->nets; n++)
+	{
+		to[n] = cut[n] ? nets++ : n;
+	}
+	for (int k = 0; k < ordered; k++)
+	{
+		const nl_element_t *e = &nl->element[order[k]];
+		for (uint32_t j = 0; j < e->outs; j++)
+		{
+			last[nl_out (nl, e)[j]] = k;
+		}
+	}
+
+	uint32_t states = 0;
+	uint32_t inputs = 0;
+	uint32_t roms = 0;
+	uint32_t rams = 0;
+	uint32_t levels = 0;
+	for (uint32_t i = 0; i < nl->elements; i++)
+	{
+		const nl_element_t *e = &nl->element[i];
+		switch (e->kind)
+		{
+			case NL_DFF:
+			case NL_JKFF:
+			case NL_REG:
+				state[i] = states;
+				states += e->width;
+				break;
+			case NL_INPUT:
+				state[i] = inputs++;
+				break;
+			case NL_ROM:
+				state[i] = roms++;
+				break;
+			case NL_RAM:
+				if (e->width > 8)
+				{
+					fprintf (stderr, "Can't generate a RAM %u bits wide\n", e->width);
+					return 1;
+				}
+				state[i] = rams++;
+				break;
+			case NL_TRI:
+				for (uint32_t j = 0; j < e->outs; j++)
+				{
+					bus[nl_out (nl, e)[j]] = 1;
+				}
+				break;
+			default:
+				break;
+		}
+		if (e->kind == NL_RAM)
+		{
+			for (uint32_t j = 0; j < e->outs; j++)
+			{
+				bus[nl_out (nl, e)[j]] = 1;
+			}
+		}
+		levels = (level[i] > levels) ? level[i] : levels;
+	}
+	if ((roms > GATES_MEMORIES) || (rams > GATES_MEMORIES))
+	{
+		fprintf (stderr, "Can't generate more than %d ROMs or RAMs\n", GATES_MEMORIES);
+		return 1;
+	}
+
+	printf ("// generated by circ -c from %s, circuit %s: %u nets, %u elements, %u levels\n", path, nl->top,
+		nl->nets, nl->elements, levels);
+	for (uint32_t n = 0; n < nl->nets; n++)
+	{
+		if (cut[n])
+		{
+			printf ("// net %u%s%s%s is on a loop, and settles in another pass when it changes\n", n,
+				nl->net_name[n] ? " (" : "", nl->names + nl->net_name[n], nl->net_name[n] ? ")" : "");
+		}
+	}
+	printf ("\n#include \"gates.h\"\n\n");
+
+	// the tables
+	printf ("const gates_info_t gates_info =\n{\n\t%u, %u, %u, %u, %u,\n\t{", nets, states, inputs, roms, rams);
+	for (uint32_t i = 0, k = 0; i < nl->elements; i++)
+	{
+		if (nl->element[i].kind == NL_ROM)
+		{
+			printf ("%s%u", k++ ? ", " : " ", 1u << nl->element[i].arg);
+		}
+	}
+	printf (" },\n\t{");
+	for (uint32_t i = 0, k = 0; i < nl->elements; i++)
+	{
+		if (nl->element[i].kind == NL_RAM)
+		{
+			printf ("%s%u", k++ ? ", " : " ", 1u << nl->element[i].arg);
+		}
+	}
+	printf (" },\n\t%u, %u, \"%s\"\n};\n\n", nl->elements, levels, nl->top);
+
+	printf ("const gates_name_t gates_inputs[] =\n{\n");
+	for (uint32_t i = 0; i < nl->elements; i++)
+	{
+		const nl_element_t *e = &nl->element[i];
+		if (e->kind == NL_INPUT)
+		{
+			const char *name = nl->names + e->name;
+			size_t len = strlen (name);
+			if ((len == 0) || (strcmp (name, nl->top) == 0))
+			{
+				name = nl->names + nl->net_name[nl_out (nl, e)[0]];
+				len = strlen (name);
+				len -= ((e->width > 1) && (len > 3) && (strcmp (name + len - 3, "[0]") == 0)) ? 3 : 0;
+			}
+			emit_name (name, len);
+			printf ("%u, %u },\n", e->width, state[i]);
+		}
+	}
+	printf ("\t{ NULL, 0, 0 }\n};\n\n");
+
+	printf ("const gates_name_t gates_nets[] =\n{\n");
+	for (uint32_t n = 2; n < nl->nets; n++)
+	{
+		if (nl->net_name[n])
+		{
+			const char *name = nl->names + nl->net_name[n];
+			emit_name (name, strlen (name));
+			printf ("1, %u },\n", n);
+		}
+	}
+	printf ("\t{ NULL, 0, 0 }\n};\n\n");
+
+	printf ("const gates_name_t gates_states[] =\n{\n");
+	for (uint32_t i = 0; i < nl->elements; i++)
+	{
+		const nl_element_t *e = &nl->element[i];
+		if ((e->kind == NL_DFF) || (e->kind == NL_JKFF) || (e->kind == NL_REG))
+		{
+			const char *name = nl->names + e->name;
+			emit_name (name, strlen (name));
+			printf ("%u, %u },\n", e->width, state[i]);
+		}
+	}
+	printf ("\t{ NULL, 0, 0 }\n};\n\n");
+
+	for (uint32_t i = 0; i < nl->elements; i++)
+	{
+		const nl_element_t *e = &nl->element[i];
+		if (e->kind == NL_ROM)
+		{
+			uint32_t words = 1u << e->arg;
+			printf ("static const uint32_t rom%u[%u] =\n{", state[i], words);
+			for (uint32_t w = 0; w < words; w++)
+			{
+				printf ("%s0x%08x,", (w % 8) ? " " : "\n\t", nl->words[e->words + w]);
+			}
+			printf ("\n};\n\n");
+		}
+	}
+	printf ("const uint32_t *const gates_rom_contents[] =\n{\n");
+	for (uint32_t k = 0; k < roms; k++)
+	{
+		printf ("\trom%u,\n", k);
+	}
+	printf ("\tNULL\n};\n\n");
+
+	// the select inputs of each mux, bit by bit
+	for (uint32_t i = 0; i < nl->elements; i++)
+	{
+		const nl_element_t *e = &nl->element[i];
+		if (e->kind == NL_MUX)
+		{
+			const uint32_t *in = nl_in (nl, e);
+			printf ("static const uint16_t mux%u[%u][%u] =\n{\n", i, 1u << e->arg, e->width);
+			for (uint32_t v = 0; v < (1u << e->arg); v++)
+			{
+				printf ("\t{");
+				for (uint32_t b = 0; b < e->width; b++)
+				{
+					printf ("%s%u", b ? ", " : " ", in[v * e->width + b]);
+				}
+				printf (" },\n");
+			}
+			printf ("};\n\n");
+		}
+	}
+
+	// settling: the elements in order, each from the nets before it
+	printf ("void gates_settle (gates_t *g)\n{\n\tuint8_t *n = g->net;\n\tuint8_t *s = g->state;\n\tunsigned v, w;\n");
+	printf ("\tint passes = 0;\n\tint changed;\n\n\tn[0] = 0;\n\tn[1] = 1;\n\tdo\n\t{\n\t\tchanged = 0;\n");
+	for (uint32_t n = 2; n < nl->nets; n++)
+	{
+		if (bus[n])
+		{
+			printf ("\tn[%u] = 0;\n", to[n]);
+		}
+	}
+	for (int k = 0; k < ordered; k++)
+	{
+		uint32_t i = order[k];
+		const nl_element_t *e = &nl->element[i];
+		const uint32_t *in = nl_in (nl, e);
+		const uint32_t *out = mapped;
+		for (uint32_t j = 0; j < e->outs; j++)
+		{
+			mapped[j] = to[nl_out (nl, e)[j]];
+		}
+		printf ("\n\t// %s, %s (%u,%u)\n", nl_kind_name[e->kind], (nl->names[e->name] != 0) ? nl->names + e->name : nl->top, e->x, e->y);
+		switch (e->kind)
+		{
+			case NL_AND:
+			case NL_OR:
+			case NL_XOR:
+			{
+				static const char *op[] = { " & ", " | ", " ^ " };
+				printf ("\tn[%u] = ", out[0]);
+				if (e->flags & NL_INVERT)
+				{
+					printf ("(");
+				}
+				for (uint32_t j = 0; j < e->ins; j++)
+				{
+					printf ("%sn[%u]", j ? op[e->kind - NL_AND] : "", in[j]);
+				}
+				printf ((e->flags & NL_INVERT) ? ") ^ 1;\n" : ";\n");
+				break;
+			}
+
+			case NL_NOT:
+				printf ("\tn[%u] = n[%u] ^ 1;\n", out[0], in[0]);
+				break;
+
+			case NL_TRI:
+				for (uint32_t b = 0; b < e->width; b++)
+				{
+					printf ("\tn[%u] |= n[%u] & n[%u];\n", out[b], in[b], in[e->width]);
+				}
+				break;
+
+			case NL_MUX:
+				printf ("\tv = ");
+				emit_bus ("n", &in[(1u << e->arg) * e->width], e->arg);
+				printf (";\n");
+				for (uint32_t b = 0; b < e->width; b++)
+				{
+					printf ("\tn[%u] = n[mux%u[v][%u]];\n", out[b], i, b);
+				}
+				break;
+
+			case NL_DECODER:
+				printf ("\tv = ");
+				emit_bus ("n", in, e->arg);
+				printf (";\n");
+				for (uint32_t b = 0; b < e->outs; b++)
+				{
+					printf ("\tn[%u] = n[%u] & (v == %u);\n", out[b], in[e->arg], b);
+				}
+				break;
+
+			case NL_COMPARE:
+			{
+				// flipping the sign bits orders two's complement values as unsigned
+				unsigned flip = (e->flags & NL_SIGNED) ? 1u << (e->width - 1) : 0;
+				printf ("\tv = ");
+				emit_bus ("n", in, e->width);
+				printf (" ^ 0x%x;\n\tw = ", flip);
+				emit_bus ("n", &in[e->width], e->width);
+				printf (" ^ 0x%x;\n", flip);
+				printf ("\tn[%u] = v > w;\n\tn[%u] = v == w;\n\tn[%u] = v < w;\n", out[0], out[1], out[2]);
+				break;
+			}
+
+			case NL_DFF:
+			case NL_JKFF:
+			{
+				uint32_t preset = in[e->ins - 2];
+				uint32_t reset = in[e->ins - 1];
+				if (reset != NL_LOW)
+				{
+					printf ("\tif (n[%u])\n\t\ts[%u] = 0;\n", reset, state[i]);
+				}
+				if (preset != NL_LOW)
+				{
+					printf ("\t%sif (n[%u])\n\t\ts[%u] = 1;\n", (reset != NL_LOW) ? "else " : "", preset, state[i]);
+				}
+				printf ("\tn[%u] = s[%u];\n\tn[%u] = s[%u] ^ 1;\n", out[0], state[i], out[1], state[i]);
+				break;
+			}
+
+			case NL_REG:
+				if (in[e->ins - 1] != NL_LOW)
+				{
+					printf ("\tif (n[%u])\n\t\tmemset (&s[%u], 0, %u);\n", in[e->ins - 1], state[i], e->width);
+				}
+				for (uint32_t b = 0; b < e->width; b++)
+				{
+					printf ("\tn[%u] = s[%u];\n", out[b], state[i] + b);
+				}
+				break;
+
+			case NL_ROM:
+				printf ("\tv = g->rom[%u][", state[i]);
+				emit_bus ("n", in, e->arg);
+				printf ("];\n");
+				emit_bits ("n[%u] = (%s >> %u) & 1;", out, e->width, "v");
+				break;
+
+			case NL_RAM:
+				printf ("\tif (n[%u])\n\t{\n\t\tv = g->ram[%u][", in[e->arg + 1], state[i]);
+				emit_bus ("n", in, e->arg);
+				printf ("];\n");
+				for (uint32_t b = 0; b < e->width; b++)
+				{
+					printf ("\t\tn[%u] |= (v >> %u) & 1;\n", out[b], b);
+				}
+				printf ("\t}\n");
+				break;
+
+			case NL_KEYBOARD:
+				printf ("\tv = (g->kbd_pos < g->kbd_len) ? g->kbd[g->kbd_pos] | 0x100 : 0;\n");
+				printf ("\tn[%u] = v >> 8;\n", out[0]);
+				emit_bits ("n[%u] = (%s >> %u) & 1;", &out[1], 7, "v");
+				break;
+
+			case NL_CLOCK:
+				printf ("\tn[%u] = g->clock;\n", out[0]);
+				break;
+
+			case NL_INPUT:
+			{
+				char value[32];
+				snprintf (value, sizeof (value), "g->input[%u]", state[i]);
+				emit_bits ("n[%u] = (%s >> %u) & 1;", out, e->width, value);
+				break;
+			}
+
+			default:
+				break;
+		}
+		for (uint32_t j = 0; j < e->outs; j++)
+		{
+			uint32_t net = nl_out (nl, e)[j];
+			if (cut[net] && (last[net] == (uint32_t) k))
+			{
+				printf ("\tchanged |= n[%u] ^ n[%u];\n\tn[%u] = n[%u];\n", net, to[net], net, to[net]);
+				last[net] = UINT32_MAX;
+			}
+		}
+	}
+	// a loop that really oscillates is left as it is after a few goes
+	printf ("\t}\n\twhile (changed && (++passes < 8));\n}\n\n");
+
+	// the edges: what each clocked element takes from before it
+	printf ("int gates_edge (gates_t *g)\n{\n\tconst uint8_t *n = g->net;\n\tconst uint8_t *p = g->prev;\n");
+	printf ("\tuint8_t *s = g->state;\n\tint edges = 0;\n");
+	for (uint32_t i = 0; i < nl->elements; i++)
+	{
+		const nl_element_t *e = &nl->element[i];
+		const uint32_t *in = nl_in (nl, e);
+		int clock = nl_clock (e);
+		if ((clock < 0) || (in[clock] < 2))
+		{
+			continue;
+		}
+		printf ("\n\t// %s, %s (%u,%u)\n", nl_kind_name[e->kind], (nl->names[e->name] != 0) ? nl->names + e->name : nl->top, e->x, e->y);
+		printf ((e->flags & NL_FALLING) ? "\tif (p[%u] && !n[%u])\n\t{\n" : "\tif (!p[%u] && n[%u])\n\t{\n", in[clock], in[clock]);
+		switch (e->kind)
+		{
+			case NL_DFF:
+				printf ("\t\ts[%u] = p[%u];\n", state[i], in[0]);
+				break;
+
+			case NL_JKFF:
+				printf ("\t\ts[%u] = (p[%u] & (s[%u] ^ 1)) | ((p[%u] ^ 1) & s[%u]);\n", state[i], in[0], state[i], in[1], state[i]);
+				break;
+
+			case NL_REG:
+			{
+				bool always = (in[e->width] == NL_HIGH);
+				if (!always)
+				{
+					printf ("\t\tif (p[%u])\n\t\t{\n", in[e->width]);
+				}
+				for (uint32_t b = 0; b < e->width; b++)
+				{
+					printf ("%s\t\ts[%u] = p[%u];\n", always ? "" : "\t", state[i] + b, in[b]);
+				}
+				if (!always)
+				{
+					printf ("\t\t}\n");
+				}
+				break;
+			}
+
+			case NL_RAM:
+				printf ("\t\tif (p[%u])\n\t\t{\n\t\t\tg->ram[%u][", in[e->arg], state[i]);
+				emit_bus ("p", in, e->arg);
+				printf ("] = ");
+				emit_bus ("p", &in[e->arg + 3], e->width);
+				printf (";\n\t\t}\n");
+				break;
+
+			case NL_TTY:
+				printf ("\t\tif (p[%u])\n\t\t{\n\t\t\tgates_tty (g, ", in[8]);
+				emit_bus ("p", in, 7);
+				printf (");\n\t\t}\n");
+				break;
+
+			case NL_KEYBOARD:
+				printf ("\t\tif (p[%u])\n\t\t{\n", in[1]);
+				printf ("\t\t\tif (g->kbd_pos < g->kbd_len)\n\t\t\t{\n\t\t\t\tg->kbd_pos++;\n\t\t\t\tg->idle = 0;\n\t\t\t}\n");
+				printf ("\t\t\telse\n\t\t\t{\n\t\t\t\tg->idle++;\n\t\t\t}\n\t\t}\n");
+				break;
+		}
+		printf ("\t\tedges++;\n\t}\n");
+	}
+	printf ("\treturn edges;\n}\n");
+
+	free (mapped);
+	free (last);
+	free (to);
+	free (cut);
+	free (bus);
+	free (state);
+	free (level);
+	free (order);
+	return 0;
+}
+
+static void print_summary (const netlist_t *nl, const char *path)
+{
+	uint32_t count[NL_KINDS] = { 0 };
+	uint32_t bits[NL_KINDS] = { 0 };
+
+	for (uint32_t i = 0; i < nl->elements; i++)
+	{
+		count[nl->element[i].kind]++;
+		bits[nl->element[i].kind] += nl->element[i].width;
+	}
+	printf ("%s from %s: %u nets, %u elements, %u pins\n", nl->top, path, nl->nets, nl->elements, nl->npins);
+	for (int k = 0; k < NL_KINDS; k++)
+	{
+		if (count[k])
+		{
+			printf ("  %-10s %6u  %6u bits\n", nl_kind_name[k], count[k], bits[k]);
+		}
+	}
+}
+
+int main (int argc, char **argv)
+{
+	bool summary = false;
+	bool code = false;
+	int opt;
+
+	while ((opt = getopt (argc, argv, "sc")) != -1)
+	{
+		if (opt == 's')
+		{
+			summary = true;
+		}
+		else if (opt == 'c')
+		{
+			code = true;
+		}
+		else
+		{
+			fprintf (stderr, "usage: circ [-s | -c] file.circ [circuit]\n");
+			return 1;
+		}
+	}
+	if ((optind >= argc) || (argc - optind > 2))
+	{
+		fprintf (stderr, "usage: circ [-s | -c] file.circ [circuit]\n");
+		return 1;
+	}
+
+	netlist_t nl;
+	if (!nl_import (&nl, argv[optind], (argc - optind > 1) ? argv[optind + 1] : NULL))
+	{
+		return 1;
+	}
+	int status = 0;
+	if (code)
+	{
+		status = emit_gates (&nl, argv[optind]);
+	}
+	else if (summary)
+	{
+		print_summary (&nl, argv[optind]);
+	}
+	else
+	{
+		print_netlist (&nl, argv[optind]);
+	}
+	nl_check (&nl);
+	nl_free (&nl);
+	return status;
+}
@@ -0,0 +1,65 @@
+// the compiled engine: each instruction runs as one call to the function seq -c
+// generated for its opcode and condition, so the control words are not looked at
+// at all; sequences the generator left out are stepped from the decoded tables
+
+#include "fake8080.h"
+
+int machine_run_compiled (machine_t *m, const microcode_t *mc, const run_limits_t *lim)
+{
+	int why;
+
+	// finish off an instruction we were stopped in the middle of
+	while (m->step != 0)
+	{
+		if (lim->max_cycles && (m->cycles >= lim->max_cycles))
+		{
+			return STOP_CYCLES;
+		}
+		machine_step_decoded (m, mc);
+	}
+
+	for (;;)
+	{
+		// as in the threaded engine, the last few cycles go to one that can stop on
+		// the exact cycle
+		if (lim->max_cycles && (m->cycles + 64 > lim->max_cycles))
+		{
+			return machine_run_decoded (m, mc, lim);
+		}
+
+		int half = (m->reg[REG_IR] << 1) | m->cond;
+		compiled_fetch[half] (m);
+		m->cycles++;
+		if (mc->last[mc->word[mc->seq[half] << 5]])
+		{
+			m->instructions++;
+		}
+		else
+		{
+			half = (m->reg[REG_IR] << 1) | m->cond;
+			if (compiled_ops[half] != NULL)
+			{
+				m->cycles += compiled_ops[half] (m);
+				m->instructions++;
+			}
+			else
+			{
+				// machine_step_decoded counts the instruction when it gets to the end
+				m->step = 1;
+				while (m->step != 0)
+				{
+					if (lim->max_cycles && (m->cycles >= lim->max_cycles))
+					{
+						return STOP_CYCLES;
+					}
+					machine_step_decoded (m, mc);
+				}
+			}
+		}
+		why = machine_limit (m, lim);
+		if (why >= 0)
+		{
+			return why;
+		}
+	}
+}
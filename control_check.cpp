@@ -0,0 +1,68 @@
+// compile time checks on the shape of the microcode table in control.h
+//
+//		c++ -std=c++17 -fsyntax-only control_check.cpp
+//
+// nothing is built; the table is constexpr here, so a half that breaks one of the rules
+// below stops the compile, and the message gives the number of the first such half
+// (opcode * 2 + condition)
+
+#include "control.h"
+
+constexpr int HALVES = 2 * 256;
+
+// every half starts by loading the IR for the instruction after it
+constexpr int first_without_fetch ()
+{
+	for (int half = 0; half < HALVES; half++)
+	{
+		if (control[half * 32] != LD_IR)
+		{
+			return half;
+		}
+	}
+	return -1;
+}
+
+// the step counter only goes back to 0 on a LAST, so there has to be one, and a second
+// would never be reached
+constexpr int first_without_one_last ()
+{
+	for (int half = 0; half < HALVES; half++)
+	{
+		int lasts = 0;
+		for (int step = 0; step < 32; step++)
+		{
+			lasts += (control[half * 32 + step] & LAST) != 0;
+		}
+		if (lasts != 1)
+		{
+			return half;
+		}
+	}
+	return -1;
+}
+
+// anything after the LAST is dead, and is kept at zero so that it can't be mistaken
+// for part of the sequence or end up in a ROM image compared against another
+constexpr int first_with_words_after_last ()
+{
+	for (int half = 0; half < HALVES; half++)
+	{
+		bool ended = false;
+		for (int step = 0; step < 32; step++)
+		{
+			uint32_t w = control[half * 32 + step];
+			if (ended && (w != 0))
+			{
+				return half;
+			}
+			ended |= (w & LAST) != 0;
+		}
+	}
+	return -1;
+}
+
+static_assert (sizeof (control) / sizeof (control[0]) == 64 * 256, "control table must hold 256 opcode blocks of 64 slots");
+static_assert (first_without_fetch () == -1, "a half doesn't start with LD_IR");
+static_assert (first_without_one_last () == -1, "a half doesn't have exactly one LAST");
+static_assert (first_with_words_after_last () == -1, "a half has nonzero words after its LAST");
@@ -0,0 +1,291 @@
+// pre-decoded microcode: the distinct control words split into one array per field
+// when the ROM is loaded, and an engine that runs from those arrays
+
+#include <stdio.h>
+#include <string.h>
+
+#include "fake8080.h"
+
+// the bits of a control word that the engines look at
+#define CW_USED			(0x3fff | CW_CARRYF | CW_ZSF | CW_INTON | CW_INTOFF | CW_STC | CW_CMC | CW_XCHG | CW_PCINC | CW_INC16 | CW_DEC16 | CW_LAST)
+
+// the number of control word w, decoding it if it hasn't been seen before
+static int word_number (microcode_t *mc, uint32_t *seen, uint32_t w)
+{
+	int n = 0;
+
+	w &= CW_USED;
+	while ((n < mc->words) && (seen[n] != w))
+	{
+		n++;
+	}
+	if (n < mc->words)
+	{
+		return n;
+	}
+
+	seen[mc->words++] = w;
+	mc->src[n] = CW_SRC (w);
+	mc->dest[n] = CW_DEST (w);
+	mc->addr[n] = CW_ADDR (w);
+	mc->alu[n] = CW_ALU (w);
+	mc->flags[n] = ((w & CW_CARRYF) ? MF_CARRY : 0)
+				 | ((w & CW_ZSF) ? MF_ZS : 0)
+				 | ((w & CW_INTON) ? MF_INTON : 0)
+				 | ((w & CW_INTOFF) ? MF_INTOFF : 0)
+				 | ((w & CW_STC) ? MF_STC : 0)
+				 | ((w & CW_CMC) ? MF_CMC : 0)
+				 | ((w & CW_XCHG) ? MF_XCHG : 0)
+				 | ((w & CW_PCINC) ? MF_PCINC : 0)
+				 | ((w & CW_INC16) ? MF_INC16 : 0)
+				 | ((w & CW_DEC16) ? MF_DEC16 : 0);
+	mc->last[n] = (w & CW_LAST) != 0;
+	return n;
+}
+
+void microcode_decode (microcode_t *mc, const uint32_t *rom)
+{
+	static uint32_t seen[ROM_WORDS];
+
+	// a half identical to one seen before runs that one's sequence
+	mc->sequences = 0;
+	mc->words = 0;
+	for (int half = 0; half < 512; half++)
+	{
+		int s = 0;
+		while ((s < half) && (memcmp (&rom[s * 32], &rom[half * 32], 32 * sizeof (uint32_t)) != 0))
+		{
+			s++;
+		}
+		if (s < half)
+		{
+			mc->seq[half] = mc->seq[s];
+			continue;
+		}
+
+		mc->seq[half] = mc->sequences++;
+		for (int step = 0; step < 32; step++)
+		{
+			mc->word[(mc->seq[half] << 5) | step] = word_number (mc, seen, rom[half * 32 + step]);
+		}
+	}
+
+	// each 32 word half runs from step 0 to its first LAST
+	memset (mc->length, 0, sizeof (mc->length));
+	for (int half = 0; half < 512; half++)
+	{
+		for (int step = 0; step < 32; step++)
+		{
+			if (mc->last[mc->word[(mc->seq[half] << 5) | step]])
+			{
+				mc->length[half] = step + 1;
+				break;
+			}
+		}
+	}
+}
+
+// put every word of the ROM back together from the sequence its half was given and
+// the word at each step of that, and compare it with the original, as far as the
+// bits the engines look at
+bool microcode_check (const microcode_t *mc, const uint32_t *rom)
+{
+	for (int i = 0; i < ROM_WORDS; i++)
+	{
+		int n = mc->word[microcode_slot (mc, i)];
+		int flags = mc->flags[n];
+		uint32_t w = (uint32_t) mc->src[n] | ((uint32_t) mc->dest[n] << 4) | ((uint32_t) mc->addr[n] << 8)
+				   | ((uint32_t) mc->alu[n] << 10)
+				   | ((flags & MF_CARRY) ? CW_CARRYF : 0)
+				   | ((flags & MF_ZS) ? CW_ZSF : 0)
+				   | ((flags & MF_INTON) ? CW_INTON : 0)
+				   | ((flags & MF_INTOFF) ? CW_INTOFF : 0)
+				   | ((flags & MF_STC) ? CW_STC : 0)
+				   | ((flags & MF_CMC) ? CW_CMC : 0)
+				   | ((flags & MF_XCHG) ? CW_XCHG : 0)
+				   | ((flags & MF_PCINC) ? CW_PCINC : 0)
+				   | ((flags & MF_INC16) ? CW_INC16 : 0)
+				   | ((flags & MF_DEC16) ? CW_DEC16 : 0)
+				   | (mc->last[n] ? CW_LAST : 0);
+		if (w != (rom[i] & CW_USED))
+		{
+			fprintf (stderr, "Decoded microcode differs from the ROM at %04x\n", i);
+			return false;
+		}
+	}
+	return true;
+}
+
+// one microcycle from decoded slot i; the same work as machine_step but without
+// decoding, and without touching the step counter
+static inline void execute (machine_t *m, const microcode_t *mc, int i)
+{
+	int w = mc->word[i];
+	const uint8_t *map = xmap[m->flip];
+	uint16_t addr = machine_address (m, mc->addr[w]);
+	int src = mc->src[w];
+	int dest = mc->dest[w];
+	int flags = mc->flags[w];
+	uint8_t bus;
+	uint8_t cout;
+
+	switch (src)
+	{
+		case REG_M:		bus = machine_read (m, addr);			break;
+		case REG_FLAG:	bus = machine_flags (m);				break;
+		case REG_IR:	bus = m->reg[REG_IR] & 0x38;			break;
+		default:		bus = m->reg[map[src]];					break;
+	}
+
+	uint8_t r = alu (mc->alu[w], m->reg[REG_A], bus, m->carry, m->icarry, &cout);
+
+	switch (dest)
+	{
+		case REG_M:
+			machine_write (m, addr, r);
+			break;
+		case REG_FLAG:
+			m->carry = (r & FLAG_C) != 0;
+			m->zero = (r & FLAG_Z) != 0;
+			m->sign = (r & FLAG_S) != 0;
+			break;
+		case REG_IR:
+			m->reg[REG_IR] = r;
+			m->cond = machine_condition (m, r);
+			break;
+		default:
+			m->reg[map[dest]] = r;
+			break;
+	}
+
+	m->icarry = cout;
+	if (flags)
+	{
+		if (flags & MF_CARRY)
+		{
+			m->carry = (flags & MF_STC) ? 1 : (flags & MF_CMC) ? !m->carry : cout;
+		}
+		if (flags & MF_ZS)
+		{
+			m->zero = (r == 0);
+			m->sign = r >> 7;
+		}
+		if (flags & MF_INTON)
+		{
+			m->inte = 1;
+		}
+		if (flags & MF_INTOFF)
+		{
+			m->inte = 0;
+		}
+		if (flags & MF_XCHG)
+		{
+			m->flip ^= 1;
+		}
+		if (flags & MF_PCINC)
+		{
+			uint16_t pc = machine_pc (m) + 1;
+			m->reg[REG_PCL] = (uint8_t) pc;
+			m->reg[REG_PCH] = pc >> 8;
+		}
+		if (flags & (MF_INC16 | MF_DEC16))
+		{
+			machine_count_pair (m, map, dest, (flags & MF_DEC16) != 0);
+		}
+	}
+	m->cycles++;
+}
+
+// the same, out of line, for engines that only need it for the unusual cases
+void machine_execute (machine_t *m, const microcode_t *mc, int slot)
+{
+	execute (m, mc, slot);
+}
+
+void machine_step_decoded (machine_t *m, const microcode_t *mc)
+{
+	int i = (mc->seq[(m->reg[REG_IR] << 1) | m->cond] << 5) | m->step;
+
+	execute (m, mc, i);
+	if (mc->last[mc->word[i]])
+	{
+		m->step = 0;
+		m->instructions++;
+	}
+	else
+	{
+		m->step = (m->step + 1) & 31;
+	}
+}
+
+// run whole instructions: step 0 comes from whatever block the previous instruction
+// left the sequencer in (it is LD_IR everywhere) and the rest of the sequence length
+// is known from the new block, so there is no per-cycle LAST test. The cycle limit is
+// looked at before the fetch, as raw does before every step, so a machine handed over
+// already at the limit stops without running another
+int machine_run_decoded (machine_t *m, const microcode_t *mc, const run_limits_t *lim)
+{
+	for (;;)
+	{
+		if (lim->max_cycles && (m->cycles >= lim->max_cycles))
+		{
+			return STOP_CYCLES;
+		}
+		if (m->step == 0)
+		{
+			int i = mc->seq[(m->reg[REG_IR] << 1) | m->cond] << 5;
+			execute (m, mc, i);
+			if (mc->last[mc->word[i]])
+			{
+				m->instructions++;
+			}
+			else
+			{
+				int half = (m->reg[REG_IR] << 1) | m->cond;
+				int n = mc->length[half];
+
+				if ((n == 0) || (lim->max_cycles && (m->cycles + n - 1 > lim->max_cycles)))
+				{
+					// no LAST, or the cycle limit falls inside this instruction
+					m->step = 1;
+					goto single;
+				}
+				i = mc->seq[half] << 5;
+				for (int s = 1; s < n; s++)
+				{
+					execute (m, mc, i + s);
+				}
+				m->instructions++;
+			}
+			if (lim->max_cycles && (m->cycles >= lim->max_cycles))
+			{
+				return STOP_CYCLES;
+			}
+			int why = machine_limit (m, lim);
+			if (why >= 0)
+			{
+				return why;
+			}
+			continue;
+		}
+
+	single:
+		while (m->step != 0)
+		{
+			if (lim->max_cycles && (m->cycles >= lim->max_cycles))
+			{
+				return STOP_CYCLES;
+			}
+			machine_step_decoded (m, mc);
+		}
+		if (lim->max_cycles && (m->cycles >= lim->max_cycles))
+		{
+			return STOP_CYCLES;
+		}
+		int why = machine_limit (m, lim);
+		if (why >= 0)
+		{
+			return why;
+		}
+	}
+}
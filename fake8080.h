@@ -0,0 +1,459 @@
+// native simulator for the Fake8080 sequencer
+//
+// this executes the control words that seq.c generates for the sequencer ROM, one
+// microcycle per clock, so the field layout here has to track the table in control.h:
+//
+// bits		name		function
+// 0-3		src			the source of a transfer
+// 4-7		dest		the destination of a transfer
+// 8-9		add			which register pair drives the address bus
+// 10-13	maths		the desired alu funtion
+// 14		carry		we want the carry to be stored
+// 15		zerosign	we want the zero and sign to be stored
+// 16		inton		true to enable interrupts
+// 17		intoff		true to disable interrupts
+// 18		stc			set carry flag
+// 19		cmc			complement carry flag
+// 20		xchg		alias de <=> hl
+// 21		pcinc		the pc counts up at the end of the cycle
+// 22		inc16		the register pair holding dest counts up at the end of the cycle
+// 23		dec16		or down; icarry is the carry or borrow out of the pair
+// 31		last		this is the last cycle of an instruction
+//
+// the ROM address is the instruction register in bits 6-13, the condition in bit 5 and
+// the microstep counter in bits 0-4
+
+#ifndef FAKE8080_H
+#define FAKE8080_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define ROM_WORDS		(64 * 256)
+#define MEM_SIZE		65536
+
+#define PAGE_SIZE		256				// memory is tracked in pages for snapshots
+#define PAGES			(MEM_SIZE / PAGE_SIZE)
+
+#define SER_IN			0xf000			// keyboard, 0x00 if there is no character waiting
+#define SER_OUT			0xf100			// terminal
+
+// control word fields
+#define CW_SRC(w)		((w) & 0x0f)
+#define CW_DEST(w)		(((w) >> 4) & 0x0f)
+#define CW_ADDR(w)		(((w) >> 8) & 0x03)
+#define CW_ALU(w)		(((w) >> 10) & 0x0f)
+
+#define CW_CARRYF		(1u << 14)
+#define CW_ZSF			(1u << 15)
+#define CW_INTON		(1u << 16)
+#define CW_INTOFF		(1u << 17)
+#define CW_STC			(1u << 18)
+#define CW_CMC			(1u << 19)
+#define CW_XCHG			(1u << 20)
+#define CW_PCINC		(1u << 21)
+#define CW_INC16		(1u << 22)
+#define CW_DEC16		(1u << 23)
+#define CW_LAST			(1u << 31)
+
+// register codes, as used by the src and dest fields
+enum
+{
+	REG_B, REG_C, REG_D, REG_E, REG_H, REG_L, REG_M, REG_A,
+	REG_PCH, REG_PCL, REG_SPH, REG_SPL, REG_MAH, REG_MAL, REG_FLAG, REG_IR
+};
+
+// address bus sources
+enum
+{
+	ADDR_HL, ADDR_PC, ADDR_SP, ADDR_MA
+};
+
+// alu operations
+enum
+{
+	ALU_ADD, ALU_ADC, ALU_SUB, ALU_SBB, ALU_AND, ALU_XOR, ALU_OR, ALU_CMP,
+	ALU_INCL, ALU_INCH, ALU_DECL, ALU_DECH, ALU_RAR, ALU_RRC, ALU_ZERO, ALU_PASS
+};
+
+// bits of the flag register as seen on the bus (push psw, pop psw)
+#define FLAG_C			0x01
+#define FLAG_Z			0x40
+#define FLAG_S			0x80
+
+struct snapshot;
+
+typedef struct
+{
+	// the register file is indexed by the src/dest codes; reg[REG_M] and reg[REG_FLAG]
+	// are never used and reg[REG_IR] is the instruction register
+	uint8_t		reg[16];
+	uint8_t		step;				// microstep counter
+	uint8_t		cond;				// which half of the 64 word block we are running
+	uint8_t		carry;
+	uint8_t		zero;
+	uint8_t		sign;
+	uint8_t		icarry;				// alu carry from the previous cycle, for inch and dech
+	uint8_t		flip;				// de and hl are swapped
+	uint8_t		inte;				// interrupts enabled
+
+	uint64_t	cycles;
+	uint64_t	instructions;
+
+	const uint32_t *rom;
+
+	// terminal: keyboard script in, everything written to SER_OUT is kept
+	const uint8_t *kbd;
+	size_t		kbd_len;
+	size_t		kbd_pos;
+	uint8_t		*tty;
+	size_t		tty_len;
+	size_t		tty_cap;
+	bool		echo;				// copy terminal output to stdout as well
+	uint64_t	idle;				// empty keyboard reads since the last character in or out
+
+	// mem is the snapshot it was last restored from but for the dirty pages; NULL
+	// after anything else has been loaded into it
+	const struct snapshot *origin;
+	uint8_t		dirty[PAGES];
+
+	uint8_t		mem[MEM_SIZE];
+} machine_t;
+
+// why machine_run returned
+enum
+{
+	STOP_CYCLES, STOP_PC, STOP_IDLE, STOP_TRIGGER
+};
+
+// the alu: a is always the accumulator, b is whatever the source put on the bus
+// carry is the carry flag (adc, sbb, rar) and icarry the carry out of the previous
+// cycle (inch, dech); subtraction reports a borrow as a carry, as the 8080 does
+static inline uint8_t alu (int op, uint8_t a, uint8_t b, uint8_t carry, uint8_t icarry, uint8_t *cout)
+{
+	unsigned r;
+
+	switch (op)
+	{
+		case ALU_ADD:	r = a + b;				*cout = r >> 8;			break;
+		case ALU_ADC:	r = a + b + carry;		*cout = r >> 8;			break;
+		case ALU_SUB:
+		case ALU_CMP:	r = a - b;				*cout = (r >> 8) & 1;	break;
+		case ALU_SBB:	r = a - b - carry;		*cout = (r >> 8) & 1;	break;
+		case ALU_AND:	r = a & b;				*cout = 0;				break;
+		case ALU_XOR:	r = a ^ b;				*cout = 0;				break;
+		case ALU_OR:	r = a | b;				*cout = 0;				break;
+		case ALU_INCL:	r = b + 1;				*cout = r >> 8;			break;
+		case ALU_INCH:	r = b + icarry;			*cout = r >> 8;			break;
+		case ALU_DECL:	r = b - 1;				*cout = (r >> 8) & 1;	break;
+		case ALU_DECH:	r = b - icarry;			*cout = (r >> 8) & 1;	break;
+		case ALU_RAR:	r = (b >> 1) | (carry << 7);	*cout = b & 1;	break;
+		case ALU_RRC:	r = (b >> 1) | (b << 7);		*cout = b & 1;	break;
+		case ALU_ZERO:	r = 0;					*cout = 0;				break;
+		default:		r = b;					*cout = 0;				break;
+	}
+	return (uint8_t) r;
+}
+
+// memory, with the terminal (machine.c) decoded out of the way of ordinary accesses
+uint8_t machine_read_io (machine_t *m);
+void machine_write_io (machine_t *m, uint8_t data);
+
+static inline uint8_t machine_read (machine_t *m, uint16_t addr)
+{
+	return (addr == SER_IN) ? machine_read_io (m) : m->mem[addr];
+}
+
+static inline void machine_write (machine_t *m, uint16_t addr, uint8_t data)
+{
+	if (addr == SER_OUT)
+	{
+		machine_write_io (m, data);
+	}
+	else
+	{
+		m->mem[addr] = data;
+		m->dirty[addr / PAGE_SIZE] = 1;
+	}
+}
+
+// register codes after the xchg alias; when flip is set D <=> H and E <=> L
+extern const uint8_t xmap[2][16];
+
+static inline uint16_t machine_address (const machine_t *m, int sel)
+{
+	switch (sel)
+	{
+		case ADDR_HL:	return m->flip ? (m->reg[REG_D] << 8) | m->reg[REG_E]
+									   : (m->reg[REG_H] << 8) | m->reg[REG_L];
+		case ADDR_PC:	return (m->reg[REG_PCH] << 8) | m->reg[REG_PCL];
+		case ADDR_SP:	return (m->reg[REG_SPH] << 8) | m->reg[REG_SPL];
+		default:		return (m->reg[REG_MAH] << 8) | m->reg[REG_MAL];
+	}
+}
+
+// the 16 bit incrementer: the pair holding register r (after the xchg alias) counts
+// by one up or down, and the carry or borrow out of it goes to icarry as the alu's
+// would from the two halves
+static inline void machine_count_pair (machine_t *m, const uint8_t *map, int r, bool down)
+{
+	int high = map[r & ~1];
+	int low = map[r | 1];
+	unsigned v = ((m->reg[high] << 8) | m->reg[low]) + (down ? -1u : 1u);
+
+	m->reg[low] = (uint8_t) v;
+	m->reg[high] = (uint8_t) (v >> 8);
+	m->icarry = (v >> 16) & 1;
+}
+
+// the control words decoded once at load time into one dense array per field, so a
+// microcycle is a handful of indexed loads instead of shifts and masks
+#define MF_CARRY		0x01
+#define MF_ZS			0x02
+#define MF_INTON		0x04
+#define MF_INTOFF		0x08
+#define MF_STC			0x10
+#define MF_CMC			0x20
+#define MF_XCHG			0x40
+#define MF_PCINC		0x80
+#define MF_INC16		0x100
+#define MF_DEC16		0x200
+
+// the decoded microcode, deduplicated twice over: each distinct 32 word half of the
+// ROM is stored once as a sequence (an opcode that doesn't test a condition has the
+// same one in both halves, and some opcodes share theirs), and each step of a
+// sequence holds the number of a distinct control word, of which there are a few
+// hundred. A slot is (sequence << 5) | step; only the first sequences * 32 slots and
+// the first words word numbers are used
+typedef struct
+{
+	uint8_t		src[ROM_WORDS];		// by word number
+	uint8_t		dest[ROM_WORDS];
+	uint8_t		addr[ROM_WORDS];
+	uint8_t		alu[ROM_WORDS];
+	uint16_t	flags[ROM_WORDS];	// MF_ bits
+	uint8_t		last[ROM_WORDS];
+	uint16_t	word[ROM_WORDS];	// by slot
+	uint8_t		length[512];		// steps up to and including LAST for each (opcode, condition); 0 if there is none
+	uint16_t	seq[512];			// the sequence each (opcode, condition) runs
+	int			sequences;
+	int			words;
+} microcode_t;
+
+// the slot holding the decoded control word at ROM address i
+static inline int microcode_slot (const microcode_t *mc, int i)
+{
+	return (mc->seq[i >> 5] << 5) | (i & 31);
+}
+
+// threaded code: every ROM slot bound at load time to a handler specialised for its
+// kind of transfer, with the operands already pulled out; the handler for the last
+// step of a sequence is a separate entry so there is no LAST test per cycle
+// kinds are even; the odd number above each is the same handler for the last step
+//
+// the last four are superoperators, one record doing the work of a run of steps that
+// turns up all over the table: the two halves of a register pair increment or
+// decrement, an sp decrement and the push after it, and the six steps of dad. inc16
+// and dec16 are also the records for the one step the pair incrementer of the seq -v
+// inc16 variant takes
+enum
+{
+	OP_GENERIC = 0, OP_FETCH = 2, OP_MOV = 4, OP_LOAD = 6, OP_STORE = 8,
+	OP_INCL = 10, OP_INCH = 12, OP_DECL = 14, OP_DECH = 16, OP_ALU = 18,
+	OP_INC16 = 20, OP_DEC16 = 22, OP_PUSH = 24, OP_DAD = 26,
+	OP_KINDS = 28
+};
+
+typedef struct
+{
+	const void	*handler;			// label address, for the computed goto engine
+	uint8_t		op;					// OP_ kind + last
+	uint8_t		span;				// ROM slots the record does the work of
+	uint8_t		src;				// inc16 and dec16: the low register; dad: the one added to l
+	uint8_t		dest;				// inc16 and dec16: the high register; dad: the one added to h
+	uint8_t		addr;
+	uint8_t		alu;
+	uint16_t	flags;
+} thread_op_t;
+
+typedef struct
+{
+	thread_op_t	op[ROM_WORDS];		// by slot, as the decoded fields are
+	const microcode_t *mc;
+} thread_t;
+
+typedef struct
+{
+	uint64_t	max_cycles;			// 0 for no limit
+	int			stop_pc;			// -1 for none; checked at instruction boundaries
+	uint64_t	idle_polls;			// stop after this many empty keyboard reads once the script is used up, 0 to ignore
+} run_limits_t;
+
+// compiled code: seq -c writes ops.c, with a function per opcode and condition that
+// runs steps 1 to LAST of the sequence and returns how many that was (NULL where the
+// sequence has to be stepped), and one per half for the fetch in step 0
+typedef int (*compiled_op_t) (machine_t *m);
+typedef void (*compiled_fetch_t) (machine_t *m);
+
+// just in time translation of the 8080 program (jit.c), a block of code per run of
+// instructions from one start address with de and hl swapped or not
+#define JIT_CODE_SIZE	(16 << 20)
+#define JIT_BLOCKS		16384
+#define JIT_INSNS		32				// instructions in a block at most
+
+typedef struct
+{
+	void		(*code) (machine_t *m, void *j);
+	int			first_page;			// the pages its code was taken from
+	int			last_page;
+	uint32_t	max_cycles;			// on the longest path through it
+} jit_block_t;
+
+typedef struct
+{
+	const microcode_t *mc;
+	machine_t	*m;					// the machine being run
+	uint8_t		exit;				// set by the memory helpers to leave the block after this instruction
+	int			stop_pc;
+	bool		ok[256];			// opcodes that can be translated
+	uint8_t		code_page[256];		// pages that translated code was taken from
+	uint8_t		code_byte[MEM_SIZE];	// and the bytes in them
+	uint8_t		*code;				// NULL if there is no translator
+	size_t		code_used;
+	jit_block_t	block[JIT_BLOCKS];
+	int			blocks;
+	jit_block_t	*lookup[2][MEM_SIZE];	// by flip and start address
+	uint64_t	translated;
+	uint64_t	invalidated;
+} jit_t;
+
+// a machine frozen between runs (snapshot.c): everything but the rom, the terminal
+// output and the limits. Memory is held as shared read only pages, NULL for a page of
+// zeroes, so a snapshot taken from a machine restored from another one only copies
+// the pages written in between, and restoring a machine from the snapshot it came
+// from only copies back the pages it has written since
+typedef struct
+{
+	uint32_t	refs;
+	uint8_t		data[PAGE_SIZE];
+} page_t;
+
+typedef struct snapshot
+{
+	uint32_t	rom_hash;			// of the microcode it was running
+	uint8_t		reg[16];
+	uint8_t		step;
+	uint8_t		cond;
+	uint8_t		carry;
+	uint8_t		zero;
+	uint8_t		sign;
+	uint8_t		icarry;
+	uint8_t		flip;
+	uint8_t		inte;
+	uint64_t	cycles;
+	uint64_t	instructions;
+	uint64_t	idle;
+	uint8_t		*kbd;				// keyboard input not yet read
+	size_t		kbd_len;
+	page_t		*page[PAGES];
+} snapshot_t;
+
+// fast forward (fast.c): whole instructions at a time until the trigger, which is
+// checked at instruction boundaries
+typedef struct
+{
+	int			pc;					// -1 for none
+	uint64_t	cycle;				// stop before the instruction that would pass this, 0 for none
+	bool		output;				// stop after an instruction that writes to SER_OUT
+} trigger_t;
+
+typedef struct
+{
+	const microcode_t *mc;
+	bool		ok[512];			// halves emulated rather than stepped
+	int			halves;				// how many
+	uint64_t	fast;				// instructions emulated
+	uint64_t	stepped;			// and stepped
+} fast_t;
+
+// many machines stepped in lockstep (batch.c): the registers and flags of every lane
+// kept one array per register, memory and the terminal in a machine_t per lane
+#define BATCH_WIDTH		8					// lanes to a vector
+
+typedef struct
+{
+	int			lanes;				// a multiple of BATCH_WIDTH
+	const uint32_t *rom;
+	uint32_t	*reg;				// reg[r * lanes + lane]
+	uint32_t	*step;
+	uint32_t	*cond;
+	uint32_t	*carry;
+	uint32_t	*zero;
+	uint32_t	*sign;
+	uint32_t	*icarry;
+	uint32_t	*flip;
+	uint32_t	*inte;
+	int8_t		*why;				// STOP_ reason for each lane, -1 until it stops
+	machine_t	*m;					// memory, terminal and counts for each lane
+} batch_t;
+
+// rom.c
+long load_raw (const char *path, void *dst, size_t max, int width);
+uint32_t rom_hash (const uint32_t *rom, size_t words);
+
+// machine.c
+void machine_reset (machine_t *m, const uint32_t *rom);
+void machine_input (machine_t *m, const uint8_t *text, size_t len);
+void machine_type (machine_t *m, const uint8_t *text, size_t len);
+uint16_t machine_pc (const machine_t *m);
+uint8_t machine_flags (const machine_t *m);
+uint8_t machine_condition (const machine_t *m, uint8_t ir);
+uint32_t machine_step (machine_t *m);
+int machine_limit (const machine_t *m, const run_limits_t *lim);
+int machine_run (machine_t *m, const run_limits_t *lim);
+
+// decode.c
+void microcode_decode (microcode_t *mc, const uint32_t *rom);
+bool microcode_check (const microcode_t *mc, const uint32_t *rom);
+void machine_execute (machine_t *m, const microcode_t *mc, int slot);
+void machine_step_decoded (machine_t *m, const microcode_t *mc);
+int machine_run_decoded (machine_t *m, const microcode_t *mc, const run_limits_t *lim);
+
+// threaded.c
+extern const bool threaded_goto;
+void thread_build (thread_t *t, const microcode_t *mc, bool fusion);
+int machine_run_threaded (machine_t *m, const thread_t *t, const run_limits_t *lim);
+int machine_run_switch (machine_t *m, const thread_t *t, const run_limits_t *lim);
+
+// compiled.c, and ops.c generated by seq -c
+extern const compiled_op_t compiled_ops[512];
+extern const compiled_fetch_t compiled_fetch[512];
+extern const uint32_t compiled_rom_hash;
+int machine_run_compiled (machine_t *m, const microcode_t *mc, const run_limits_t *lim);
+
+// snapshot.c
+void snapshot_take (snapshot_t *s, const machine_t *m);
+void snapshot_restore (machine_t *m, const snapshot_t *s);
+void snapshot_free (snapshot_t *s);
+bool snapshot_save (const snapshot_t *s, const char *path);
+bool snapshot_load (snapshot_t *s, const char *path, const uint32_t *rom);
+
+// fast.c
+bool fast_init (fast_t *f, const microcode_t *mc);
+int machine_run_fast (machine_t *m, fast_t *f, const run_limits_t *lim, const trigger_t *trig);
+
+// batch.c
+extern const bool batch_simd;
+bool batch_init (batch_t *b, int lanes, const uint32_t *rom);
+void batch_free (batch_t *b);
+void batch_load (batch_t *b, int lane, const machine_t *m);
+machine_t *batch_lane (batch_t *b, int lane);
+void batch_run (batch_t *b, const run_limits_t *lim);
+
+// jit.c
+extern const bool jit_native;
+bool jit_init (jit_t *j, const microcode_t *mc);
+int machine_run_jit (machine_t *m, jit_t *j, const run_limits_t *lim);
+
+#endif
@@ -0,0 +1,693 @@
+// run a manifest of jobs on the native simulator, spread over every core
+//
+// usage: farm [-j threads] [-v] [-a microcode]... manifest
+//
+// each line of the manifest is one job:
+//
+//		microcode image input expected [n=cycles] [x=stop_pc] [w=idle_polls]
+//
+// with - for no input or no expected output, and # starting a comment. Paths are taken
+// from the manifest's directory. A job passes if it stops by its stop address or by
+// going idle (or at the cycle limit if that's all it has) and its terminal output,
+// with cr/lf turned into newlines, is the expected file. For example:
+//
+//		seq.raw  cpudiag.raw  -  cpudiag.out  x=0 n=1000000
+//		seq.raw  tiny.raw  for.bas  for.out  w=10000
+//		seq.raw  warm.snap  run.bas  run.out  w=10000
+//
+// an image whose name ends in .snap is a snapshot saved by sim -s, which the job carries
+// on from: the input is typed after anything the snapshot hadn't read yet and n= counts
+// from where it stopped. Each snapshot is loaded once, and a worker running several jobs
+// from the same one in a row only copies back the memory the last one wrote
+//
+// -a runs every job again on another microcode table in place of its own, as many
+// times as it is given, and prints each job's runs side by side: microcycles, host
+// time, and whether the terminal output is the same as on the job's own table. A
+// snapshot only loads with the table it was taken with, so these can't have snapshot
+// jobs. The runs are timed while the other workers are busy; -j 1 gives steadier times
+//
+// the jobs are dealt out round the workers' queues and a worker that runs out steals
+// from the others, so a few long jobs don't hold up the rest
+//
+//		cc -O2 -pthread -o farm farm.c machine.c decode.c threaded.c snapshot.c rom.c
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "fake8080.h"
+
+#define MAX_PATH		1024
+#define MAX_JOBS		4096
+#define MAX_ROMS		64
+#define MAX_SNAPSHOTS	64
+#define MAX_WORKERS		256
+#define MAX_OTHERS		16
+
+// a microcode table, loaded and bound once however many jobs use it
+typedef struct
+{
+	char		path[MAX_PATH];
+	uint32_t	rom[ROM_WORDS];
+	microcode_t	mc;
+	thread_t	thread;
+} table_t;
+
+typedef struct
+{
+	char		path[MAX_PATH];
+	const table_t *table;			// the microcode it was taken with
+	snapshot_t	snap;
+} start_t;
+
+typedef struct
+{
+	int			line;
+	table_t		*table;
+	const start_t *start;			// NULL unless the image is a snapshot
+	char		image[MAX_PATH];
+	char		input[MAX_PATH];		// empty for none
+	char		expected[MAX_PATH];		// empty for none
+	run_limits_t lim;
+
+	int			base;				// for -a, the job this runs again on another table; else -1
+
+	// filled in by the worker
+	bool		pass;
+	const char	*note;
+	int			why;
+	uint64_t	cycles;
+	uint64_t	instructions;
+	double		seconds;
+	uint8_t		*text;				// the terminal output
+	size_t		text_len;
+} job_t;
+
+// a worker's queue: it takes jobs from the bottom, thieves from the top
+typedef struct
+{
+	pthread_mutex_t lock;
+	int			job[MAX_JOBS];
+	int			top;
+	int			bottom;
+	int			id;
+	int			stolen;
+} queue_t;
+
+static table_t *tables[MAX_ROMS];
+static int ntables;
+static table_t *others[MAX_OTHERS];
+static int nothers;
+static start_t *starts[MAX_SNAPSHOTS];
+static int nstarts;
+static job_t jobs[MAX_JOBS];
+static int njobs;
+static queue_t queue[MAX_WORKERS];
+static int workers;
+
+static double now (void)
+{
+	struct timespec ts;
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint8_t *read_file (const char *path, size_t *len)
+{
+	FILE *f = fopen (path, "rb");
+	if (f == NULL)
+	{
+		return NULL;
+	}
+	size_t cap = 4096;
+	uint8_t *buf = malloc (cap);
+	*len = 0;
+	size_t got;
+	while ((got = fread (buf + *len, 1, cap - *len, f)) > 0)
+	{
+		*len += got;
+		if (*len == cap)
+		{
+			cap *= 2;
+			buf = realloc (buf, cap);
+		}
+	}
+	fclose (f);
+	return buf;
+}
+
+// a manifest path, relative to the manifest's directory unless it's absolute
+static void resolve (char *out, const char *dir, const char *path)
+{
+	if ((path[0] == '/') || (dir[0] == 0))
+	{
+		snprintf (out, MAX_PATH, "%s", path);
+	}
+	else
+	{
+		snprintf (out, MAX_PATH, "%s/%s", dir, path);
+	}
+}
+
+static table_t *load_table (const char *path)
+{
+	for (int i = 0; i < ntables; i++)
+	{
+		if (strcmp (tables[i]->path, path) == 0)
+		{
+			return tables[i];
+		}
+	}
+	if (ntables == MAX_ROMS)
+	{
+		fprintf (stderr, "Too many microcode tables\n");
+		return NULL;
+	}
+	table_t *t = malloc (sizeof (table_t));
+	snprintf (t->path, MAX_PATH, "%s", path);
+	if (load_raw (path, t->rom, ROM_WORDS, 4) < 0)
+	{
+		free (t);
+		return NULL;
+	}
+	microcode_decode (&t->mc, t->rom);
+	if (!microcode_check (&t->mc, t->rom))
+	{
+		free (t);
+		return NULL;
+	}
+	thread_build (&t->thread, &t->mc, true);
+	tables[ntables++] = t;
+	return t;
+}
+
+static const start_t *load_start (const char *path, const table_t *table)
+{
+	for (int i = 0; i < nstarts; i++)
+	{
+		if ((strcmp (starts[i]->path, path) == 0) && (starts[i]->table == table))
+		{
+			return starts[i];
+		}
+	}
+	if (nstarts == MAX_SNAPSHOTS)
+	{
+		fprintf (stderr, "Too many snapshots\n");
+		return NULL;
+	}
+	start_t *s = malloc (sizeof (start_t));
+	snprintf (s->path, MAX_PATH, "%s", path);
+	s->table = table;
+	if (!snapshot_load (&s->snap, path, table->rom))
+	{
+		free (s);
+		return NULL;
+	}
+	starts[nstarts++] = s;
+	return s;
+}
+
+static bool read_manifest (const char *path)
+{
+	char dir[MAX_PATH];
+	char line[4 * MAX_PATH];
+	int number = 0;
+
+	snprintf (dir, MAX_PATH, "%s", path);
+	char *slash = strrchr (dir, '/');
+	if (slash != NULL)
+	{
+		*slash = 0;
+	}
+	else
+	{
+		dir[0] = 0;
+	}
+
+	FILE *f = fopen (path, "r");
+	if (f == NULL)
+	{
+		fprintf (stderr, "Can't open %s\n", path);
+		return false;
+	}
+	while (fgets (line, sizeof (line), f) != NULL)
+	{
+		char *field[8];
+		int fields = 0;
+
+		number++;
+		char *hash = strchr (line, '#');
+		if (hash != NULL)
+		{
+			*hash = 0;
+		}
+		for (char *tok = strtok (line, " \t\r\n"); (tok != NULL) && (fields < 8); tok = strtok (NULL, " \t\r\n"))
+		{
+			field[fields++] = tok;
+		}
+		if (fields == 0)
+		{
+			continue;
+		}
+		if ((fields < 4) || (njobs == MAX_JOBS))
+		{
+			fprintf (stderr, "%s:%d: %s\n", path, number, (fields < 4) ? "needs microcode, image, input and expected output" : "too many jobs");
+			fclose (f);
+			return false;
+		}
+
+		job_t *j = &jobs[njobs];
+		char micro[MAX_PATH];
+		memset (j, 0, sizeof (*j));
+		j->line = number;
+		j->base = -1;
+		j->lim.stop_pc = -1;
+		resolve (micro, dir, field[0]);
+		resolve (j->image, dir, field[1]);
+		if (strcmp (field[2], "-") != 0)
+		{
+			resolve (j->input, dir, field[2]);
+		}
+		if (strcmp (field[3], "-") != 0)
+		{
+			resolve (j->expected, dir, field[3]);
+		}
+		for (int i = 4; i < fields; i++)
+		{
+			switch ((field[i][1] == '=') ? field[i][0] : 0)
+			{
+				case 'n':	j->lim.max_cycles = strtoull (field[i] + 2, NULL, 0);		break;
+				case 'x':	j->lim.stop_pc = (int) strtol (field[i] + 2, NULL, 16);		break;
+				case 'w':	j->lim.idle_polls = strtoull (field[i] + 2, NULL, 0);		break;
+				default:
+					fprintf (stderr, "%s:%d: don't know %s\n", path, number, field[i]);
+					fclose (f);
+					return false;
+			}
+		}
+		if ((j->lim.max_cycles == 0) && (j->lim.stop_pc < 0) && (j->lim.idle_polls == 0))
+		{
+			fprintf (stderr, "%s:%d: needs n=, x= or w= to stop\n", path, number);
+			fclose (f);
+			return false;
+		}
+		j->table = load_table (micro);
+		if (j->table == NULL)
+		{
+			fclose (f);
+			return false;
+		}
+		size_t len = strlen (j->image);
+		if ((len > 5) && (strcmp (j->image + len - 5, ".snap") == 0))
+		{
+			j->start = load_start (j->image, j->table);
+			if (j->start == NULL)
+			{
+				fclose (f);
+				return false;
+			}
+			if (j->lim.max_cycles)
+			{
+				j->lim.max_cycles += j->start->snap.cycles;
+			}
+		}
+		njobs++;
+	}
+	fclose (f);
+	return true;
+}
+
+// -a: a copy of every job for each of the other tables
+static bool add_others (void)
+{
+	int n = njobs;
+
+	if (nothers == 0)
+	{
+		return true;
+	}
+	if (n * (nothers + 1) > MAX_JOBS)
+	{
+		fprintf (stderr, "Too many jobs\n");
+		return false;
+	}
+	for (int i = 0; i < n; i++)
+	{
+		if (jobs[i].start != NULL)
+		{
+			fprintf (stderr, "Line %d: a snapshot job can only run on its own microcode\n", jobs[i].line);
+			return false;
+		}
+	}
+	for (int k = 0; k < nothers; k++)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			job_t *j = &jobs[njobs++];
+			*j = jobs[i];
+			j->table = others[k];
+			j->base = i;
+		}
+	}
+	return true;
+}
+
+// what the terminal showed, as the host would print it
+static size_t terminal_text (const machine_t *m, uint8_t *out)
+{
+	size_t n = 0;
+
+	for (size_t i = 0; i < m->tty_len; i++)
+	{
+		if (m->tty[i] == '\r')
+		{
+			out[n++] = '\n';
+		}
+		else if ((m->tty[i] != '\n') || (i == 0) || (m->tty[i - 1] != '\r'))
+		{
+			out[n++] = m->tty[i];
+		}
+	}
+	return n;
+}
+
+static void run_job (job_t *j, machine_t *m)
+{
+	uint64_t cycles = 0;
+	uint64_t instructions = 0;
+
+	m->tty_len = 0;
+	m->kbd = NULL;
+	m->kbd_len = 0;
+	m->kbd_pos = 0;
+	m->echo = false;
+	if (j->start != NULL)
+	{
+		m->rom = j->table->rom;
+		snapshot_restore (m, &j->start->snap);
+		cycles = m->cycles;
+		instructions = m->instructions;
+	}
+	else
+	{
+		machine_reset (m, j->table->rom);
+		if (load_raw (j->image, m->mem, MEM_SIZE, 1) < 0)
+		{
+			j->note = "can't load image";
+			return;
+		}
+	}
+	if (j->input[0])
+	{
+		size_t len;
+		uint8_t *text = read_file (j->input, &len);
+		if (text == NULL)
+		{
+			j->note = "can't read input";
+			return;
+		}
+		machine_type (m, text, len);
+		free (text);
+	}
+
+	double t0 = now ();
+	j->why = machine_run_threaded (m, &j->table->thread, &j->lim);
+	j->seconds = now () - t0;
+	j->cycles = m->cycles - cycles;
+	j->instructions = m->instructions - instructions;
+	if (j->input[0])
+	{
+		free ((void *) m->kbd);
+	}
+	j->text = malloc (m->tty_len + 1);
+	j->text_len = terminal_text (m, j->text);
+
+	// running into the cycle limit is a failure unless it's the only way the job stops
+	if ((j->why == STOP_CYCLES) && ((j->lim.stop_pc >= 0) || j->lim.idle_polls))
+	{
+		j->note = "cycle limit";
+		return;
+	}
+	if (j->expected[0])
+	{
+		size_t len;
+		uint8_t *want = read_file (j->expected, &len);
+		if (want == NULL)
+		{
+			j->note = "can't read expected output";
+			return;
+		}
+		j->pass = (j->text_len == len) && (memcmp (j->text, want, len) == 0);
+		j->note = j->pass ? "" : "output differs";
+		free (want);
+		return;
+	}
+	j->pass = true;
+	j->note = "";
+}
+
+static int take (queue_t *q)
+{
+	int job = -1;
+
+	pthread_mutex_lock (&q->lock);
+	if (q->bottom > q->top)
+	{
+		job = q->job[--q->bottom];
+	}
+	pthread_mutex_unlock (&q->lock);
+	return job;
+}
+
+static int steal (queue_t *q)
+{
+	int job = -1;
+
+	pthread_mutex_lock (&q->lock);
+	if (q->bottom > q->top)
+	{
+		job = q->job[q->top++];
+	}
+	pthread_mutex_unlock (&q->lock);
+	return job;
+}
+
+static void *worker (void *arg)
+{
+	queue_t *q = arg;
+	machine_t *m = calloc (1, sizeof (machine_t));
+
+	for (;;)
+	{
+		int job = take (q);
+
+		// nothing left here: try everyone else, starting with the next one along
+		for (int i = 1; (job < 0) && (i < workers); i++)
+		{
+			job = steal (&queue[(q->id + i) % workers]);
+			if (job >= 0)
+			{
+				q->stolen++;
+			}
+		}
+		if (job < 0)
+		{
+			break;
+		}
+		run_job (&jobs[job], m);
+	}
+	free (m->tty);
+	free (m);
+	return NULL;
+}
+
+static void usage (void)
+{
+	fprintf (stderr, "usage: farm [-j threads] [-v] [-a microcode]... manifest\n");
+	exit (2);
+}
+
+static bool same_output (const job_t *a, const job_t *b)
+{
+	return (a->text != NULL) && (b->text != NULL) && (a->text_len == b->text_len)
+		&& (memcmp (a->text, b->text, a->text_len) == 0);
+}
+
+static double change (double now, double was)
+{
+	return (was > 0) ? (now / was - 1) * 100 : 0.0;
+}
+
+// -a: each job on its own table and then on each of the others, and the totals for
+// each table; returns how many runs gave other output than on the job's own table
+static int compare (int n)
+{
+	int differ = 0;
+
+	printf ("line  result  microcycles  instructions   CPI   seconds  output   microcode\n");
+	for (int i = 0; i < n; i++)
+	{
+		for (int k = 0; k <= nothers; k++)
+		{
+			const job_t *j = &jobs[k * n + i];
+			bool same = same_output (j, &jobs[i]);
+			differ += !same;
+			printf ("%4d  %-6s %12llu %13llu %5.2f %9.3f  %-7s  %s", j->line, j->pass ? "pass" : "FAIL",
+				(unsigned long long) j->cycles, (unsigned long long) j->instructions,
+				j->instructions ? (double) j->cycles / j->instructions : 0.0, j->seconds,
+				(k == 0) ? "-" : same ? "same" : "DIFFERS", j->table->path);
+			if (k == 0)
+			{
+				printf ("  %s", j->image);
+				if (j->input[0])
+				{
+					printf (" < %s", j->input);
+				}
+			}
+			if (j->note[0])
+			{
+				printf (" (%s)", j->note);
+			}
+			printf ("\n");
+		}
+	}
+
+	uint64_t base_cycles = 0;
+	double base_seconds = 0;
+	printf ("\nmicrocode                     microcycles    change   seconds    change  same output\n");
+	for (int k = 0; k <= nothers; k++)
+	{
+		uint64_t cycles = 0;
+		double seconds = 0;
+		int same = 0;
+		for (int i = 0; i < n; i++)
+		{
+			cycles += jobs[k * n + i].cycles;
+			seconds += jobs[k * n + i].seconds;
+			same += same_output (&jobs[k * n + i], &jobs[i]);
+		}
+		if (k == 0)
+		{
+			base_cycles = cycles;
+			base_seconds = seconds;
+			printf ("%-28s %12llu         - %9.3f         -  -\n", "each job's own", (unsigned long long) cycles, seconds);
+		}
+		else
+		{
+			printf ("%-28s %12llu %+8.1f%% %9.3f %+8.1f%%  %d of %d\n", others[k - 1]->path, (unsigned long long) cycles,
+				change (cycles, base_cycles), seconds, change (seconds, base_seconds), same, n);
+		}
+	}
+	printf ("\n");
+	return differ;
+}
+
+int main (int argc, char **argv)
+{
+	bool verbose = false;
+	const char *other[MAX_OTHERS];
+	int opt;
+
+	workers = (int) sysconf (_SC_NPROCESSORS_ONLN);
+	while ((opt = getopt (argc, argv, "j:va:")) != -1)
+	{
+		switch (opt)
+		{
+			case 'j':	workers = atoi (optarg);		break;
+			case 'v':	verbose = true;					break;
+			case 'a':
+				if (nothers == MAX_OTHERS)
+				{
+					usage ();
+				}
+				other[nothers++] = optarg;
+				break;
+			default:	usage ();
+		}
+	}
+	if (optind != argc - 1)
+	{
+		usage ();
+	}
+	if (!read_manifest (argv[optind]))
+	{
+		return 2;
+	}
+	int own = njobs;
+	for (int k = 0; k < nothers; k++)
+	{
+		others[k] = load_table (other[k]);
+		if (others[k] == NULL)
+		{
+			return 2;
+		}
+	}
+	if (!add_others ())
+	{
+		return 2;
+	}
+	workers = (workers < 1) ? 1 : (workers > MAX_WORKERS) ? MAX_WORKERS : workers;
+	workers = (workers > njobs) ? ((njobs > 0) ? njobs : 1) : workers;
+
+	// deal the jobs out in manifest order
+	for (int w = 0; w < workers; w++)
+	{
+		pthread_mutex_init (&queue[w].lock, NULL);
+		queue[w].id = w;
+	}
+	for (int i = njobs - 1; i >= 0; i--)
+	{
+		queue_t *q = &queue[i % workers];
+		q->job[q->bottom++] = i;
+	}
+
+	pthread_t thread[MAX_WORKERS];
+	double t0 = now ();
+	for (int w = 0; w < workers; w++)
+	{
+		pthread_create (&thread[w], NULL, worker, &queue[w]);
+	}
+	for (int w = 0; w < workers; w++)
+	{
+		pthread_join (thread[w], NULL);
+	}
+	double wall = now () - t0;
+
+	static const char *reason[] = { "cycles", "pc", "idle" };
+	uint64_t cycles = 0;
+	int passed = 0;
+	int stolen = 0;
+	int differ = nothers ? compare (own) : 0;
+	printf ("line  result  stop          microcycles  instructions   seconds  job\n");
+	for (int i = 0; i < njobs; i++)
+	{
+		job_t *j = &jobs[i];
+		cycles += j->cycles;
+		passed += j->pass;
+		if (verbose || !j->pass)
+		{
+			printf ("%4d  %-6s  %-6s %18llu %13llu %9.3f  %s %s", j->line, j->pass ? "pass" : "FAIL",
+				j->cycles ? reason[j->why] : "-", (unsigned long long) j->cycles, (unsigned long long) j->instructions,
+				j->seconds, j->table->path, j->image);
+			if (j->input[0])
+			{
+				printf (" < %s", j->input);
+			}
+			if (j->note[0])
+			{
+				printf (" (%s)", j->note);
+			}
+			printf ("\n");
+		}
+	}
+	for (int w = 0; w < workers; w++)
+	{
+		stolen += queue[w].stolen;
+	}
+	printf ("%d of %d jobs passed; %llu microcycles in %.3f s on %d threads (%d jobs stolen), %.1f M microcycles/s\n",
+		passed, njobs, (unsigned long long) cycles, wall, workers, stolen, wall > 0 ? cycles / wall * 1e-6 : 0.0);
+	return ((passed == njobs) && (differ == 0)) ? 0 : 1;
+}
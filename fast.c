@@ -0,0 +1,668 @@
+// fast forward: an instruction set emulator for getting through the uninteresting part
+// of a long run, one step per 8080 instruction, that hands over at an instruction
+// boundary to whichever engine is to take it from there in microcycle detail
+//
+// an instruction is charged the length of its sequence in the decoded ROM, and it
+// leaves everything as the microcode would, down to the scratch registers and the
+// carry between steps, so the machine it hands over is the one stepping every
+// microcycle would have got to. Unlike the other engines this one knows the 8080, or
+// rather what seq.c makes of it, so fast_init tries every opcode against the microcode
+// and any (opcode, condition) half that comes out different is stepped instead
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "fake8080.h"
+
+#define REG(r)			m->reg[map[r]]
+
+// the register pair in ir bits 5-4, by its high register
+static const uint8_t pair_high[4] = { REG_B, REG_D, REG_H, REG_SPH };
+
+static inline uint16_t get_pair (const machine_t *m, const uint8_t *map, int high)
+{
+	return (REG (high) << 8) | REG (high + 1);
+}
+
+static inline void set_pair (machine_t *m, const uint8_t *map, int high, uint16_t v)
+{
+	REG (high) = v >> 8;
+	REG (high + 1) = (uint8_t) v;
+}
+
+// the last step of most sequences moves the pc on, and the carry out of the high half
+// is what it leaves behind
+static inline void next (machine_t *m, uint16_t pc)
+{
+	m->reg[REG_PCH] = pc >> 8;
+	m->reg[REG_PCL] = (uint8_t) pc;
+	m->icarry = (pc == 0);
+}
+
+static inline void push (machine_t *m, uint8_t high, uint8_t low)
+{
+	uint16_t sp = (m->reg[REG_SPH] << 8) | m->reg[REG_SPL];
+
+	machine_write (m, --sp, high);
+	machine_write (m, --sp, low);
+	m->reg[REG_SPH] = sp >> 8;
+	m->reg[REG_SPL] = (uint8_t) sp;
+}
+
+// the alu with the carry, zero and sign flags written, as the arithmetic group does
+static inline uint8_t arith (machine_t *m, int op, uint8_t a, uint8_t b)
+{
+	uint8_t cout;
+	uint8_t r = alu (op, a, b, m->carry, m->icarry, &cout);
+
+	m->carry = cout;
+	m->zero = (r == 0);
+	m->sign = r >> 7;
+	return r;
+}
+
+// one instruction, after the fetch has loaded ir and the condition latch
+static void execute (machine_t *m, uint8_t op)
+{
+	const uint8_t *map = xmap[m->flip];
+	uint16_t pc = machine_pc (m);
+	int high = pair_high[(op >> 4) & 3];
+	int dest = (op >> 3) & 7;
+	int src = op & 7;
+	uint16_t v;
+	uint8_t r;
+	uint8_t cout;
+
+	// mov, with mov m,m (hlt) left as a nop
+	if ((op & 0xc0) == 0x40)
+	{
+		if (op != 0x76)
+		{
+			r = (src == REG_M) ? machine_read (m, machine_address (m, ADDR_HL)) : REG (src);
+			if (dest == REG_M)
+			{
+				machine_write (m, machine_address (m, ADDR_HL), r);
+			}
+			else
+			{
+				REG (dest) = r;
+			}
+		}
+		next (m, pc + 1);
+		return;
+	}
+
+	// the arithmetic group, with compare leaving its result in mah
+	if ((op & 0xc0) == 0x80)
+	{
+		r = (src == REG_M) ? machine_read (m, machine_address (m, ADDR_HL)) : REG (src);
+		m->reg[(dest == ALU_CMP) ? REG_MAH : REG_A] = arith (m, dest, m->reg[REG_A], r);
+		next (m, pc + 1);
+		return;
+	}
+	if ((op & 0xc7) == 0xc6)
+	{
+		r = machine_read (m, pc + 1);
+		m->reg[(dest == ALU_CMP) ? REG_MAH : REG_A] = arith (m, dest, m->reg[REG_A], r);
+		next (m, pc + 2);
+		return;
+	}
+
+	switch (op & 0xc7)
+	{
+		// inr and dcr set zero and sign but leave the carry; m goes by way of mah
+		case 0x04:
+		case 0x05:
+		{
+			int f = (op & 1) ? ALU_DECL : ALU_INCL;
+			if (dest == REG_M)
+			{
+				r = alu (f, 0, machine_read (m, machine_address (m, ADDR_HL)), m->carry, m->icarry, &cout);
+				m->reg[REG_MAH] = r;
+				machine_write (m, machine_address (m, ADDR_HL), r);
+			}
+			else
+			{
+				r = alu (f, 0, REG (dest), m->carry, m->icarry, &cout);
+				REG (dest) = r;
+			}
+			m->zero = (r == 0);
+			m->sign = r >> 7;
+			next (m, pc + 1);
+			return;
+		}
+
+		// mvi
+		case 0x06:
+			r = machine_read (m, pc + 1);
+			if (dest == REG_M)
+			{
+				m->reg[REG_MAH] = r;
+				machine_write (m, machine_address (m, ADDR_HL), r);
+			}
+			else
+			{
+				REG (dest) = r;
+			}
+			next (m, pc + 2);
+			return;
+
+		// rst: push the address of the next instruction and go to the vector
+		case 0xc7:
+			v = pc + 1;
+			push (m, v >> 8, (uint8_t) v);
+			m->reg[REG_PCH] = 0;
+			m->reg[REG_PCL] = op & 0x38;
+			m->icarry = 0;
+			return;
+
+		// conditional return, jump and call: the condition latch picked the half
+		case 0xc0:
+			if (m->cond)
+			{
+				goto ret;
+			}
+			next (m, pc + 1);
+			return;
+		case 0xc2:
+			if (m->cond)
+			{
+				goto jump;
+			}
+			next (m, pc + 3);
+			return;
+		case 0xc4:
+			if (m->cond)
+			{
+				goto call;
+			}
+			next (m, pc + 3);
+			return;
+	}
+
+	switch (op & 0xcf)
+	{
+		// lxi
+		case 0x01:
+			REG (high + 1) = machine_read (m, pc + 1);
+			REG (high) = machine_read (m, pc + 2);
+			next (m, pc + 3);
+			return;
+
+		// inx and dcx
+		case 0x03:
+			set_pair (m, map, high, get_pair (m, map, high) + 1);
+			next (m, pc + 1);
+			return;
+		case 0x0b:
+			set_pair (m, map, high, get_pair (m, map, high) - 1);
+			next (m, pc + 1);
+			return;
+
+		// dad: l and h through the alu in turn, with the accumulator kept in mah
+		case 0x09:
+			m->reg[REG_MAH] = m->reg[REG_A];
+			r = alu (ALU_ADD, REG (REG_L), REG (high + 1), m->carry, m->icarry, &cout);
+			m->carry = cout;
+			REG (REG_L) = r;
+			r = alu (ALU_ADC, REG (REG_H), REG (high), m->carry, m->icarry, &cout);
+			m->carry = cout;
+			REG (REG_H) = r;
+			next (m, pc + 1);
+			return;
+
+		// pop, with psw taking the flags from the low byte
+		case 0xc1:
+		{
+			uint16_t sp = (m->reg[REG_SPH] << 8) | m->reg[REG_SPL];
+			uint8_t low = machine_read (m, sp++);
+			if (high == REG_SPH)
+			{
+				m->carry = (low & FLAG_C) != 0;
+				m->zero = (low & FLAG_Z) != 0;
+				m->sign = (low & FLAG_S) != 0;
+				high = REG_A;
+			}
+			else
+			{
+				REG (high + 1) = low;
+			}
+			REG (high) = machine_read (m, sp++);
+			m->reg[REG_SPH] = sp >> 8;
+			m->reg[REG_SPL] = (uint8_t) sp;
+			next (m, pc + 1);
+			return;
+		}
+
+		case 0xc5:
+			if (high == REG_SPH)
+			{
+				push (m, m->reg[REG_A], machine_flags (m));
+			}
+			else
+			{
+				push (m, REG (high), REG (high + 1));
+			}
+			next (m, pc + 1);
+			return;
+	}
+
+	switch (op)
+	{
+		// stax and ldax go by way of ma
+		case 0x02:
+		case 0x12:
+			m->reg[REG_MAL] = REG (high + 1);
+			m->reg[REG_MAH] = REG (high);
+			machine_write (m, machine_address (m, ADDR_MA), m->reg[REG_A]);
+			next (m, pc + 1);
+			return;
+		case 0x0a:
+		case 0x1a:
+			m->reg[REG_MAL] = REG (high + 1);
+			m->reg[REG_MAH] = REG (high);
+			m->reg[REG_A] = machine_read (m, machine_address (m, ADDR_MA));
+			next (m, pc + 1);
+			return;
+
+		// the rotates; rlc is a + a with the carry out added back in
+		case 0x07:
+			r = alu (ALU_ADD, m->reg[REG_A], m->reg[REG_A], m->carry, m->icarry, &cout);
+			m->carry = cout;
+			break;
+		case 0x0f:
+		case 0x17:
+		case 0x1f:
+			break;
+
+		// shld, lhld, sta and lda leave the (last) address in ma
+		case 0x22:
+		case 0x2a:
+			m->reg[REG_MAL] = machine_read (m, pc + 1);
+			m->reg[REG_MAH] = machine_read (m, pc + 2);
+			v = machine_address (m, ADDR_MA);
+			if (op == 0x22)
+			{
+				machine_write (m, v, REG (REG_L));
+				v++;
+				machine_write (m, v, REG (REG_H));
+			}
+			else
+			{
+				REG (REG_L) = machine_read (m, v);
+				v++;
+				REG (REG_H) = machine_read (m, v);
+			}
+			m->reg[REG_MAH] = v >> 8;
+			m->reg[REG_MAL] = (uint8_t) v;
+			next (m, pc + 3);
+			return;
+		case 0x32:
+		case 0x3a:
+			m->reg[REG_MAL] = machine_read (m, pc + 1);
+			m->reg[REG_MAH] = machine_read (m, pc + 2);
+			if (op == 0x32)
+			{
+				machine_write (m, machine_address (m, ADDR_MA), m->reg[REG_A]);
+			}
+			else
+			{
+				m->reg[REG_A] = machine_read (m, machine_address (m, ADDR_MA));
+			}
+			next (m, pc + 3);
+			return;
+
+		// cma xors with ff made in mah; stc and cmc put a + a in mah on the way
+		case 0x2f:
+			m->reg[REG_MAH] = 0xff;
+			m->reg[REG_A] ^= 0xff;
+			next (m, pc + 1);
+			return;
+		case 0x37:
+		case 0x3f:
+			m->reg[REG_MAH] = m->reg[REG_A] << 1;
+			m->carry = (op == 0x37) ? 1 : !m->carry;
+			next (m, pc + 1);
+			return;
+
+		case 0xc3:
+		case 0xcb:
+		jump:
+			m->reg[REG_MAH] = machine_read (m, pc + 1);
+			m->reg[REG_PCH] = machine_read (m, pc + 2);
+			m->reg[REG_PCL] = m->reg[REG_MAH];
+			m->icarry = 0;
+			return;
+
+		case 0xcd:
+		case 0xdd:
+		case 0xed:
+		case 0xfd:
+		call:
+			m->reg[REG_MAL] = machine_read (m, pc + 1);
+			m->reg[REG_MAH] = machine_read (m, pc + 2);
+			v = pc + 3;
+			push (m, v >> 8, (uint8_t) v);
+			m->reg[REG_PCH] = m->reg[REG_MAH];
+			m->reg[REG_PCL] = m->reg[REG_MAL];
+			m->icarry = 0;
+			return;
+
+		case 0xc9:
+		case 0xd9:
+		ret:
+		{
+			uint16_t sp = (m->reg[REG_SPH] << 8) | m->reg[REG_SPL];
+			m->reg[REG_PCL] = machine_read (m, sp++);
+			m->reg[REG_PCH] = machine_read (m, sp++);
+			m->reg[REG_SPH] = sp >> 8;
+			m->reg[REG_SPL] = (uint8_t) sp;
+			m->icarry = (sp == 0);
+			return;
+		}
+
+		// xthl swaps through ma
+		case 0xe3:
+		{
+			uint16_t sp = (m->reg[REG_SPH] << 8) | m->reg[REG_SPL];
+			m->reg[REG_MAH] = REG (REG_H);
+			m->reg[REG_MAL] = REG (REG_L);
+			REG (REG_L) = machine_read (m, sp);
+			REG (REG_H) = machine_read (m, sp + 1);
+			machine_write (m, sp + 1, m->reg[REG_MAH]);
+			machine_write (m, sp, m->reg[REG_MAL]);
+			next (m, pc + 1);
+			return;
+		}
+
+		case 0xe9:
+			m->reg[REG_PCH] = REG (REG_H);
+			m->reg[REG_PCL] = REG (REG_L);
+			m->icarry = 0;
+			return;
+		case 0xf9:
+			m->reg[REG_SPH] = REG (REG_H);
+			m->reg[REG_SPL] = REG (REG_L);
+			next (m, pc + 1);
+			return;
+
+		// xchg just flips the alias
+		case 0xeb:
+			m->reg[REG_MAH] = m->reg[REG_A];
+			m->flip ^= 1;
+			next (m, pc + 1);
+			return;
+
+		case 0xf3:
+			m->inte = 0;
+			next (m, pc + 1);
+			return;
+		case 0xfb:
+			m->inte = 1;
+			next (m, pc + 1);
+			return;
+
+		// nop, daa, in, out and the undocumented nops
+		default:
+			next (m, pc + 1);
+			return;
+	}
+
+	// rlc finishes by adding in the carry; rrc, ral and rar are one alu operation
+	if (op == 0x07)
+	{
+		m->reg[REG_A] = r + m->carry;
+	}
+	else
+	{
+		static const uint8_t rotate[4] = { 0, ALU_RRC, ALU_ADC, ALU_RAR };
+		r = alu (rotate[op >> 3], m->reg[REG_A], m->reg[REG_A], m->carry, m->icarry, &cout);
+		m->carry = cout;
+		m->reg[REG_A] = r;
+	}
+	next (m, pc + 1);
+}
+
+// a state worth trying an instruction from: register pairs that are about to wrap, or
+// point at the terminal, turn up more often than they would by chance
+static uint32_t seed = 2463534242u;
+
+static uint32_t xorshift (void)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+static void random_pair (machine_t *m, int high)
+{
+	static const uint16_t edge[] =
+	{
+		0x0000, 0x0001, 0x7fff, 0xfffd, 0xfffe, 0xffff, SER_IN - 1, SER_IN, SER_OUT - 1, SER_OUT
+	};
+	uint32_t r = xorshift ();
+	uint16_t v = (r & 1) ? (uint16_t) (r >> 8) : edge[(r >> 8) % (sizeof (edge) / sizeof (edge[0]))];
+
+	m->reg[high] = v >> 8;
+	m->reg[high + 1] = (uint8_t) v;
+}
+
+#define TRIALS			64				// random states per opcode
+
+static bool same (const machine_t *a, const machine_t *b)
+{
+	if ((memcmp (a->reg, b->reg, sizeof (a->reg)) != 0) || (a->step != b->step) || (a->cond != b->cond)
+		|| (a->carry != b->carry) || (a->zero != b->zero) || (a->sign != b->sign) || (a->icarry != b->icarry)
+		|| (a->flip != b->flip) || (a->inte != b->inte) || (a->cycles != b->cycles)
+		|| (a->instructions != b->instructions) || (a->kbd_pos != b->kbd_pos) || (a->idle != b->idle)
+		|| (a->tty_len != b->tty_len) || (a->tty_len && (memcmp (a->tty, b->tty, a->tty_len) != 0)))
+	{
+		return false;
+	}
+	for (int page = 0; page < PAGES; page++)
+	{
+		if ((a->dirty[page] || b->dirty[page])
+			&& (memcmp (&a->mem[page * PAGE_SIZE], &b->mem[page * PAGE_SIZE], PAGE_SIZE) != 0))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// run every opcode from random states both ways; a half is good if every trial that
+// landed in it agreed, and halves no trial reached (the parity conditions) are stepped
+bool fast_init (fast_t *f, const microcode_t *mc)
+{
+	static const uint8_t keys[] = "k\r";
+	machine_t *a = malloc (sizeof (machine_t));
+	machine_t *b = malloc (sizeof (machine_t));
+	uint8_t *image = malloc (MEM_SIZE);
+	bool bad[512] = { false };
+	bool tried[512] = { false };
+
+	memset (f, 0, sizeof (*f));
+	f->mc = mc;
+	for (int i = 0; i < MEM_SIZE; i++)
+	{
+		image[i] = (uint8_t) xorshift ();
+	}
+	memset (a, 0, sizeof (*a));
+	memset (b, 0, sizeof (*b));
+	memcpy (a->mem, image, MEM_SIZE);
+	memcpy (b->mem, image, MEM_SIZE);
+
+	for (int op = 0; op < 256; op++)
+	{
+		for (int trial = 0; trial < TRIALS; trial++)
+		{
+			for (int r = REG_B; r < REG_IR; r += 2)
+			{
+				random_pair (a, r);
+			}
+			uint32_t bits = xorshift ();
+			a->reg[REG_A] = (uint8_t) bits;
+			a->reg[REG_IR] = (uint8_t) (bits >> 8);
+			a->carry = (bits >> 16) & 1;
+			a->zero = (bits >> 17) & 1;
+			a->sign = (bits >> 18) & 1;
+			a->icarry = (bits >> 19) & 1;
+			a->flip = (bits >> 20) & 1;
+			a->inte = (bits >> 21) & 1;
+			a->cond = machine_condition (a, a->reg[REG_IR]);
+			a->step = 0;
+			a->cycles = 0;
+			a->instructions = 0;
+			a->idle = 0;
+			a->kbd = keys;
+			a->kbd_len = 2;
+			a->kbd_pos = 0;
+			a->tty_len = 0;
+			uint16_t pc = machine_pc (a);
+			if (pc == SER_IN)
+			{
+				continue;
+			}
+			a->mem[pc] = (uint8_t) op;
+			a->dirty[pc / PAGE_SIZE] = 1;
+
+			// the copy gets everything but the memory, which is the same already, and
+			// keeps its own terminal buffer
+			uint8_t *tty = b->tty;
+			size_t cap = b->tty_cap;
+			memcpy (b, a, offsetof (machine_t, mem));
+			b->mem[pc] = (uint8_t) op;
+			b->tty = tty;
+			b->tty_cap = cap;
+
+			// the microcode, giving up on a sequence with no end
+			int half = (op << 1) | machine_condition (a, (uint8_t) op);
+			for (int n = 0; (n == 0) || (a->step != 0); n++)
+			{
+				if (n == 32)
+				{
+					bad[half] = true;
+					break;
+				}
+				machine_step_decoded (a, mc);
+			}
+
+			b->reg[REG_IR] = (uint8_t) op;
+			b->cond = machine_condition (b, (uint8_t) op);
+			b->icarry = 0;
+			execute (b, (uint8_t) op);
+			b->cycles += mc->length[half];
+			b->instructions++;
+
+			tried[half] = true;
+			if (!same (a, b))
+			{
+				bad[half] = true;
+			}
+
+			// put back the pages either of them wrote
+			for (int page = 0; page < PAGES; page++)
+			{
+				if (a->dirty[page] || b->dirty[page])
+				{
+					memcpy (&a->mem[page * PAGE_SIZE], &image[page * PAGE_SIZE], PAGE_SIZE);
+					memcpy (&b->mem[page * PAGE_SIZE], &image[page * PAGE_SIZE], PAGE_SIZE);
+				}
+				a->dirty[page] = 0;
+			}
+		}
+	}
+
+	for (int half = 0; half < 512; half++)
+	{
+		f->ok[half] = tried[half] && !bad[half] && (mc->length[half] != 0);
+		f->halves += f->ok[half];
+	}
+	free (a->tty);
+	free (b->tty);
+	free (a);
+	free (b);
+	free (image);
+	return f->halves == 512;
+}
+
+// run instructions until a limit or the trigger; STOP_TRIGGER leaves the machine at the
+// boundary of the instruction the trigger fell on, so a run for a pc or a cycle stops
+// before that instruction and a run for terminal output after the one that wrote it
+int machine_run_fast (machine_t *m, fast_t *f, const run_limits_t *lim, const trigger_t *trig)
+{
+	const microcode_t *mc = f->mc;
+
+	// finish off an instruction we were stopped in the middle of
+	while (m->step != 0)
+	{
+		if (lim->max_cycles && (m->cycles >= lim->max_cycles))
+		{
+			return STOP_CYCLES;
+		}
+		machine_step_decoded (m, mc);
+	}
+
+	for (;;)
+	{
+		uint16_t pc = machine_pc (m);
+		if (pc == trig->pc)
+		{
+			return STOP_TRIGGER;
+		}
+
+		// an instruction fetched from the keyboard is left to the microcode
+		uint8_t op = (pc == SER_IN) ? 0 : m->mem[pc];
+		int half = (op << 1) | machine_condition (m, op);
+		int n = mc->length[half];
+		if ((n != 0) && trig->cycle && (m->cycles + n > trig->cycle))
+		{
+			return STOP_TRIGGER;
+		}
+		if (lim->max_cycles && (m->cycles >= lim->max_cycles))
+		{
+			return STOP_CYCLES;
+		}
+		if (lim->max_cycles && (m->cycles + n > lim->max_cycles))
+		{
+			// the limit falls inside this instruction
+			return machine_run_decoded (m, mc, lim);
+		}
+
+		size_t tty_len = m->tty_len;
+		if ((pc != SER_IN) && f->ok[half])
+		{
+			m->reg[REG_IR] = op;
+			m->cond = half & 1;
+			m->icarry = 0;
+			execute (m, op);
+			m->cycles += n;
+			m->instructions++;
+			f->fast++;
+		}
+		else
+		{
+			do
+			{
+				if (lim->max_cycles && (m->cycles >= lim->max_cycles))
+				{
+					return STOP_CYCLES;
+				}
+				machine_step_decoded (m, mc);
+			}
+			while (m->step != 0);
+			f->stepped++;
+		}
+
+		int why = machine_limit (m, lim);
+		if (why >= 0)
+		{
+			return why;
+		}
+		if (trig->output && (m->tty_len != tty_len))
+		{
+			return STOP_TRIGGER;
+		}
+	}
+}
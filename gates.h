@@ -0,0 +1,142 @@
+// the interface to a gate level simulator that circ -c generates from a netlist
+//
+// the generated code keeps a byte for each net, 0 or 1, and a byte for each bit of state
+// in the flip-flops and registers. gates_settle works out every net from the state, the
+// inputs and the memories, in one pass over the elements in the order nl_levelize puts
+// them, or another if a net a loop was cut at comes out different; gates_edge then clocks whatever saw its clock input change from prev to net,
+// taking what it stores from prev, as it was before the edge. A clock is
+//
+//		gates_half (g, 1);
+//		gates_half (g, 0);
+//
+// which raises and lowers the CLOCK and, each time, settles and clocks until nothing
+// more changes, so clocks derived through gates and flip-flops are followed as Logisim
+// follows them, only with no delays: everything clocked on one edge sees the nets as
+// they were before it
+//
+// the ROMs start with the contents in the .circ file and the RAMs with zeroes. The
+// keyboard is typed from kbd, and the terminal's output collects in tty
+
+#ifndef GATES_H
+#define GATES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GATES_MEMORIES	4
+
+// names of the inputs, the named nets and the clocked elements with labels
+typedef struct
+{
+	const char	*name;
+	uint32_t	width;
+	uint32_t	at;						// input number, net, or first byte of state
+} gates_name_t;
+
+typedef struct
+{
+	uint32_t	nets;
+	uint32_t	states;
+	uint32_t	inputs;
+	uint32_t	roms;
+	uint32_t	rams;
+	uint32_t	rom_words[GATES_MEMORIES];
+	uint32_t	ram_bytes[GATES_MEMORIES];
+	uint32_t	elements;				// in the netlist, and the most levels of logic
+	uint32_t	levels;					// between clocked elements
+	const char	*top;
+} gates_info_t;
+
+typedef struct
+{
+	uint8_t		*net;
+	uint8_t		*prev;
+	uint8_t		*state;
+	uint32_t	*input;
+	uint8_t		clock;
+	uint32_t	*rom[GATES_MEMORIES];
+	uint8_t		*ram[GATES_MEMORIES];
+
+	const uint8_t *kbd;
+	size_t		kbd_len;
+	size_t		kbd_pos;
+	uint64_t	idle;					// keyboard reads since the last character in or out
+	uint8_t		*tty;
+	size_t		tty_len;
+	size_t		tty_cap;
+} gates_t;
+
+// generated
+extern const gates_info_t gates_info;
+extern const gates_name_t gates_inputs[];
+extern const gates_name_t gates_nets[];
+extern const gates_name_t gates_states[];
+extern const uint32_t *const gates_rom_contents[];
+void gates_settle (gates_t *g);
+int gates_edge (gates_t *g);
+
+static inline void gates_tty (gates_t *g, uint8_t c)
+{
+	if (g->tty_len == g->tty_cap)
+	{
+		g->tty_cap = g->tty_cap ? g->tty_cap * 2 : 4096;
+		g->tty = realloc (g->tty, g->tty_cap);
+	}
+	g->tty[g->tty_len++] = c;
+	g->idle = 0;
+}
+
+static inline void gates_half (gates_t *g, int level)
+{
+	g->clock = (uint8_t) level;
+	do
+	{
+		memcpy (g->prev, g->net, gates_info.nets);
+		gates_settle (g);
+	}
+	while (gates_edge (g));
+}
+
+// everything at zero, the ROMs loaded from the file and the inputs low
+static inline bool gates_init (gates_t *g)
+{
+	memset (g, 0, sizeof (*g));
+	g->net = calloc (gates_info.nets, 1);
+	g->prev = calloc (gates_info.nets, 1);
+	g->state = calloc (gates_info.states + 1, 1);
+	g->input = calloc (gates_info.inputs + 1, sizeof (uint32_t));
+	bool ok = (g->net != NULL) && (g->prev != NULL) && (g->state != NULL) && (g->input != NULL);
+	for (uint32_t i = 0; i < gates_info.roms; i++)
+	{
+		g->rom[i] = malloc (gates_info.rom_words[i] * sizeof (uint32_t));
+		ok = ok && (g->rom[i] != NULL);
+		if (ok)
+		{
+			memcpy (g->rom[i], gates_rom_contents[i], gates_info.rom_words[i] * sizeof (uint32_t));
+		}
+	}
+	for (uint32_t i = 0; i < gates_info.rams; i++)
+	{
+		g->ram[i] = calloc (gates_info.ram_bytes[i], 1);
+		ok = ok && (g->ram[i] != NULL);
+	}
+	return ok;
+}
+
+// a name in one of the tables, or NULL
+static inline const gates_name_t *gates_find (const gates_name_t *table, const char *name)
+{
+	for (; table->name != NULL; table++)
+	{
+		if (strcmp (table->name, name) == 0)
+		{
+			return table;
+		}
+	}
+	return NULL;
+}
+
+#endif
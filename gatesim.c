@@ -0,0 +1,305 @@
+// run an 8080 memory image on the gates of the Fake8080 design
+//
+// usage: gatesim [-m microcode.raw] [-i keyboard.txt] [-n cycles] [-x stop_pc] [-w idle_polls]
+//			[-h halt] [-v] [-q] image.raw
+//
+// gates.c is the Fake8080 circuit of the Logisim design, written out as C by circ -c:
+// every gate, mux, register and flip-flop, evaluated in level order once per half clock
+// (see gates.h). The sequencer ROM is loaded with the microcode rather than the contents
+// saved in the .circ file, the RAM with the image and run is held high, and the board's
+// clock is then run until a limit is reached, counting a microcycle for each rising edge
+// of the processor's clock and an instruction for each one with last high. The clock
+// stops while the address bus is at the halt switches; -h sets them, and otherwise
+// they are kept away from the bus, moved whenever it comes to them between cycles.
+// -v steps machine.c alongside and compares the registers and flags after every
+// instruction, printing what differs; machine.c then carries on from the gates'
+// values. It is not all bugs: the design's flags are what the two 74181s make of the
+// operation, and they leave the carry set after some of the logical ones where
+// machine.c, like an 8080, clears it
+//
+//		cc -O2 -o circ circ.c netlist.c
+//		./circ -c ALU_181_base.circ Fake8080 > gates.c
+//		cc -O2 -o gatesim gatesim.c gates.c machine.c rom.c
+//		./gatesim -x 0 cpudiag.raw
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "fake8080.h"
+#include "gates.h"
+
+static uint32_t rom[ROM_WORDS];
+
+// the registers of the design in the order of the register codes, and the flags
+static const char *const reg_name[16] =
+{
+	"Processor/Registers/B", "Processor/Registers/C", "Processor/Registers/D", "Processor/Registers/E",
+	"Processor/Registers/H", "Processor/Registers/L", NULL, "Processor/Registers/Acc",
+	"Processor/Registers/PCH", "Processor/Registers/PCL", "Processor/Registers/SPH", "Processor/Registers/SPL",
+	"Processor/Registers/MARH", "Processor/Registers/MARL", NULL, "Processor/Registers/IR",
+};
+static const char *const flag_name[3] =
+{
+	"Processor/Registers/Flags/Carry", "Processor/Registers/Flags/Zero", "Processor/Registers/Flags/Sign",
+};
+
+static int reg_at[16];
+static int flag_at[3];
+
+static double now (void)
+{
+	struct timespec ts;
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint8_t *read_file (const char *path, size_t *len)
+{
+	FILE *f = fopen (path, "rb");
+	if (f == NULL)
+	{
+		fprintf (stderr, "Can't open %s\n", path);
+		return NULL;
+	}
+	size_t cap = 4096;
+	uint8_t *buf = malloc (cap);
+	*len = 0;
+	size_t got;
+	while ((got = fread (buf + *len, 1, cap - *len, f)) > 0)
+	{
+		*len += got;
+		if (*len == cap)
+		{
+			cap *= 2;
+			buf = realloc (buf, cap);
+		}
+	}
+	fclose (f);
+	return buf;
+}
+
+static uint32_t find (const gates_name_t *table, const char *name)
+{
+	const gates_name_t *n = gates_find (table, name);
+	if (n == NULL)
+	{
+		fprintf (stderr, "%s isn't in the %s circuit gates.c was generated from\n", name, gates_info.top);
+		exit (1);
+	}
+	return n->at;
+}
+
+static uint8_t state_byte (const gates_t *g, int at)
+{
+	uint8_t v = 0;
+	for (int b = 0; b < 8; b++)
+	{
+		v |= g->state[at + b] << b;
+	}
+	return v;
+}
+
+static uint16_t gates_pc (const gates_t *g)
+{
+	return (state_byte (g, reg_at[REG_PCH]) << 8) | state_byte (g, reg_at[REG_PCL]);
+}
+
+// prints the registers and flags the gates and machine.c disagree on after the
+// instruction at pc, and gives machine.c the gates' values so it can go on alongside.
+// Returns how many there were
+static int compare (const gates_t *g, machine_t *m, uint16_t pc, uint64_t cycles)
+{
+	uint8_t *flag[3] = { &m->carry, &m->zero, &m->sign };
+	int differences = 0;
+
+	for (int r = 0; r < 16 + 3; r++)
+	{
+		const char *name = (r < 16) ? reg_name[r] : flag_name[r - 16];
+		uint8_t *want = (r < 16) ? &m->reg[r] : flag[r - 16];
+		uint8_t got = (r < 16) ? state_byte (g, reg_at[r]) : g->state[flag_at[r - 16]];
+		if ((name != NULL) && (got != *want))
+		{
+			fflush (stdout);
+			fprintf (stderr, "\n%s is %02x and machine.c has %02x after the %02x at %04x, ending at cycle %llu\n",
+				name, got, *want, g->ram[0][pc], pc, (unsigned long long) cycles);
+			*want = got;
+			differences++;
+		}
+	}
+	return differences;
+}
+
+static void usage (void)
+{
+	fprintf (stderr, "usage: gatesim [-m microcode.raw] [-i keyboard.txt] [-n cycles] [-x stop_pc] [-w idle_polls]\n"
+					 "               [-h halt] [-v] [-q] image.raw\n");
+	exit (2);
+}
+
+int main (int argc, char **argv)
+{
+	const char *micro = "seq.raw";
+	const char *input = NULL;
+	run_limits_t lim = { 0, -1, 0 };
+	int halt = -1;
+	bool verify = false;
+	bool quiet = false;
+	int opt;
+
+	while ((opt = getopt (argc, argv, "m:i:n:x:w:h:vq")) != -1)
+	{
+		switch (opt)
+		{
+			case 'm':	micro = optarg;								break;
+			case 'i':	input = optarg;								break;
+			case 'n':	lim.max_cycles = strtoull (optarg, NULL, 0);	break;
+			case 'x':	lim.stop_pc = (int) strtol (optarg, NULL, 16);	break;
+			case 'w':	lim.idle_polls = strtoull (optarg, NULL, 0);	break;
+			case 'h':	halt = (int) strtol (optarg, NULL, 16);		break;
+			case 'v':	verify = true;								break;
+			case 'q':	quiet = true;								break;
+			default:	usage ();
+		}
+	}
+	if (optind != argc - 1)
+	{
+		usage ();
+	}
+	if ((gates_info.roms != 1) || (gates_info.rom_words[0] != ROM_WORDS) ||
+		(gates_info.rams != 1) || (gates_info.ram_bytes[0] != MEM_SIZE))
+	{
+		fprintf (stderr, "gates.c has the wrong memories for a Fake8080\n");
+		return 1;
+	}
+
+	// m types for the gates and prints what they write, and is run alongside with -v
+	static machine_t m;
+	machine_reset (&m, rom);
+	if ((load_raw (micro, rom, ROM_WORDS, 4) < 0) || (load_raw (argv[optind], m.mem, MEM_SIZE, 1) < 0))
+	{
+		return 1;
+	}
+	if (input != NULL)
+	{
+		size_t len;
+		uint8_t *text = read_file (input, &len);
+		if (text == NULL)
+		{
+			return 1;
+		}
+		machine_input (&m, text, len);
+		free (text);
+	}
+	static machine_t term;
+	term.echo = !quiet;
+
+	gates_t g;
+	if (!gates_init (&g))
+	{
+		fprintf (stderr, "Can't allocate the gates\n");
+		return 1;
+	}
+	memcpy (g.rom[0], rom, sizeof (rom));
+	memcpy (g.ram[0], m.mem, MEM_SIZE);
+	g.kbd = m.kbd;
+	g.kbd_len = m.kbd_len;
+	uint32_t *switches = &g.input[find (gates_inputs, "Processor/halt")];
+	g.input[find (gates_inputs, "run")] = 1;
+	*switches = (halt >= 0) ? (uint32_t) halt : 0x8000;
+	uint32_t clk = find (gates_nets, "Processor/Clk");
+	uint32_t last = find (gates_nets, "Processor/last");
+	uint32_t address[16];
+	for (int b = 0; b < 16; b++)
+	{
+		char name[32];
+		snprintf (name, sizeof (name), "Address_Bus[%d]", b);
+		address[b] = find (gates_nets, name);
+	}
+	for (int r = 0; r < 16; r++)
+	{
+		reg_at[r] = (reg_name[r] != NULL) ? (int) find (gates_states, reg_name[r]) : -1;
+	}
+	for (int f = 0; f < 3; f++)
+	{
+		flag_at[f] = (int) find (gates_states, flag_name[f]);
+	}
+
+	static const char *reason[] = { "cycle limit", "stop address", "idle", "halt address" };
+	uint64_t cycles = 0;
+	uint64_t instructions = 0;
+	uint64_t differences = 0;
+	uint16_t pc = 0;
+	size_t printed = 0;
+	int why = -1;
+	double t0 = now ();
+	gates_half (&g, 0);
+	while (why < 0)
+	{
+		if (halt < 0)
+		{
+			uint32_t at = 0;
+			for (int b = 0; b < 16; b++)
+			{
+				at |= (uint32_t) g.net[address[b]] << b;
+			}
+			if (at == *switches)
+			{
+				*switches = at ^ 0x8000;
+				gates_half (&g, 0);
+			}
+		}
+		bool ending = g.net[last];
+		gates_half (&g, 1);
+		if (!g.net[clk])
+		{
+			why = 3;
+			break;
+		}
+		gates_half (&g, 0);
+		cycles++;
+
+		for (; printed < g.tty_len; printed++)
+		{
+			machine_write_io (&term, g.tty[printed]);
+		}
+		if (lim.max_cycles && (cycles >= lim.max_cycles))
+		{
+			why = STOP_CYCLES;
+		}
+		else if (ending)
+		{
+			instructions++;
+			if (verify)
+			{
+				while (!(machine_step (&m) & CW_LAST))
+				{
+				}
+				differences += compare (&g, &m, pc, cycles);
+			}
+			pc = gates_pc (&g);
+			if ((lim.stop_pc >= 0) && (pc == lim.stop_pc))
+			{
+				why = STOP_PC;
+			}
+			else if (lim.idle_polls && (g.kbd_pos == g.kbd_len) && (g.idle >= lim.idle_polls))
+			{
+				why = STOP_IDLE;
+			}
+		}
+	}
+	double t = now () - t0;
+
+	fflush (stdout);
+	fprintf (stderr, "\nstopped (%s) at pc %04x after %llu microcycles, %llu instructions\n",
+		reason[why], gates_pc (&g), (unsigned long long) cycles, (unsigned long long) instructions);
+	fprintf (stderr, "%.3f s, %.1f k microcycles/s, %u elements in %u levels\n", t, t > 0 ? cycles / t * 1e-3 : 0.0,
+		gates_info.elements, gates_info.levels);
+	if (verify)
+	{
+		fprintf (stderr, "%llu differences from machine.c\n", (unsigned long long) differences);
+	}
+	return 0;
+}
@@ -0,0 +1,776 @@
+// a just in time translator for the 8080 program: straight runs of instructions in
+// memory become x86-64 code, built by laying down a few host instructions for every
+// microstep of each opcode's sequence in the decoded ROM. Nothing about the 8080 is
+// written here, so the translated code does whatever the microcode does
+//
+// while a block runs, the machine state stays in the machine_t: rbx holds the
+// machine, r12 the jit and ebp the alu result of the current microstep
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fake8080.h"
+
+#if defined(__x86_64__) && !defined(NO_JIT)
+
+#include <sys/mman.h>
+
+const bool jit_native = true;
+
+#define JIT_MARGIN		(256 * 1024)	// more than the largest block can take
+
+// what translation knows about the machine part way through a block
+typedef struct
+{
+	uint16_t	pc;					// the pc, while known is set
+	bool		known;
+	bool		after_incl;			// the last step was the low half of a pc increment
+	uint8_t		pc_carry;			// and this is the carry it passes to the high half
+	int			flip;				// de and hl swapped
+	bool		dynamic;			// the instruction reads or writes memory at run time
+	int			last_page;			// the highest page anything was taken from
+} jit_state_t;
+
+// registers for the modrm byte
+enum
+{
+	EAX, ECX, EDX, EBX, ESP, EBP, ESI, EDI
+};
+
+#define M_OFF(field)	((int32_t) offsetof (machine_t, field))
+#define REG_OFF(r)		(M_OFF (reg) + (r))
+
+static void byte (jit_t *j, uint8_t b)
+{
+	j->code[j->code_used++] = b;
+}
+
+// a run of literal code bytes
+static void emit (jit_t *j, int n, ...)
+{
+	va_list ap;
+
+	va_start (ap, n);
+	for (int i = 0; i < n; i++)
+	{
+		byte (j, (uint8_t) va_arg (ap, int));
+	}
+	va_end (ap);
+}
+
+static void word32 (jit_t *j, uint32_t w)
+{
+	for (int i = 0; i < 4; i++)
+	{
+		byte (j, (uint8_t) (w >> (i * 8)));
+	}
+}
+
+static void word64 (jit_t *j, uint64_t w)
+{
+	word32 (j, (uint32_t) w);
+	word32 (j, (uint32_t) (w >> 32));
+}
+
+// opcode bytes, then a modrm for [rbx + disp32] with reg in the middle field
+static void rbx_disp (jit_t *j, int reg, int32_t disp)
+{
+	byte (j, 0x83 | (reg << 3));
+	word32 (j, (uint32_t) disp);
+}
+
+// movzx reg, byte [rbx + disp]
+static void load_byte (jit_t *j, int reg, int32_t disp)
+{
+	byte (j, 0x0f);
+	byte (j, 0xb6);
+	rbx_disp (j, reg, disp);
+}
+
+// mov byte [rbx + disp], al / cl / dl
+static void store_byte (jit_t *j, int reg, int32_t disp)
+{
+	byte (j, 0x88);
+	rbx_disp (j, reg, disp);
+}
+
+// mov byte [rbx + disp], imm8
+static void store_imm (jit_t *j, int32_t disp, uint8_t imm)
+{
+	byte (j, 0xc6);
+	rbx_disp (j, 0, disp);
+	byte (j, imm);
+}
+
+// setc byte [rbx + disp]
+static void store_carry (jit_t *j, int32_t disp)
+{
+	byte (j, 0x0f);
+	byte (j, 0x92);
+	rbx_disp (j, 0, disp);
+}
+
+// add qword [rbx + disp], imm32
+static void add_count (jit_t *j, int32_t disp, uint32_t n)
+{
+	byte (j, 0x48);
+	byte (j, 0x81);
+	rbx_disp (j, 0, disp);
+	word32 (j, n);
+}
+
+// mov rax, fn; call rax, with rdi already set up
+static void call (jit_t *j, const void *fn)
+{
+	byte (j, 0x48);
+	byte (j, 0xb8);
+	word64 (j, (uint64_t) (uintptr_t) fn);
+	byte (j, 0xff);
+	byte (j, 0xd0);
+}
+
+// a rel32 jump or conditional jump to be patched later; returns where the offset goes
+static size_t jump (jit_t *j, uint8_t cc)
+{
+	if (cc)
+	{
+		byte (j, 0x0f);
+		byte (j, cc);
+	}
+	else
+	{
+		byte (j, 0xe9);
+	}
+	word32 (j, 0);
+	return j->code_used - 4;
+}
+
+static void patch (jit_t *j, size_t at, size_t target)
+{
+	int32_t rel = (int32_t) (target - (at + 4));
+	memcpy (&j->code[at], &rel, 4);
+}
+
+// the memory helpers called from translated code; anything that isn't plain memory
+// asks the block to stop at the end of the instruction so the limits can be checked
+// and invalidated code isn't run again
+static uint8_t jit_read (jit_t *j, uint16_t addr)
+{
+	if (addr == SER_IN)
+	{
+		j->exit = 1;
+		return machine_read_io (j->m);
+	}
+	return j->m->mem[addr];
+}
+
+static void jit_invalidate (jit_t *j, int page)
+{
+	// blocks cover at most two pages, so only those starting in this one or the one
+	// before can have taken anything from it
+	for (int flip = 0; flip < 2; flip++)
+	{
+		for (int pc = (page > 0) ? (page - 1) * 256 : 0; pc < (page + 1) * 256; pc++)
+		{
+			jit_block_t *b = j->lookup[flip][pc];
+			if ((b != NULL) && (b->first_page <= page) && (b->last_page >= page))
+			{
+				j->lookup[flip][pc] = NULL;
+			}
+		}
+	}
+	j->code_page[page] = 0;
+	memset (&j->code_byte[page * 256], 0, 256);
+	j->invalidated++;
+}
+
+static void jit_write (jit_t *j, uint16_t addr, uint8_t data)
+{
+	if (j->code_page[addr >> 8] && j->code_byte[addr])
+	{
+		jit_invalidate (j, addr >> 8);
+		j->exit = 1;
+	}
+	if (addr == SER_OUT)
+	{
+		j->exit = 1;
+		machine_write_io (j->m, data);
+	}
+	else
+	{
+		j->m->mem[addr] = data;
+		j->m->dirty[addr / PAGE_SIZE] = 1;
+	}
+}
+
+static void jit_flush (jit_t *j)
+{
+	memset (j->lookup, 0, sizeof (j->lookup));
+	memset (j->code_page, 0, sizeof (j->code_page));
+	memset (j->code_byte, 0, sizeof (j->code_byte));
+	j->blocks = 0;
+	j->code_used = 0;
+}
+
+// esi = the address the select puts on the bus
+static void emit_address (jit_t *j, int sel, int flip)
+{
+	static const uint8_t pair[4][2] =
+	{
+		{ REG_H, REG_L }, { REG_PCH, REG_PCL }, { REG_SPH, REG_SPL }, { REG_MAH, REG_MAL }
+	};
+
+	load_byte (j, ESI, REG_OFF (xmap[flip][pair[sel][0]]));
+	byte (j, 0xc1);									// shl esi, 8
+	byte (j, 0xe6);
+	byte (j, 0x08);
+	load_byte (j, ECX, REG_OFF (xmap[flip][pair[sel][1]]));
+	byte (j, 0x09);									// or esi, ecx
+	byte (j, 0xce);
+}
+
+// a byte can be built into the code if it is ordinary memory in the block's own page
+// or the next, which are the ones watched for writes
+static bool bakeable (const jit_block_t *b, uint16_t addr)
+{
+	return (addr != SER_IN) && ((addr >> 8) >= b->first_page) && ((addr >> 8) <= b->first_page + 1);
+}
+
+// the pc counting on at the end of a cycle, for the seq -v overlap variant
+static void emit_count_pc (jit_t *j)
+{
+	byte (j, 0x80);											// add byte [pcl], 1
+	rbx_disp (j, 0, REG_OFF (REG_PCL));
+	byte (j, 0x01);
+	byte (j, 0x80);											// adc byte [pch], 0
+	rbx_disp (j, 2, REG_OFF (REG_PCH));
+	byte (j, 0x00);
+}
+
+// one microcycle from decoded slot i, the same work as execute() in decode.c
+static void emit_step (jit_t *j, jit_block_t *b, int i, jit_state_t *s)
+{
+	const microcode_t *mc = j->mc;
+	const uint8_t *map = xmap[s->flip];
+	int w = mc->word[i];
+	int src = mc->src[w];
+	int dest = mc->dest[w];
+	int op = mc->alu[w];
+	int flags = mc->flags[w];
+
+	// the source into eax
+	switch (src)
+	{
+		case REG_M:
+			if ((mc->addr[w] == ADDR_PC) && s->known && bakeable (b, s->pc))
+			{
+				byte (j, 0xb8);								// mov eax, imm32
+				word32 (j, j->m->mem[s->pc]);
+				j->code_byte[s->pc] = 1;
+				if ((s->pc >> 8) > s->last_page)
+				{
+					s->last_page = s->pc >> 8;
+				}
+			}
+			else
+			{
+				emit_address (j, mc->addr[w], s->flip);
+				emit (j, 3, 0x4c, 0x89, 0xe7);				// mov rdi, r12
+				call (j, (const void *) jit_read);
+				emit (j, 3, 0x0f, 0xb6, 0xc0);				// movzx eax, al
+				s->dynamic = true;
+			}
+			break;
+		case REG_FLAG:
+			emit (j, 3, 0x48, 0x89, 0xdf);					// mov rdi, rbx
+			call (j, (const void *) machine_flags);
+			emit (j, 3, 0x0f, 0xb6, 0xc0);					// movzx eax, al
+			break;
+		case REG_IR:
+			load_byte (j, EAX, REG_OFF (REG_IR));
+			emit (j, 3, 0x83, 0xe0, 0x38);					// and eax, 0x38
+			break;
+		default:
+			load_byte (j, EAX, REG_OFF (map[src]));
+			break;
+	}
+
+	// the alu, leaving the result in al and the carry out in icarry; the host's carry
+	// flag behaves the same way as the alu's, borrows included
+	switch (op)
+	{
+		case ALU_ADD:	case ALU_ADC:	case ALU_SUB:	case ALU_SBB:
+		case ALU_AND:	case ALU_XOR:	case ALU_OR:	case ALU_CMP:
+		{
+			static const uint8_t code[8] = { 0x00, 0x10, 0x28, 0x18, 0x20, 0x30, 0x08, 0x28 };
+
+			emit (j, 2, 0x89, 0xc1);						// mov ecx, eax
+			if ((op == ALU_ADC) || (op == ALU_SBB))
+			{
+				load_byte (j, EDX, M_OFF (carry));
+				emit (j, 2, 0xd0, 0xea);					// shr dl, 1
+			}
+			load_byte (j, EAX, REG_OFF (REG_A));			// doesn't touch the flags
+			emit (j, 2, code[op], 0xc8);					// op al, cl
+			store_carry (j, M_OFF (icarry));
+			break;
+		}
+		case ALU_INCL:
+			emit (j, 2, 0x04, 0x01);						// add al, 1
+			store_carry (j, M_OFF (icarry));
+			break;
+		case ALU_INCH:
+			byte (j, 0x02);									// add al, [icarry]
+			rbx_disp (j, EAX, M_OFF (icarry));
+			store_carry (j, M_OFF (icarry));
+			break;
+		case ALU_DECL:
+			emit (j, 2, 0x2c, 0x01);						// sub al, 1
+			store_carry (j, M_OFF (icarry));
+			break;
+		case ALU_DECH:
+			byte (j, 0x2a);									// sub al, [icarry]
+			rbx_disp (j, EAX, M_OFF (icarry));
+			store_carry (j, M_OFF (icarry));
+			break;
+		case ALU_RAR:
+			load_byte (j, EDX, M_OFF (carry));
+			emit (j, 2, 0xd0, 0xea);						// shr dl, 1
+			emit (j, 2, 0xd0, 0xd8);						// rcr al, 1
+			store_carry (j, M_OFF (icarry));
+			break;
+		case ALU_RRC:
+			emit (j, 2, 0xd0, 0xc8);						// ror al, 1
+			store_carry (j, M_OFF (icarry));
+			break;
+		case ALU_ZERO:
+			emit (j, 2, 0x31, 0xc0);						// xor eax, eax
+			store_imm (j, M_OFF (icarry), 0);
+			break;
+		default:
+			store_imm (j, M_OFF (icarry), 0);
+			break;
+	}
+	emit (j, 3, 0x0f, 0xb6, 0xe8);							// movzx ebp, al
+
+	switch (dest)
+	{
+		case REG_M:
+			emit_address (j, mc->addr[w], s->flip);
+			emit (j, 2, 0x89, 0xea);						// mov edx, ebp
+			emit (j, 3, 0x4c, 0x89, 0xe7);					// mov rdi, r12
+			call (j, (const void *) jit_write);
+			s->dynamic = true;
+			break;
+		case REG_FLAG:
+			emit (j, 5, 0x89, 0xe8, 0x83, 0xe0, 0x01);		// mov eax, ebp; and eax, 1
+			store_byte (j, EAX, M_OFF (carry));
+			emit (j, 5, 0x89, 0xe8, 0xc1, 0xe8, 0x06);		// mov eax, ebp; shr eax, 6
+			emit (j, 3, 0x83, 0xe0, 0x01);					// and eax, 1
+			store_byte (j, EAX, M_OFF (zero));
+			emit (j, 5, 0x89, 0xe8, 0xc1, 0xe8, 0x07);		// mov eax, ebp; shr eax, 7
+			store_byte (j, EAX, M_OFF (sign));
+			break;
+		default:
+			store_byte (j, EAX, REG_OFF (map[dest]));
+			break;
+	}
+
+	if (flags & MF_CARRY)
+	{
+		if (flags & MF_STC)
+		{
+			store_imm (j, M_OFF (carry), 1);
+		}
+		else if (flags & MF_CMC)
+		{
+			byte (j, 0x80);									// xor byte [carry], 1
+			rbx_disp (j, 6, M_OFF (carry));
+			byte (j, 0x01);
+		}
+		else
+		{
+			load_byte (j, EAX, M_OFF (icarry));
+			store_byte (j, EAX, M_OFF (carry));
+		}
+	}
+	if (flags & MF_ZS)
+	{
+		emit (j, 4, 0x89, 0xe8, 0x84, 0xc0);				// mov eax, ebp; test al, al
+		byte (j, 0x0f);										// sete [zero]
+		byte (j, 0x94);
+		rbx_disp (j, 0, M_OFF (zero));
+		emit (j, 3, 0xc0, 0xe8, 0x07);						// shr al, 7
+		store_byte (j, EAX, M_OFF (sign));
+	}
+	if (flags & MF_INTON)
+	{
+		store_imm (j, M_OFF (inte), 1);
+	}
+	if (flags & MF_INTOFF)
+	{
+		store_imm (j, M_OFF (inte), 0);
+	}
+	if (flags & MF_XCHG)
+	{
+		byte (j, 0x80);										// xor byte [flip], 1
+		rbx_disp (j, 6, M_OFF (flip));
+		byte (j, 0x01);
+		s->flip ^= 1;
+	}
+	if (flags & MF_PCINC)
+	{
+		emit_count_pc (j);
+	}
+	if (flags & (MF_INC16 | MF_DEC16))
+	{
+		// add or sub byte [low], 1, then adc or sbb byte [high], 0, and the carry out
+		bool down = (flags & MF_DEC16) != 0;
+		byte (j, 0x80);
+		rbx_disp (j, down ? 5 : 0, REG_OFF (map[dest | 1]));
+		byte (j, 0x01);
+		byte (j, 0x80);
+		rbx_disp (j, down ? 3 : 2, REG_OFF (map[dest & ~1]));
+		byte (j, 0x00);
+		store_carry (j, M_OFF (icarry));
+	}
+
+	// keep track of the pc through the increments every instruction does; anything
+	// else that writes it is a jump and the block ends there
+	bool incl = false;
+	if ((flags & (MF_INC16 | MF_DEC16)) && ((dest == REG_PCH) || (dest == REG_PCL)) && (src == dest) && (op == ALU_PASS))
+	{
+		s->pc += (flags & MF_DEC16) ? -1 : 1;
+	}
+	else if ((dest == REG_PCL) && (src == REG_PCL) && (op == ALU_INCL))
+	{
+		s->pc_carry = ((s->pc & 0xff) == 0xff);
+		s->pc = (s->pc & 0xff00) | ((s->pc + 1) & 0xff);
+		incl = true;
+	}
+	else if ((dest == REG_PCH) && (src == REG_PCH) && (op == ALU_INCH) && s->after_incl)
+	{
+		s->pc += s->pc_carry << 8;
+	}
+	else if ((dest == REG_PCH) || (dest == REG_PCL))
+	{
+		s->known = false;
+	}
+	if (flags & MF_PCINC)
+	{
+		s->pc++;
+	}
+	s->after_incl = incl;
+}
+
+// steps 1 to LAST of one half, then the cycle count for the whole instruction
+static void emit_half (jit_t *j, jit_block_t *b, int half, jit_state_t *s)
+{
+	int n = j->mc->length[half];
+
+	for (int step = 1; step < n; step++)
+	{
+		emit_step (j, b, (j->mc->seq[half] << 5) | step, s);
+	}
+	add_count (j, M_OFF (cycles), n);
+}
+
+static bool same_half (const microcode_t *mc, int a, int b)
+{
+	int n = mc->length[a];
+
+	if (mc->length[b] != n)
+	{
+		return false;
+	}
+	for (int i = 0; i < n; i++)
+	{
+		int x = mc->word[(mc->seq[a] << 5) | i];
+		int y = mc->word[(mc->seq[b] << 5) | i];
+		if ((mc->src[x] != mc->src[y]) || (mc->dest[x] != mc->dest[y]) || (mc->addr[x] != mc->addr[y])
+			|| (mc->alu[x] != mc->alu[y]) || (mc->flags[x] != mc->flags[y]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// translate from pc until something changes the pc other than by counting past the
+// instruction; NULL if the first instruction can't be translated
+static jit_block_t *translate (jit_t *j, uint16_t pc, int flip)
+{
+	if ((j->blocks == JIT_BLOCKS) || (JIT_CODE_SIZE - j->code_used < JIT_MARGIN))
+	{
+		jit_flush (j);
+	}
+	if ((pc == SER_IN) || !j->ok[j->m->mem[pc]])
+	{
+		return NULL;
+	}
+
+	jit_block_t *b = &j->block[j->blocks++];
+	b->code = (void (*) (machine_t *, void *)) (j->code + j->code_used);
+	b->first_page = pc >> 8;
+	b->max_cycles = 0;
+
+	emit (j, 4, 0x53, 0x55, 0x41, 0x54);					// push rbx; push rbp; push r12
+	emit (j, 6, 0x48, 0x89, 0xfb, 0x49, 0x89, 0xf4);		// mov rbx, rdi; mov r12, rsi
+
+	size_t exits[JIT_INSNS];
+	int nexits = 0;
+	jit_state_t s = { pc, true, false, 0, flip, false, pc >> 8 };
+
+	for (int n = 0; n < JIT_INSNS; n++)
+	{
+		uint8_t op = j->m->mem[s.pc];
+		int half = op << 1;
+
+		if ((n > 0) && ((s.pc == j->stop_pc) || !bakeable (b, s.pc) || !j->ok[op]))
+		{
+			break;
+		}
+		if ((s.pc >> 8) > s.last_page)
+		{
+			s.last_page = s.pc >> 8;
+		}
+
+		// the fetch in step 0, with the opcode built in and the condition from the flags
+		store_imm (j, REG_OFF (REG_IR), op);
+		j->code_byte[s.pc] = 1;
+		switch ((op >> 4) & 3)
+		{
+			case 0:		load_byte (j, EAX, M_OFF (zero));	break;
+			case 1:		load_byte (j, EAX, M_OFF (carry));	break;
+			case 2:		emit (j, 2, 0x31, 0xc0);			break;	// parity: xor eax, eax
+			default:	load_byte (j, EAX, M_OFF (sign));	break;
+		}
+		emit (j, 2, 0x34, ((op >> 3) & 1) ^ 1);				// xor al, imm8
+		store_byte (j, EAX, M_OFF (cond));
+		store_imm (j, M_OFF (icarry), 0);
+		if (j->mc->flags[j->mc->word[0]] & MF_PCINC)
+		{
+			s.pc++;
+			store_imm (j, REG_OFF (REG_PCL), (uint8_t) s.pc);
+			store_imm (j, REG_OFF (REG_PCH), s.pc >> 8);
+		}
+
+		s.dynamic = false;
+		s.after_incl = false;
+		int cycles = j->mc->length[half];
+		bool carry_on;
+		if (same_half (j->mc, half, half + 1))
+		{
+			emit_half (j, b, half, &s);
+			carry_on = s.known;
+		}
+		else
+		{
+			jit_state_t t = s;
+
+			byte (j, 0x80);									// cmp byte [cond], 0
+			rbx_disp (j, 7, M_OFF (cond));
+			byte (j, 0x00);
+			size_t to_true = jump (j, 0x85);				// jne
+			emit_half (j, b, half, &s);
+			size_t to_done = jump (j, 0);
+			patch (j, to_true, j->code_used);
+			emit_half (j, b, half + 1, &t);
+			patch (j, to_done, j->code_used);
+
+			carry_on = s.known && t.known && (s.pc == t.pc) && (s.flip == t.flip);
+			s.dynamic |= t.dynamic;
+			if (t.last_page > s.last_page)
+			{
+				s.last_page = t.last_page;
+			}
+			if (j->mc->length[half + 1] > cycles)
+			{
+				cycles = j->mc->length[half + 1];
+			}
+		}
+		add_count (j, M_OFF (instructions), 1);
+		b->max_cycles += cycles;
+
+		if (!carry_on)
+		{
+			break;
+		}
+		if (s.dynamic)
+		{
+			byte (j, 0x41);									// cmp byte [r12 + exit], 0
+			byte (j, 0x80);
+			byte (j, 0xbc);
+			byte (j, 0x24);
+			word32 (j, (uint32_t) offsetof (jit_t, exit));
+			byte (j, 0x00);
+			exits[nexits++] = jump (j, 0x85);				// jne
+		}
+	}
+
+	for (int i = 0; i < nexits; i++)
+	{
+		patch (j, exits[i], j->code_used);
+	}
+	emit (j, 5, 0x41, 0x5c, 0x5d, 0x5b, 0xc3);				// pop r12; pop rbp; pop rbx; ret
+
+	b->last_page = s.last_page;
+	for (int page = b->first_page; page <= b->last_page; page++)
+	{
+		j->code_page[page] = 1;
+	}
+	j->lookup[flip][pc] = b;
+	j->translated++;
+	return b;
+}
+
+bool jit_init (jit_t *j, const microcode_t *mc)
+{
+	j->mc = mc;
+	j->code = NULL;
+	j->translated = 0;
+	j->invalidated = 0;
+
+	// every block starts with the same fetch, which the translator builds in; the pc
+	// may count on during it
+	for (int half = 0; half < 512; half++)
+	{
+		int w = mc->word[mc->seq[half] << 5];
+		if ((mc->src[w] != REG_M) || (mc->addr[w] != ADDR_PC) || (mc->dest[w] != REG_IR)
+			|| (mc->alu[w] != ALU_PASS) || (mc->flags[w] != mc->flags[mc->word[0]])
+			|| (mc->flags[w] & ~MF_PCINC) || mc->last[w])
+		{
+			return false;
+		}
+	}
+
+	// an opcode is translated if both its sequences end, and don't reload the IR
+	for (int op = 0; op < 256; op++)
+	{
+		j->ok[op] = true;
+		for (int half = op * 2; half < op * 2 + 2; half++)
+		{
+			if (mc->length[half] == 0)
+			{
+				j->ok[op] = false;
+			}
+			for (int step = 1; step < mc->length[half]; step++)
+			{
+				if (mc->dest[mc->word[(mc->seq[half] << 5) | step]] == REG_IR)
+				{
+					j->ok[op] = false;
+				}
+			}
+		}
+	}
+
+	void *code = mmap (NULL, JIT_CODE_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (code == MAP_FAILED)
+	{
+		perror ("jit");
+		return false;
+	}
+	j->code = code;
+	jit_flush (j);
+	return true;
+}
+
+int machine_run_jit (machine_t *m, jit_t *j, const run_limits_t *lim)
+{
+	int why;
+
+	if (j->code == NULL)
+	{
+		return machine_run_decoded (m, j->mc, lim);
+	}
+
+	// finish off an instruction we were stopped in the middle of
+	while (m->step != 0)
+	{
+		if (lim->max_cycles && (m->cycles >= lim->max_cycles))
+		{
+			return STOP_CYCLES;
+		}
+		machine_step_decoded (m, j->mc);
+	}
+
+	// memory may have changed since the last run, and blocks end at the stop address
+	jit_flush (j);
+	j->m = m;
+	j->stop_pc = lim->stop_pc;
+
+	for (;;)
+	{
+		uint16_t pc = machine_pc (m);
+		jit_block_t *b = j->lookup[m->flip][pc];
+
+		if (b == NULL)
+		{
+			b = translate (j, pc, m->flip);
+		}
+		if (b == NULL)
+		{
+			// step through it, and assume it wrote over any code
+			if (lim->max_cycles && (m->cycles >= lim->max_cycles))
+			{
+				return STOP_CYCLES;
+			}
+			if (lim->max_cycles && (m->cycles + 64 > lim->max_cycles))
+			{
+				return machine_run_decoded (m, j->mc, lim);
+			}
+			do
+			{
+				if (lim->max_cycles && (m->cycles >= lim->max_cycles))
+				{
+					return STOP_CYCLES;
+				}
+				machine_step_decoded (m, j->mc);
+			}
+			while (m->step != 0);
+			jit_flush (j);
+		}
+		else
+		{
+			// the cycle limit is only looked at between blocks
+			if (lim->max_cycles && (m->cycles >= lim->max_cycles))
+			{
+				return STOP_CYCLES;
+			}
+			if (lim->max_cycles && (m->cycles + b->max_cycles > lim->max_cycles))
+			{
+				return machine_run_decoded (m, j->mc, lim);
+			}
+			j->exit = 0;
+			b->code (m, j);
+		}
+
+		why = machine_limit (m, lim);
+		if (why >= 0)
+		{
+			return why;
+		}
+	}
+}
+
+#else
+
+// no translator for this host: the jit engine is the soa one
+const bool jit_native = false;
+
+bool jit_init (jit_t *j, const microcode_t *mc)
+{
+	j->mc = mc;
+	j->code = NULL;
+	j->translated = 0;
+	j->invalidated = 0;
+	return false;
+}
+
+int machine_run_jit (machine_t *m, jit_t *j, const run_limits_t *lim)
+{
+	return machine_run_decoded (m, j->mc, lim);
+}
+
+#endif
@@ -0,0 +1,249 @@
+// the Fake8080 machine: register file, flags, memory and terminal, stepped one
+// microcycle at a time from the control words in the sequencer ROM
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fake8080.h"
+
+// register codes after the xchg alias; when flip is set D <=> H and E <=> L
+const uint8_t xmap[2][16] =
+{
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	{ 0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+};
+
+void machine_reset (machine_t *m, const uint32_t *rom)
+{
+	memset (m->reg, 0, sizeof (m->reg));
+	m->step = 0;
+	m->cond = 0;
+	m->carry = 0;
+	m->zero = 0;
+	m->sign = 0;
+	m->icarry = 0;
+	m->flip = 0;
+	m->inte = 0;
+	m->cycles = 0;
+	m->instructions = 0;
+	m->idle = 0;
+	m->rom = rom;
+	m->origin = NULL;
+	memset (m->dirty, 0, sizeof (m->dirty));
+}
+
+// give the keyboard something to type; newlines become carriage returns
+void machine_input (machine_t *m, const uint8_t *text, size_t len)
+{
+	uint8_t *kbd = malloc (len ? len : 1);
+	for (size_t i = 0; i < len; i++)
+	{
+		kbd[i] = (text[i] == '\n') ? '\r' : text[i];
+	}
+	m->kbd = kbd;
+	m->kbd_len = len;
+	m->kbd_pos = 0;
+}
+
+// type some more after whatever is still waiting, as when a machine restored from a
+// snapshot is given a script; the old buffer is left to its owner
+void machine_type (machine_t *m, const uint8_t *text, size_t len)
+{
+	size_t pending = m->kbd_len - m->kbd_pos;
+	uint8_t *all = malloc (pending + len + 1);
+	if (pending)
+	{
+		memcpy (all, m->kbd + m->kbd_pos, pending);
+	}
+	memcpy (all + pending, text, len);
+	machine_input (m, all, pending + len);
+	free (all);
+}
+
+uint16_t machine_pc (const machine_t *m)
+{
+	return (m->reg[REG_PCH] << 8) | m->reg[REG_PCL];
+}
+
+uint8_t machine_flags (const machine_t *m)
+{
+	return (m->carry ? FLAG_C : 0) | (m->zero ? FLAG_Z : 0) | (m->sign ? FLAG_S : 0);
+}
+
+// the conditional circuit: ir bits 5-4 select zero, carry, parity (not implemented, so
+// always clear) or sign, and the condition is true when that flag matches ir bit 3
+uint8_t machine_condition (const machine_t *m, uint8_t ir)
+{
+	uint8_t flag;
+
+	switch ((ir >> 4) & 3)
+	{
+		case 0:		flag = m->zero;		break;
+		case 1:		flag = m->carry;	break;
+		case 2:		flag = 0;			break;
+		default:	flag = m->sign;		break;
+	}
+	return flag == ((ir >> 3) & 1);
+}
+
+// the terminal; plain memory accesses never leave machine_read and machine_write
+uint8_t machine_read_io (machine_t *m)
+{
+	if (m->kbd_pos < m->kbd_len)
+	{
+		m->idle = 0;
+		return m->kbd[m->kbd_pos++];
+	}
+	m->idle++;
+	return 0;
+}
+
+void machine_write_io (machine_t *m, uint8_t data)
+{
+	if (m->tty_len == m->tty_cap)
+	{
+		m->tty_cap = m->tty_cap ? m->tty_cap * 2 : 4096;
+		m->tty = realloc (m->tty, m->tty_cap);
+	}
+	m->tty[m->tty_len++] = data;
+	m->idle = 0;
+	if (m->echo)
+	{
+		// the terminal wants cr/lf; the host wants a single newline
+		if (data == '\r')
+		{
+			putchar ('\n');
+		}
+		else if ((data != '\n') || (m->tty_len < 2) || (m->tty[m->tty_len - 2] != '\r'))
+		{
+			putchar (data);
+		}
+	}
+}
+
+// one clock: decode the control word, move the source through the alu to the
+// destination, then update the flags and the microstep counter
+uint32_t machine_step (machine_t *m)
+{
+	uint32_t w = m->rom[(m->reg[REG_IR] << 6) | (m->cond << 5) | m->step];
+	const uint8_t *map = xmap[m->flip];
+	uint16_t addr = machine_address (m, CW_ADDR (w));
+	int src = CW_SRC (w);
+	int dest = CW_DEST (w);
+	uint8_t bus;
+	uint8_t cout;
+
+	switch (src)
+	{
+		case REG_M:		bus = machine_read (m, addr);			break;
+		case REG_FLAG:	bus = machine_flags (m);				break;
+		case REG_IR:	bus = m->reg[REG_IR] & 0x38;			break;	// the rst vector
+		default:		bus = m->reg[map[src]];					break;
+	}
+
+	uint8_t r = alu (CW_ALU (w), m->reg[REG_A], bus, m->carry, m->icarry, &cout);
+
+	switch (dest)
+	{
+		case REG_M:
+			machine_write (m, addr, r);
+			break;
+		case REG_FLAG:
+			m->carry = (r & FLAG_C) != 0;
+			m->zero = (r & FLAG_Z) != 0;
+			m->sign = (r & FLAG_S) != 0;
+			break;
+		case REG_IR:
+			m->reg[REG_IR] = r;
+			m->cond = machine_condition (m, r);
+			break;
+		default:
+			m->reg[map[dest]] = r;
+			break;
+	}
+
+	if (w & CW_CARRYF)
+	{
+		m->carry = (w & CW_STC) ? 1 : (w & CW_CMC) ? !m->carry : cout;
+	}
+	if (w & CW_ZSF)
+	{
+		m->zero = (r == 0);
+		m->sign = r >> 7;
+	}
+	m->icarry = cout;
+
+	if (w & CW_INTON)
+	{
+		m->inte = 1;
+	}
+	if (w & CW_INTOFF)
+	{
+		m->inte = 0;
+	}
+	if (w & CW_XCHG)
+	{
+		m->flip ^= 1;
+	}
+	if (w & CW_PCINC)
+	{
+		uint16_t pc = machine_pc (m) + 1;
+		m->reg[REG_PCL] = (uint8_t) pc;
+		m->reg[REG_PCH] = pc >> 8;
+	}
+	if (w & (CW_INC16 | CW_DEC16))
+	{
+		machine_count_pair (m, map, dest, (w & CW_DEC16) != 0);
+	}
+
+	m->cycles++;
+	if (w & CW_LAST)
+	{
+		m->step = 0;
+		m->instructions++;
+	}
+	else
+	{
+		m->step = (m->step + 1) & 31;
+	}
+	return w;
+}
+
+// check the pc and idle limits; only meaningful between instructions
+// returns the STOP_ reason, or -1 to carry on
+int machine_limit (const machine_t *m, const run_limits_t *lim)
+{
+	if ((lim->stop_pc >= 0) && (machine_pc (m) == lim->stop_pc))
+	{
+		return STOP_PC;
+	}
+	if (lim->idle_polls && (m->kbd_pos == m->kbd_len) && (m->idle >= lim->idle_polls))
+	{
+		return STOP_IDLE;
+	}
+	return -1;
+}
+
+// run until one of the limits is reached
+int machine_run (machine_t *m, const run_limits_t *lim)
+{
+	for (;;)
+	{
+		// a sequence without a LAST just wraps the step counter, so the cycle limit is
+		// checked every clock
+		uint32_t w = machine_step (m);
+		if (lim->max_cycles && (m->cycles >= lim->max_cycles))
+		{
+			return STOP_CYCLES;
+		}
+		if (w & CW_LAST)
+		{
+			int why = machine_limit (m, lim);
+			if (why >= 0)
+			{
+				return why;
+			}
+		}
+	}
+}
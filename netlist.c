@@ -0,0 +1,2141 @@
+// imports a Logisim .circ file into the flat netlist described in netlist.h
+//
+// the file is read in one pass by a small streaming XML reader that keeps only the
+// circuits: their components with their attributes, and their wires. Then each circuit
+// is wired up on its own: the points where wires end and components have ports are
+// joined into nets, through the wires (and the middles of wires, which Logisim joins
+// as well), and through tunnels with the same label. Each net gets the width of the
+// ports on it, splitters and constants join its bits with other nets' and with the
+// constant nets, and what is left are the circuit's bit classes, numbered from 2 with
+// 0 and 1 the constants. Flattening then gives each instance of a circuit a run of
+// nodes for its classes, joins a subcircuit's pins to the nets on its ports and emits
+// the elements, and the nodes that end up joined are numbered as nets
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "netlist.h"
+
+const char *const nl_kind_name[NL_KINDS] =
+{
+	"and", "or", "xor", "not", "tri", "mux", "decoder", "compare",
+	"dff", "jkff", "reg", "rom", "ram",
+	"clock", "input", "output", "tty", "keyboard"
+};
+
+static void *grow (void *p, size_t want, size_t *cap, size_t size)
+{
+	if (want <= *cap)
+	{
+		return p;
+	}
+	size_t n = (*cap != 0) ? *cap : 64;
+	while (n < want)
+	{
+		n *= 2;
+	}
+	p = realloc (p, n * size);
+	if (p == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (1);
+	}
+	*cap = n;
+	return p;
+}
+
+#define PUSH(a, n, cap, v)	do { (a) = grow ((a), (n) + 1, &(cap), sizeof (*(a))); (a)[(n)++] = (v); } while (0)
+
+// ---- the XML reader
+
+#define XML_ATTRS		16
+
+enum
+{
+	X_END, X_OPEN, X_CLOSE, X_TEXT, X_ERROR
+};
+
+typedef struct
+{
+	FILE		*f;
+	char		buf[65536];
+	size_t		pos;
+	size_t		len;
+	int			back;				// a character read one too far, or EOF for none
+	int			line;
+
+	// the current token: the tag name or the text at 0, then the attributes
+	char		*text;
+	size_t		text_len;
+	size_t		text_cap;
+	int			attrs;
+	size_t		key[XML_ATTRS];
+	size_t		val[XML_ATTRS];
+	bool		close_next;			// <x/> is returned as an X_OPEN and then an X_CLOSE
+} xml_t;
+
+static int xml_getc (xml_t *x)
+{
+	int c = x->back;
+	if (c != EOF)
+	{
+		x->back = EOF;
+		return c;
+	}
+	if (x->pos == x->len)
+	{
+		x->len = fread (x->buf, 1, sizeof (x->buf), x->f);
+		x->pos = 0;
+		if (x->len == 0)
+		{
+			return EOF;
+		}
+	}
+	c = (unsigned char) x->buf[x->pos++];
+	x->line += (c == '\n');
+	return c;
+}
+
+static void xml_put (xml_t *x, int c)
+{
+	x->text = grow (x->text, x->text_len + 1, &x->text_cap, 1);
+	x->text[x->text_len++] = (char) c;
+}
+
+// after the '&'; only ASCII comes out of a character reference
+static void xml_entity (xml_t *x)
+{
+	char name[12];
+	int len = 0;
+	int c;
+
+	while (((c = xml_getc (x)) != EOF) && (c != ';') && (len < (int) sizeof (name) - 1))
+	{
+		name[len++] = (char) c;
+	}
+	name[len] = 0;
+	if (strcmp (name, "amp") == 0)
+	{
+		xml_put (x, '&');
+	}
+	else if (strcmp (name, "lt") == 0)
+	{
+		xml_put (x, '<');
+	}
+	else if (strcmp (name, "gt") == 0)
+	{
+		xml_put (x, '>');
+	}
+	else if (strcmp (name, "quot") == 0)
+	{
+		xml_put (x, '"');
+	}
+	else if (strcmp (name, "apos") == 0)
+	{
+		xml_put (x, '\'');
+	}
+	else if (name[0] == '#')
+	{
+		long v = (name[1] == 'x') ? strtol (name + 2, NULL, 16) : strtol (name + 1, NULL, 10);
+		xml_put (x, ((v > 0) && (v < 128)) ? (int) v : '?');
+	}
+}
+
+static bool xml_name_char (int c)
+{
+	return isalnum (c) || (c == '_') || (c == '-') || (c == ':') || (c == '.');
+}
+
+static int xml_skip_space (xml_t *x, int c)
+{
+	while (isspace (c))
+	{
+		c = xml_getc (x);
+	}
+	return c;
+}
+
+static int xml_next (xml_t *x)
+{
+	if (x->close_next)
+	{
+		x->close_next = false;
+		x->attrs = 0;
+		return X_CLOSE;
+	}
+	x->text_len = 0;
+	x->attrs = 0;
+
+	int c = xml_getc (x);
+	if (c == EOF)
+	{
+		return X_END;
+	}
+	if (c != '<')
+	{
+		while ((c != EOF) && (c != '<'))
+		{
+			if (c == '&')
+			{
+				xml_entity (x);
+			}
+			else
+			{
+				xml_put (x, c);
+			}
+			c = xml_getc (x);
+		}
+		x->back = c;
+		xml_put (x, 0);
+		return X_TEXT;
+	}
+
+	c = xml_getc (x);
+	if ((c == '?') || (c == '!'))
+	{
+		// the declaration, comments and doctypes; only a comment can hold a '>'
+		int dashes = 0;
+		bool comment = false;
+		int prev = c;
+		while (((c = xml_getc (x)) != EOF) && !((c == '>') && (!comment || (dashes >= 2))))
+		{
+			comment |= (prev == '!') && (c == '-');
+			dashes = (c == '-') ? dashes + 1 : 0;
+			prev = c;
+		}
+		return (c == EOF) ? X_ERROR : xml_next (x);
+	}
+
+	bool closing = (c == '/');
+	if (closing)
+	{
+		c = xml_getc (x);
+	}
+	while (xml_name_char (c))
+	{
+		xml_put (x, c);
+		c = xml_getc (x);
+	}
+	xml_put (x, 0);
+
+	for (;;)
+	{
+		c = xml_skip_space (x, c);
+		if (c == '>')
+		{
+			break;
+		}
+		if ((c == '/') && !closing)
+		{
+			if (xml_getc (x) != '>')
+			{
+				return X_ERROR;
+			}
+			x->close_next = true;
+			break;
+		}
+		if (closing || !xml_name_char (c) || (x->attrs == XML_ATTRS))
+		{
+			return X_ERROR;
+		}
+		x->key[x->attrs] = x->text_len;
+		while (xml_name_char (c))
+		{
+			xml_put (x, c);
+			c = xml_getc (x);
+		}
+		xml_put (x, 0);
+		c = xml_skip_space (x, c);
+		if (c != '=')
+		{
+			return X_ERROR;
+		}
+		int quote = xml_skip_space (x, xml_getc (x));
+		if ((quote != '"') && (quote != '\''))
+		{
+			return X_ERROR;
+		}
+		x->val[x->attrs] = x->text_len;
+		while (((c = xml_getc (x)) != EOF) && (c != quote))
+		{
+			if (c == '&')
+			{
+				xml_entity (x);
+			}
+			else
+			{
+				xml_put (x, c);
+			}
+		}
+		if (c == EOF)
+		{
+			return X_ERROR;
+		}
+		xml_put (x, 0);
+		x->attrs++;
+		c = xml_getc (x);
+	}
+	return closing ? X_CLOSE : X_OPEN;
+}
+
+static const char *xml_attr (const xml_t *x, const char *key)
+{
+	for (int i = 0; i < x->attrs; i++)
+	{
+		if (strcmp (x->text + x->key[i], key) == 0)
+		{
+			return x->text + x->val[i];
+		}
+	}
+	return NULL;
+}
+
+// ---- the circuits as read
+
+enum
+{
+	T_PIN, T_TUNNEL, T_SPLITTER, T_CONSTANT, T_PROBE, T_CLOCK,
+	T_AND, T_OR, T_XOR, T_NAND, T_NOR, T_XNOR, T_NOT, T_BUFFER,
+	T_MUX, T_DECODER, T_COMPARATOR, T_DFF, T_JKFF, T_REGISTER, T_ROM, T_RAM,
+	T_BUTTON, T_LED, T_TTY, T_KEYBOARD, T_IGNORED, T_SUB
+};
+
+static const struct
+{
+	const char	*name;
+	int			type;
+}
+types[] =
+{
+	{ "Pin", T_PIN },					{ "Tunnel", T_TUNNEL },
+	{ "Splitter", T_SPLITTER },			{ "Constant", T_CONSTANT },
+	{ "Probe", T_PROBE },				{ "Clock", T_CLOCK },
+	{ "AND Gate", T_AND },				{ "OR Gate", T_OR },
+	{ "XOR Gate", T_XOR },				{ "NAND Gate", T_NAND },
+	{ "NOR Gate", T_NOR },				{ "XNOR Gate", T_XNOR },
+	{ "NOT Gate", T_NOT },				{ "Controlled Buffer", T_BUFFER },
+	{ "Multiplexer", T_MUX },			{ "Decoder", T_DECODER },
+	{ "Comparator", T_COMPARATOR },		{ "D Flip-Flop", T_DFF },
+	{ "J-K Flip-Flop", T_JKFF },		{ "Register", T_REGISTER },
+	{ "ROM", T_ROM },					{ "RAM", T_RAM },
+	{ "Button", T_BUTTON },				{ "LED", T_LED },
+	{ "TTY", T_TTY },					{ "Keyboard", T_KEYBOARD },
+	{ "Hex Digit Display", T_IGNORED },	{ "Text", T_IGNORED }
+};
+
+// what an unconnected port reads
+enum
+{
+	D_FLOAT, D_LOW, D_HIGH, D_DROP
+};
+
+typedef struct
+{
+	int			type;
+	int			sub;				// the circuit, for a T_SUB
+	uint32_t	name;				// in im->str until the circuits are known
+	int			x, y;
+	uint32_t	attr;				// pairs of offsets in im->str, in im->attr
+	uint32_t	attrs;
+	uint32_t	port;				// in im->port once placed
+	uint32_t	ports;
+} comp_t;
+
+typedef struct
+{
+	int			x0, y0, x1, y1;
+} wire_t;
+
+typedef struct
+{
+	int			x, y;
+	int			width;				// 0 takes the net's
+	int			dflt;
+	bool		absent;				// a port the component has without drawing it
+	int			point;
+	int32_t		bits;				// its classes in im->bits, -1 for none where it's
+									// unconnected
+} port_t;
+
+typedef struct
+{
+	uint32_t	name;
+	uint32_t	comp, comps;
+	uint32_t	wire, wires;
+	// the pins as an instance shows them: outputs down the east side and inputs down the
+	// west, each in order of where the pin is in the circuit, top to bottom
+	uint32_t	side;				// comp indices in im->side, east first
+	uint32_t	east, west;
+	bool		custom;				// has an appearance of its own, which isn't read
+	int			classes;
+	uint32_t	nodes;				// for an instance, with everything inside it
+	int			visiting;
+} circuit_t;
+
+typedef struct
+{
+	const char	*path;
+	netlist_t	*nl;
+
+	char		*str;
+	size_t		str_len, str_cap;
+	uint32_t	*attr;
+	size_t		attrs, attr_cap;
+	comp_t		*comp;
+	size_t		comps, comp_cap;
+	wire_t		*wire;
+	size_t		wires, wire_cap;
+	circuit_t	*circuit;
+	size_t		circuits, circuit_cap;
+	port_t		*port;
+	size_t		ports, port_cap;
+	int32_t		*bits;
+	size_t		nbits, bits_cap;
+	uint32_t	*side;
+	size_t		sides, side_cap;
+	char		lib_builtin[64];	// which of the file's libraries are Logisim's own
+	bool		gate_ignore;
+
+	// flattening
+	uint32_t	*up;				// union-find over the nodes
+	size_t		nodes, up_cap;
+	uint32_t	*named;				// node, name, depth triples
+	size_t		nnamed, named_cap;
+	size_t		pins_cap, elements_cap, words_cap, names_cap;
+} import_t;
+
+static uint32_t str_add (import_t *im, const char *s)
+{
+	size_t len = strlen (s) + 1;
+	im->str = grow (im->str, im->str_len + len, &im->str_cap, 1);
+	memcpy (im->str + im->str_len, s, len);
+	im->str_len += len;
+	return (uint32_t) (im->str_len - len);
+}
+
+static const char *attr (const import_t *im, const comp_t *c, const char *key)
+{
+	for (uint32_t i = 0; i < c->attrs; i++)
+	{
+		const uint32_t *a = &im->attr[2 * (c->attr + i)];
+		if (strcmp (im->str + a[0], key) == 0)
+		{
+			return im->str + a[1];
+		}
+	}
+	return NULL;
+}
+
+static int attr_int (const import_t *im, const comp_t *c, const char *key, int dflt)
+{
+	const char *v = attr (im, c, key);
+	return (v != NULL) ? (int) strtol (v, NULL, 0) : dflt;
+}
+
+static bool attr_is (const import_t *im, const comp_t *c, const char *key, const char *val, bool dflt)
+{
+	const char *v = attr (im, c, key);
+	return (v != NULL) ? (strcmp (v, val) == 0) : dflt;
+}
+
+static bool read_point (const char *s, int *x, int *y)
+{
+	return (s != NULL) && (sscanf (s, "(%d,%d)", x, y) == 2);
+}
+
+static bool parse (import_t *im, FILE *f, char **main_name)
+{
+	xml_t *x = calloc (1, sizeof (xml_t));
+	x->f = f;
+	x->back = EOF;
+	x->line = 1;
+
+	circuit_t *c = NULL;
+	comp_t *comp = NULL;
+	int depth = 0;
+	int comp_depth = 0;
+	int options_depth = 0;
+	size_t text_attr = 0;			// an <a> in a comp whose value is its text
+	bool ok = true;
+	int t;
+
+	while (ok && ((t = xml_next (x)) != X_END))
+	{
+		const char *tag = x->text;
+		if (t == X_ERROR)
+		{
+			fprintf (stderr, "%s:%d: bad XML\n", im->path, x->line);
+			ok = false;
+		}
+		else if (t == X_TEXT)
+		{
+			if (text_attr != 0)
+			{
+				im->attr[2 * text_attr - 1] = str_add (im, x->text);
+			}
+		}
+		else if (t == X_CLOSE)
+		{
+			text_attr = 0;
+			depth--;
+			if (depth < comp_depth)
+			{
+				comp = NULL;
+				comp_depth = 0;
+			}
+			if (depth < options_depth)
+			{
+				options_depth = 0;
+			}
+			if (strcmp (tag, "circuit") == 0)
+			{
+				c = NULL;
+			}
+		}
+		else
+		{
+			depth++;
+			if (strcmp (tag, "lib") == 0)
+			{
+				const char *desc = xml_attr (x, "desc");
+				int n = atoi (xml_attr (x, "name") ? xml_attr (x, "name") : "-1");
+				if ((n >= 0) && (n < (int) sizeof (im->lib_builtin)))
+				{
+					im->lib_builtin[n] = (desc != NULL) && (desc[0] == '#');
+				}
+			}
+			else if (strcmp (tag, "main") == 0)
+			{
+				free (*main_name);
+				*main_name = strdup (xml_attr (x, "name") ? xml_attr (x, "name") : "");
+			}
+			else if (strcmp (tag, "options") == 0)
+			{
+				options_depth = depth;
+			}
+			else if (strcmp (tag, "circuit") == 0)
+			{
+				circuit_t nc = { 0 };
+				nc.name = str_add (im, xml_attr (x, "name") ? xml_attr (x, "name") : "");
+				nc.comp = im->comps;
+				nc.wire = im->wires;
+				PUSH (im->circuit, im->circuits, im->circuit_cap, nc);
+				c = &im->circuit[im->circuits - 1];
+			}
+			else if ((c != NULL) && (strcmp (tag, "appear") == 0))
+			{
+				c->custom = true;
+			}
+			else if ((c != NULL) && (strcmp (tag, "wire") == 0))
+			{
+				wire_t w;
+				if (!read_point (xml_attr (x, "from"), &w.x0, &w.y0) || !read_point (xml_attr (x, "to"), &w.x1, &w.y1))
+				{
+					fprintf (stderr, "%s:%d: bad wire\n", im->path, x->line);
+					ok = false;
+				}
+				PUSH (im->wire, im->wires, im->wire_cap, w);
+				c->wires++;
+			}
+			else if ((c != NULL) && (strcmp (tag, "comp") == 0))
+			{
+				comp_t nc = { 0 };
+				const char *name = xml_attr (x, "name") ? xml_attr (x, "name") : "";
+				const char *lib = xml_attr (x, "lib");
+				nc.attr = (uint32_t) im->attrs / 2;
+				if (!read_point (xml_attr (x, "loc"), &nc.x, &nc.y))
+				{
+					fprintf (stderr, "%s:%d: bad component location\n", im->path, x->line);
+					ok = false;
+				}
+				if (lib == NULL)
+				{
+					nc.type = T_SUB;
+					nc.name = str_add (im, name);
+				}
+				else
+				{
+					int n = atoi (lib);
+					nc.type = -1;
+					for (size_t i = 0; i < sizeof (types) / sizeof (types[0]); i++)
+					{
+						if (strcmp (types[i].name, name) == 0)
+						{
+							nc.type = types[i].type;
+						}
+					}
+					if ((nc.type < 0) || (n < 0) || (n >= (int) sizeof (im->lib_builtin)) || !im->lib_builtin[n])
+					{
+						fprintf (stderr, "%s:%d: Can't import %s components\n", im->path, x->line, name);
+						ok = false;
+					}
+				}
+				PUSH (im->comp, im->comps, im->comp_cap, nc);
+				c->comps++;
+				comp = &im->comp[im->comps - 1];
+				comp_depth = depth;
+			}
+			else if ((strcmp (tag, "a") == 0) && ((comp != NULL) || options_depth))
+			{
+				const char *key = xml_attr (x, "name") ? xml_attr (x, "name") : "";
+				const char *val = xml_attr (x, "val");
+				if (comp != NULL)
+				{
+					PUSH (im->attr, im->attrs, im->attr_cap, str_add (im, key));
+					PUSH (im->attr, im->attrs, im->attr_cap, str_add (im, val ? val : ""));
+					comp->attrs++;
+					text_attr = (val == NULL) ? im->attrs / 2 : 0;
+				}
+				else if (strcmp (key, "gateUndefined") == 0)
+				{
+					im->gate_ignore = (val != NULL) && (strcmp (val, "ignore") == 0);
+				}
+			}
+		}
+	}
+
+	free (x->text);
+	free (x);
+	return ok;
+}
+
+// ---- where the ports are
+
+static void rotate (const char *facing, int *dx, int *dy)
+{
+	int x = *dx;
+	int y = *dy;
+
+	if (facing == NULL)
+	{
+		return;
+	}
+	if (strcmp (facing, "west") == 0)
+	{
+		*dx = -x;
+		*dy = -y;
+	}
+	else if (strcmp (facing, "north") == 0)
+	{
+		*dx = y;
+		*dy = -x;
+	}
+	else if (strcmp (facing, "south") == 0)
+	{
+		*dx = -y;
+		*dy = x;
+	}
+}
+
+// a port at dx, dy from the component's location as it is drawn facing east
+static void port (import_t *im, comp_t *c, int dx, int dy, int width, int dflt)
+{
+	port_t p = { 0 };
+
+	rotate (attr (im, c, "facing"), &dx, &dy);
+	p.x = c->x + dx;
+	p.y = c->y + dy;
+	p.width = width;
+	p.dflt = dflt;
+	PUSH (im->port, im->ports, im->port_cap, p);
+	c->ports++;
+}
+
+// the same where the facing has already been dealt with
+static void port_at (import_t *im, comp_t *c, int dx, int dy, int width, int dflt)
+{
+	port_t p = { 0 };
+
+	p.x = c->x + dx;
+	p.y = c->y + dy;
+	p.width = width;
+	p.dflt = dflt;
+	PUSH (im->port, im->ports, im->port_cap, p);
+	c->ports++;
+}
+
+static void port_absent (import_t *im, comp_t *c, int width, int dflt)
+{
+	port_t p = { 0 };
+
+	p.width = width;
+	p.dflt = dflt;
+	p.absent = true;
+	PUSH (im->port, im->ports, im->port_cap, p);
+	c->ports++;
+}
+
+static int splitter_end (const import_t *im, const comp_t *c, int bit, int fanout, int incoming)
+{
+	char key[24];
+	snprintf (key, sizeof (key), "bit%d", bit);
+	const char *v = attr (im, c, key);
+	if (v != NULL)
+	{
+		return (strcmp (v, "none") == 0) ? -1 : atoi (v);
+	}
+
+	// Logisim's default spreads the bits evenly, the first ends getting any extra
+	int end = 0;
+	int per = incoming / fanout;
+	int extra = incoming % fanout;
+	for (int b = 0, left = per + (extra > 0); b < bit; b++)
+	{
+		if (--left == 0)
+		{
+			end++;
+			left = per + (end < extra);
+		}
+	}
+	return end;
+}
+
+static bool place (import_t *im, const circuit_t *circuit, comp_t *c)
+{
+	const char *facing = attr (im, c, "facing");
+	int w = attr_int (im, c, "width", 1);
+	int size = attr_int (im, c, "size", (c->type == T_NOT) ? 30 : 50);
+
+	c->port = (uint32_t) im->ports;
+	c->ports = 0;
+	switch (c->type)
+	{
+		case T_PIN:
+		case T_TUNNEL:
+		case T_CONSTANT:
+			port (im, c, 0, 0, w, D_FLOAT);
+			break;
+
+		case T_PROBE:
+			port (im, c, 0, 0, 0, D_FLOAT);
+			break;
+
+		case T_CLOCK:
+		case T_BUTTON:
+		case T_LED:
+			port (im, c, 0, 0, 1, D_FLOAT);
+			break;
+
+		case T_SPLITTER:
+		{
+			int fanout = attr_int (im, c, "fanout", 2);
+			int incoming = attr_int (im, c, "incoming", 2);
+			const char *appear = attr (im, c, "appear");
+			int j = ((appear == NULL) || (strcmp (appear, "left") == 0)) ? -1 : (strcmp (appear, "right") == 0) ? 1 : 0;
+			int x0, y0, stepx, stepy;
+			if ((facing != NULL) && ((strcmp (facing, "north") == 0) || (strcmp (facing, "south") == 0)))
+			{
+				int m = (strcmp (facing, "north") == 0) ? 1 : -1;
+				x0 = (j == 0) ? 10 * ((fanout + 1) / 2 - 1) : (m * j < 0) ? -10 : 10 + 10 * (fanout - 1);
+				y0 = -m * 20;
+				stepx = -10;
+				stepy = 0;
+			}
+			else
+			{
+				int m = ((facing != NULL) && (strcmp (facing, "west") == 0)) ? -1 : 1;
+				x0 = m * 20;
+				y0 = (j == 0) ? -10 * (fanout / 2) : (m * j > 0) ? 10 : -(10 + 10 * (fanout - 1));
+				stepx = 0;
+				stepy = 10;
+			}
+			port_at (im, c, 0, 0, incoming, D_FLOAT);
+			for (int i = 0; i < fanout; i++)
+			{
+				int n = 0;
+				for (int b = 0; b < incoming; b++)
+				{
+					n += (splitter_end (im, c, b, fanout, incoming) == i);
+				}
+				port_at (im, c, x0 + i * stepx, y0 + i * stepy, n, D_FLOAT);
+			}
+			break;
+		}
+
+		case T_AND:
+		case T_OR:
+		case T_XOR:
+		case T_NAND:
+		case T_NOR:
+		case T_XNOR:
+		{
+			int n = attr_int (im, c, "inputs", 2);
+			int bonus = ((c->type == T_XOR) || (c->type == T_XNOR)) ? 10 : 0;
+			int negated = ((c->type == T_NAND) || (c->type == T_NOR) || (c->type == T_XNOR)) ? 10 : 0;
+			int first, step, gap;
+			if ((size < 40) || (n > 3))
+			{
+				first = -5;
+				step = 10;
+				gap = 10;
+			}
+			else if ((size < 60) || (n <= 2))
+			{
+				first = -10;
+				step = 20;
+				gap = 20;
+			}
+			else
+			{
+				first = -15;
+				step = (n == 2) ? 30 : 15;
+				gap = 10;
+			}
+			for (int i = 0; i < n; i++)
+			{
+				char key[24];
+				snprintf (key, sizeof (key), "negate%d", i);
+				int dx = size + bonus + negated + (attr_is (im, c, key, "true", false) ? 10 : 0);
+				int dy = (n & 1) ? first * (n - 1) + step * i : first * n + step * i + ((i >= n / 2) ? gap : 0);
+				port (im, c, -dx, dy, w, D_DROP);
+			}
+			port (im, c, 0, 0, w, D_FLOAT);
+			break;
+		}
+
+		case T_NOT:
+			port (im, c, -size, 0, w, D_FLOAT);
+			port (im, c, 0, 0, w, D_FLOAT);
+			break;
+
+		case T_BUFFER:
+			port (im, c, -20, 0, w, D_FLOAT);
+			port (im, c, -10, attr_is (im, c, "control", "left", false) ? -10 : 10, 1, D_FLOAT);
+			port (im, c, 0, 0, w, D_FLOAT);
+			break;
+
+		case T_MUX:
+		{
+			int s = attr_int (im, c, "select", 1);
+			int n = 1 << s;
+			bool narrow = (attr_int (im, c, "size", 30) == 20);
+			int sx, sy;
+			if (attr_is (im, c, "enable", "true", false))
+			{
+				break;
+			}
+			for (int i = 0; i < n; i++)
+			{
+				if (n == 2)
+				{
+					port (im, c, narrow ? -20 : -30, -10 + 20 * i, w, D_FLOAT);
+				}
+				else
+				{
+					port (im, c, -40, -10 * (n / 2) + 10 * i, w, D_FLOAT);
+				}
+			}
+			// the select stays on the bottom or left side whichever way the mux faces
+			sx = ((n == 2) && narrow) ? -10 : -20;
+			sy = (n == 2) ? 20 : 10 * (n / 2);
+			if ((facing == NULL) || (strcmp (facing, "east") == 0))
+			{
+				port_at (im, c, sx, sy, s, D_FLOAT);
+			}
+			else if (strcmp (facing, "west") == 0)
+			{
+				port_at (im, c, -sx, sy, s, D_FLOAT);
+			}
+			else
+			{
+				port_at (im, c, -(sy + 10), (strcmp (facing, "north") == 0) ? -sx : sx, s, D_FLOAT);
+			}
+			port (im, c, 0, 0, w, D_FLOAT);
+			break;
+		}
+
+		case T_DECODER:
+		{
+			int s = attr_int (im, c, "select", 1);
+			port (im, c, 0, 0, s, D_FLOAT);
+			if (attr_is (im, c, "enable", "true", true))
+			{
+				port (im, c, -10, 0, 1, D_HIGH);
+			}
+			else
+			{
+				port_absent (im, c, 1, D_HIGH);
+			}
+			for (int i = 0; i < (1 << s); i++)
+			{
+				port (im, c, 20, -10 * ((1 << s) - i), 1, D_FLOAT);
+			}
+			break;
+		}
+
+		case T_COMPARATOR:
+			w = attr_int (im, c, "width", 8);
+			port (im, c, -40, -10, w, D_FLOAT);
+			port (im, c, -40, 10, w, D_FLOAT);
+			port (im, c, 0, -10, 1, D_FLOAT);
+			port (im, c, 0, 0, 1, D_FLOAT);
+			port (im, c, 0, 10, 1, D_FLOAT);
+			break;
+
+		case T_DFF:
+			port (im, c, -10, 10, 1, D_FLOAT);
+			port (im, c, -10, 50, 1, D_FLOAT);
+			port (im, c, 20, 0, 1, D_LOW);
+			port (im, c, 20, 60, 1, D_LOW);
+			port (im, c, 50, 10, 1, D_FLOAT);
+			port (im, c, 50, 50, 1, D_FLOAT);
+			break;
+
+		case T_JKFF:
+			port (im, c, -10, 10, 1, D_FLOAT);
+			port (im, c, -10, 30, 1, D_FLOAT);
+			port (im, c, -10, 50, 1, D_FLOAT);
+			port (im, c, 20, 0, 1, D_LOW);
+			port (im, c, 20, 60, 1, D_LOW);
+			port (im, c, 50, 10, 1, D_FLOAT);
+			port (im, c, 50, 50, 1, D_FLOAT);
+			break;
+
+		case T_REGISTER:
+			w = attr_int (im, c, "width", 8);
+			port (im, c, 0, 30, w, D_FLOAT);
+			port (im, c, 0, 50, 1, D_HIGH);
+			port (im, c, 0, 70, 1, D_FLOAT);
+			port (im, c, 30, 90, 1, D_LOW);
+			port (im, c, 60, 30, w, D_FLOAT);
+			break;
+
+		case T_ROM:
+			port (im, c, 0, 10, attr_int (im, c, "addrWidth", 8), D_FLOAT);
+			port (im, c, 240, 60, attr_int (im, c, "dataWidth", 8), D_FLOAT);
+			break;
+
+		case T_RAM:
+			if (!attr_is (im, c, "databus", "bidir", false))
+			{
+				break;
+			}
+			port (im, c, 0, 10, attr_int (im, c, "addrWidth", 8), D_FLOAT);
+			port (im, c, 0, 50, 1, D_LOW);
+			port (im, c, 0, 60, 1, D_LOW);
+			port (im, c, 0, 70, 1, D_FLOAT);
+			port (im, c, 250, 90, attr_int (im, c, "dataWidth", 8), D_FLOAT);
+			break;
+
+		case T_TTY:
+			port (im, c, 0, -10, 7, D_FLOAT);
+			port (im, c, 0, 0, 1, D_FLOAT);
+			port (im, c, 10, 10, 1, D_HIGH);
+			port (im, c, 20, 10, 1, D_LOW);
+			break;
+
+		case T_KEYBOARD:
+			port (im, c, 0, 0, 1, D_FLOAT);
+			port (im, c, 10, 10, 1, D_HIGH);
+			port (im, c, 20, 10, 1, D_LOW);
+			port (im, c, 130, 10, 1, D_FLOAT);
+			port (im, c, 140, 10, 7, D_FLOAT);
+			break;
+
+		case T_SUB:
+		{
+			const circuit_t *sub = &im->circuit[c->sub];
+			if (sub->custom || ((facing != NULL) && (strcmp (facing, "east") != 0)))
+			{
+				fprintf (stderr, "%s: Can't import the instance of %s at (%d,%d) in %s as it's drawn\n",
+					im->path, im->str + sub->name, c->x, c->y, im->str + circuit->name);
+				return false;
+			}
+			// fixed size boxes, anchored at the first output
+			for (uint32_t i = 0; i < sub->east + sub->west; i++)
+			{
+				const comp_t *pin = &im->comp[im->side[sub->side + i]];
+				int row = (i < sub->east) ? (int) i : (int) (i - sub->east);
+				int dx = ((i < sub->east) || (sub->east == 0)) ? 0 : -220;
+				port_at (im, c, dx, 20 * row, attr_int (im, pin, "width", 1), D_FLOAT);
+			}
+			break;
+		}
+
+		default:
+			break;
+	}
+
+	if (((c->type == T_MUX) || (c->type == T_RAM)) && (c->ports == 0))
+	{
+		fprintf (stderr, "%s: Can't import the %s at (%d,%d) in %s with its options\n", im->path,
+			(c->type == T_MUX) ? "Multiplexer" : "RAM", c->x, c->y, im->str + circuit->name);
+		return false;
+	}
+	return true;
+}
+
+// ---- wiring up a circuit
+
+typedef struct
+{
+	int			x, y;
+} point_t;
+
+static int point_cmp_xy (const void *a, const void *b)
+{
+	const point_t *p = a;
+	const point_t *q = b;
+	return (p->x != q->x) ? ((p->x > q->x) - (p->x < q->x)) : ((p->y > q->y) - (p->y < q->y));
+}
+
+static int point_cmp_yx (const void *a, const void *b)
+{
+	const point_t *p = a;
+	const point_t *q = b;
+	return (p->y != q->y) ? ((p->y > q->y) - (p->y < q->y)) : ((p->x > q->x) - (p->x < q->x));
+}
+
+// the first point not before x, y, in points sorted by cmp
+static int point_find (const point_t *pts, int n, int x, int y, int (*cmp) (const void *, const void *))
+{
+	point_t key = { x, y };
+	int lo = 0;
+	int hi = n;
+
+	while (lo < hi)
+	{
+		int mid = (lo + hi) / 2;
+		if (cmp (&pts[mid], &key) < 0)
+		{
+			lo = mid + 1;
+		}
+		else
+		{
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+static uint32_t find (uint32_t *up, uint32_t i)
+{
+	while (up[i] != i)
+	{
+		up[i] = up[up[i]];
+		i = up[i];
+	}
+	return i;
+}
+
+// the lower node stays the root, so the constants stay 0 and 1
+static void join (uint32_t *up, uint32_t a, uint32_t b)
+{
+	a = find (up, a);
+	b = find (up, b);
+	if (a < b)
+	{
+		up[b] = a;
+	}
+	else
+	{
+		up[a] = b;
+	}
+}
+
+static bool wire_up (import_t *im, circuit_t *circuit)
+{
+	const char *cname = im->str + circuit->name;
+	const wire_t *wires = &im->wire[circuit->wire];
+	bool ok = true;
+
+	for (uint32_t i = 0; i < circuit->comps; i++)
+	{
+		ok &= place (im, circuit, &im->comp[circuit->comp + i]);
+	}
+	if (!ok)
+	{
+		return false;
+	}
+	uint32_t first_port = im->comp[circuit->comp].port;
+	uint32_t nports = (uint32_t) im->ports - first_port;
+	port_t *ports = &im->port[first_port];
+	if (circuit->comps == 0)
+	{
+		first_port = (uint32_t) im->ports;
+		nports = 0;
+		ports = NULL;
+	}
+
+	// every point anything is at, sorted and once each
+	int n = 0;
+	point_t *pts = malloc ((2 * circuit->wires + nports + 1) * sizeof (point_t));
+	for (uint32_t i = 0; i < circuit->wires; i++)
+	{
+		pts[n++] = (point_t) { wires[i].x0, wires[i].y0 };
+		pts[n++] = (point_t) { wires[i].x1, wires[i].y1 };
+	}
+	for (uint32_t i = 0; i < nports; i++)
+	{
+		if (!ports[i].absent)
+		{
+			pts[n++] = (point_t) { ports[i].x, ports[i].y };
+		}
+	}
+	qsort (pts, n, sizeof (point_t), point_cmp_xy);
+	int npts = 0;
+	for (int i = 0; i < n; i++)
+	{
+		if ((npts == 0) || (point_cmp_xy (&pts[npts - 1], &pts[i]) != 0))
+		{
+			pts[npts++] = pts[i];
+		}
+	}
+	point_t *by_y = malloc ((npts + 1) * sizeof (point_t));
+	memcpy (by_y, pts, npts * sizeof (point_t));
+	qsort (by_y, npts, sizeof (point_t), point_cmp_yx);
+
+	uint32_t *up = malloc ((npts + 1) * sizeof (uint32_t));
+	int *uses = calloc (npts + 1, sizeof (int));
+	int *width = calloc (npts + 1, sizeof (int));
+	int *where = malloc ((npts + 1) * sizeof (int));	// a port on the net, for messages
+	for (int i = 0; i < npts; i++)
+	{
+		up[i] = i;
+		where[i] = -1;
+	}
+
+	for (uint32_t i = 0; i < circuit->wires; i++)
+	{
+		const wire_t *w = &wires[i];
+		int a = point_find (pts, npts, w->x0, w->y0, point_cmp_xy);
+		int b = point_find (pts, npts, w->x1, w->y1, point_cmp_xy);
+		join (up, a, b);
+		uses[a]++;
+		uses[b]++;
+
+		// whatever is on the wire between its ends is connected to it as well
+		if (w->x0 == w->x1)
+		{
+			int y0 = (w->y0 < w->y1) ? w->y0 : w->y1;
+			int y1 = (w->y0 < w->y1) ? w->y1 : w->y0;
+			for (int p = point_find (pts, npts, w->x0, y0 + 1, point_cmp_xy); (p < npts) && (pts[p].x == w->x0) && (pts[p].y < y1); p++)
+			{
+				join (up, a, p);
+				uses[p]++;
+			}
+		}
+		else if (w->y0 == w->y1)
+		{
+			int x0 = (w->x0 < w->x1) ? w->x0 : w->x1;
+			int x1 = (w->x0 < w->x1) ? w->x1 : w->x0;
+			for (int p = point_find (by_y, npts, x0 + 1, w->y0, point_cmp_yx); (p < npts) && (by_y[p].y == w->y0) && (by_y[p].x < x1); p++)
+			{
+				int q = point_find (pts, npts, by_y[p].x, by_y[p].y, point_cmp_xy);
+				join (up, a, q);
+				uses[q]++;
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < nports; i++)
+	{
+		if (!ports[i].absent)
+		{
+			ports[i].point = point_find (pts, npts, ports[i].x, ports[i].y, point_cmp_xy);
+			uses[ports[i].point]++;
+		}
+	}
+
+	// tunnels with the same label are the same net
+	for (uint32_t i = 0; i < circuit->comps; i++)
+	{
+		const comp_t *t = &im->comp[circuit->comp + i];
+		const char *label = attr (im, t, "label");
+		if ((t->type != T_TUNNEL) || (label == NULL))
+		{
+			continue;
+		}
+		for (uint32_t j = 0; j < i; j++)
+		{
+			const comp_t *u = &im->comp[circuit->comp + j];
+			if ((u->type == T_TUNNEL) && attr_is (im, u, "label", label, false))
+			{
+				join (up, im->port[t->port].point, im->port[u->port].point);
+				break;
+			}
+		}
+	}
+
+	// the nets' widths, and which ports are on a net by themselves
+	for (int i = 0; i < npts; i++)
+	{
+		uint32_t r = find (up, i);
+		if (r != (uint32_t) i)
+		{
+			uses[r] += uses[i];
+		}
+	}
+	for (uint32_t i = 0; ok && (i < nports); i++)
+	{
+		port_t *p = &ports[i];
+		if (p->absent || (p->width == 0))
+		{
+			continue;
+		}
+		uint32_t r = find (up, p->point);
+		if (width[r] == 0)
+		{
+			width[r] = p->width;
+			where[r] = i;
+		}
+		else if (width[r] != p->width)
+		{
+			const port_t *q = &ports[where[r]];
+			fprintf (stderr, "%s: a %d bit port at (%d,%d) and a %d bit one at (%d,%d) are connected in %s\n",
+				im->path, q->width, q->x, q->y, p->width, p->x, p->y, cname);
+			ok = false;
+		}
+	}
+
+	// the bits of the nets, after the two constants
+	int *base = malloc ((npts + 1) * sizeof (int));
+	uint32_t bits = 2;
+	for (int i = 0; i < npts; i++)
+	{
+		if (find (up, i) == (uint32_t) i)
+		{
+			base[i] = bits;
+			bits += width[i];
+		}
+	}
+	uint32_t *bit_up = malloc (bits * sizeof (uint32_t));
+	for (uint32_t i = 0; i < bits; i++)
+	{
+		bit_up[i] = i;
+	}
+	#define BIT(p, b)	(base[find (up, (p)->point)] + (b))
+
+	for (uint32_t i = 0; ok && (i < circuit->comps); i++)
+	{
+		const comp_t *c = &im->comp[circuit->comp + i];
+		const port_t *p = &im->port[c->port];
+		if (c->type == T_SPLITTER)
+		{
+			int fanout = (int) c->ports - 1;
+			int incoming = p[0].width;
+			int at[fanout];
+			memset (at, 0, sizeof (at));
+			for (int b = 0; b < incoming; b++)
+			{
+				int end = splitter_end (im, c, b, fanout, incoming);
+				if ((end >= 0) && (end < fanout))
+				{
+					join (bit_up, BIT (&p[0], b), BIT (&p[1 + end], at[end]));
+					at[end]++;
+				}
+			}
+		}
+		else if (c->type == T_CONSTANT)
+		{
+			unsigned long v = strtoul (attr (im, c, "value") ? attr (im, c, "value") : "1", NULL, 0);
+			for (int b = 0; b < p->width; b++)
+			{
+				join (bit_up, BIT (p, b), (b < 32) ? (v >> b) & 1 : 0);
+			}
+		}
+	}
+
+	// the classes, and each port's
+	int32_t *cls = malloc (bits * sizeof (int32_t));
+	circuit->classes = 2;
+	for (uint32_t i = 0; i < bits; i++)
+	{
+		uint32_t r = find (bit_up, i);
+		cls[i] = (r < 2) ? (int32_t) r : (r == i) ? circuit->classes++ : cls[r];
+	}
+	for (uint32_t i = 0; ok && (i < nports); i++)
+	{
+		port_t *p = &ports[i];
+		p->bits = -1;
+		if (p->absent || (uses[find (up, p->point)] < 2))
+		{
+			continue;
+		}
+		int w = width[find (up, p->point)];
+		p->bits = (int32_t) im->nbits;
+		im->bits = grow (im->bits, im->nbits + w, &im->bits_cap, sizeof (int32_t));
+		for (int b = 0; b < w; b++)
+		{
+			im->bits[im->nbits++] = cls[BIT (p, b)];
+		}
+		if (p->width == 0)
+		{
+			p->width = w;
+		}
+	}
+	#undef BIT
+
+	free (cls);
+	free (bit_up);
+	free (base);
+	free (where);
+	free (width);
+	free (uses);
+	free (up);
+	free (by_y);
+	free (pts);
+	return ok;
+}
+
+// ---- flattening
+
+static uint32_t nodes_new (import_t *im, uint32_t n)
+{
+	uint32_t first = (uint32_t) im->nodes;
+	im->up = grow (im->up, im->nodes + n, &im->up_cap, sizeof (uint32_t));
+	for (uint32_t i = 0; i < n; i++, im->nodes++)
+	{
+		im->up[im->nodes] = (uint32_t) im->nodes;
+	}
+	return first;
+}
+
+static uint32_t name_add (import_t *im, const char *s)
+{
+	netlist_t *nl = im->nl;
+	size_t len = strlen (s) + 1;
+	nl->names = grow (nl->names, nl->names_len + len, &im->names_cap, 1);
+	memcpy (nl->names + nl->names_len, s, len);
+	nl->names_len += len;
+	return nl->names_len - len;
+}
+
+static nl_element_t *element_new (import_t *im, int kind, int flags, int width, const comp_t *c, uint32_t name)
+{
+	netlist_t *nl = im->nl;
+	nl->element = grow (nl->element, nl->elements + 1, &im->elements_cap, sizeof (nl_element_t));
+	nl_element_t *e = &nl->element[nl->elements++];
+	memset (e, 0, sizeof (*e));
+	e->kind = kind;
+	e->flags = flags;
+	e->width = width;
+	e->pin = nl->npins;
+	e->name = name;
+	e->x = c->x;
+	e->y = c->y;
+	return e;
+}
+
+static void pin_add (import_t *im, uint32_t node)
+{
+	netlist_t *nl = im->nl;
+	nl->pins = grow (nl->pins, nl->npins + 1, &im->pins_cap, sizeof (uint32_t));
+	nl->pins[nl->npins++] = node;
+}
+
+// the node for class cls of an instance whose classes start at base
+static uint32_t node_of (int32_t cls, uint32_t base)
+{
+	return (cls < 2) ? (uint32_t) cls : base + cls - 2;
+}
+
+// the node for bit b of a port, or for what it reads if it's unconnected
+static uint32_t port_bit (import_t *im, const port_t *p, int b, uint32_t base)
+{
+	if (p->bits >= 0)
+	{
+		return node_of (im->bits[p->bits + b], base);
+	}
+	switch (p->dflt)
+	{
+		case D_LOW:		return NL_LOW;
+		case D_HIGH:	return NL_HIGH;
+		default:		return nodes_new (im, 1);
+	}
+}
+
+static void port_add (import_t *im, const port_t *p, uint32_t base)
+{
+	for (int b = 0; b < p->width; b++)
+	{
+		pin_add (im, port_bit (im, p, b, base));
+	}
+}
+
+static void net_named (import_t *im, uint32_t node, uint32_t name, uint32_t depth)
+{
+	PUSH (im->named, im->nnamed, im->named_cap, node);
+	PUSH (im->named, im->nnamed, im->named_cap, name);
+	PUSH (im->named, im->nnamed, im->named_cap, depth);
+}
+
+// "addr/data: a d" and then v2.0 raw's values
+static void rom_load (import_t *im, nl_element_t *e, const char *contents)
+{
+	netlist_t *nl = im->nl;
+	uint32_t n = 1u << e->arg;
+
+	e->words = nl->nwords;
+	nl->words = grow (nl->words, nl->nwords + n, &im->words_cap, sizeof (uint32_t));
+	memset (&nl->words[nl->nwords], 0, n * sizeof (uint32_t));
+	if ((contents != NULL) && ((contents = strchr (contents, '\n')) != NULL))
+	{
+		uint32_t at = 0;
+		char *end;
+		while (at < n)
+		{
+			unsigned long count = 1;
+			unsigned long v = strtoul (contents, &end, 16);
+			if (end == contents)
+			{
+				break;
+			}
+			if (*end == '*')
+			{
+				count = strtoul (contents, NULL, 10);
+				contents = end + 1;
+				v = strtoul (contents, &end, 16);
+			}
+			contents = end;
+			for (unsigned long i = 0; (i < count) && (at < n); i++)
+			{
+				nl->words[nl->nwords + at++] = (uint32_t) v;
+			}
+		}
+	}
+	nl->nwords += n;
+}
+
+static void flatten (import_t *im, int ci, uint32_t base, const char *path, uint32_t depth)
+{
+	const circuit_t *circuit = &im->circuit[ci];
+	uint32_t path_name = name_add (im, path);
+
+	for (uint32_t i = 0; i < circuit->comps; i++)
+	{
+		const comp_t *c = &im->comp[circuit->comp + i];
+		const port_t *p = &im->port[c->port];
+		const char *label = attr (im, c, "label");
+		uint32_t name = path_name;
+		char buf[1024];
+
+		if ((label != NULL) && (label[0] != 0) && (c->type != T_SUB))
+		{
+			snprintf (buf, sizeof (buf), "%s%s%s", path, (path[0] != 0) ? "/" : "", label);
+			name = name_add (im, buf);
+
+			if ((c->type == T_PIN) || (c->type == T_TUNNEL))
+			{
+				for (int b = 0; (p->bits >= 0) && (b < p->width); b++)
+				{
+					uint32_t bit_name = name;
+					if (p->width > 1)
+					{
+						snprintf (buf, sizeof (buf), "%s%s%s[%d]", path, (path[0] != 0) ? "/" : "", label, b);
+						bit_name = name_add (im, buf);
+					}
+					net_named (im, port_bit (im, p, b, base), bit_name, depth);
+				}
+			}
+		}
+
+		switch (c->type)
+		{
+			case T_PIN:
+				if (depth == 0)
+				{
+					bool out = attr_is (im, c, "output", "true", false);
+					nl_element_t *e = element_new (im, out ? NL_OUTPUT : NL_INPUT, 0, p->width, c, name);
+					port_add (im, p, base);
+					e->ins = out ? p->width : 0;
+					e->outs = out ? 0 : p->width;
+				}
+				break;
+
+			case T_CLOCK:
+			case T_BUTTON:
+			{
+				nl_element_t *e = element_new (im, (c->type == T_CLOCK) ? NL_CLOCK : NL_INPUT, 0, 1, c, name);
+				port_add (im, p, base);
+				e->outs = 1;
+				break;
+			}
+
+			case T_AND:
+			case T_OR:
+			case T_XOR:
+			case T_NAND:
+			case T_NOR:
+			case T_XNOR:
+			{
+				static const int kind[] = { NL_AND, NL_OR, NL_XOR, NL_AND, NL_OR, NL_XOR };
+				int n = (int) c->ports - 1;
+				int t = c->type - T_AND;
+				for (int b = 0; b < p[n].width; b++)
+				{
+					uint32_t in[n];
+					int ins = 0;
+					for (int j = 0; j < n; j++)
+					{
+						char key[24];
+						if (p[j].bits < 0)
+						{
+							continue;
+						}
+						in[ins] = port_bit (im, &p[j], b, base);
+						snprintf (key, sizeof (key), "negate%d", j);
+						if (attr_is (im, c, key, "true", false))
+						{
+							nl_element_t *e = element_new (im, NL_NOT, 0, 1, c, name);
+							pin_add (im, in[ins]);
+							in[ins] = nodes_new (im, 1);
+							pin_add (im, in[ins]);
+							e->ins = 1;
+							e->outs = 1;
+						}
+						ins++;
+					}
+					if (ins == 0)
+					{
+						continue;
+					}
+					nl_element_t *e = element_new (im, kind[t], (t >= 3) ? NL_INVERT : 0, 1, c, name);
+					for (int j = 0; j < ins; j++)
+					{
+						pin_add (im, in[j]);
+					}
+					pin_add (im, port_bit (im, &p[n], b, base));
+					e->ins = ins;
+					e->outs = 1;
+				}
+				break;
+			}
+
+			case T_NOT:
+				for (int b = 0; b < p[1].width; b++)
+				{
+					nl_element_t *e = element_new (im, NL_NOT, 0, 1, c, name);
+					pin_add (im, port_bit (im, &p[0], b, base));
+					pin_add (im, port_bit (im, &p[1], b, base));
+					e->ins = 1;
+					e->outs = 1;
+				}
+				break;
+
+			case T_SUB:
+			{
+				const circuit_t *sub = &im->circuit[c->sub];
+				int same = 0;
+				int nth = 0;
+				for (uint32_t j = 0; j < circuit->comps; j++)
+				{
+					const comp_t *d = &im->comp[circuit->comp + j];
+					if ((d->type == T_SUB) && (d->sub == c->sub))
+					{
+						nth += (j < i);
+						same++;
+					}
+				}
+				if (same > 1)
+				{
+					snprintf (buf, sizeof (buf), "%s%s%s.%d", path, (path[0] != 0) ? "/" : "", im->str + sub->name, nth);
+				}
+				else
+				{
+					snprintf (buf, sizeof (buf), "%s%s%s", path, (path[0] != 0) ? "/" : "", im->str + sub->name);
+				}
+				uint32_t sub_base = nodes_new (im, sub->classes - 2);
+				flatten (im, c->sub, sub_base, buf, depth + 1);
+				for (uint32_t j = 0; j < c->ports; j++)
+				{
+					const comp_t *pin = &im->comp[im->side[sub->side + j]];
+					const port_t *inside = &im->port[pin->port];
+					if ((p[j].bits < 0) || (inside->bits < 0))
+					{
+						continue;
+					}
+					for (int b = 0; b < p[j].width; b++)
+					{
+						join (im->up, node_of (im->bits[p[j].bits + b], base), node_of (im->bits[inside->bits + b], sub_base));
+					}
+				}
+				break;
+			}
+
+			case T_SPLITTER:
+			case T_TUNNEL:
+			case T_CONSTANT:
+			case T_PROBE:
+			case T_LED:
+			case T_IGNORED:
+				break;
+
+			default:
+			{
+				// the elements that keep their buses, with ports in the order of their nets
+				static const struct
+				{
+					int		type;
+					int		kind;
+					int		ins;			// ports, and which one's width is the element's
+					int		wide;
+				}
+				whole[] =
+				{
+					{ T_BUFFER, NL_TRI, 2, 0 },			{ T_MUX, NL_MUX, -1, 0 },
+					{ T_DECODER, NL_DECODER, 2, -1 },	{ T_COMPARATOR, NL_COMPARE, 2, 0 },
+					{ T_DFF, NL_DFF, 4, 0 },			{ T_JKFF, NL_JKFF, 5, 0 },
+					{ T_REGISTER, NL_REG, 4, 0 },		{ T_ROM, NL_ROM, 1, 1 },
+					{ T_RAM, NL_RAM, 5, 4 },			{ T_TTY, NL_TTY, 4, 0 },
+					{ T_KEYBOARD, NL_KEYBOARD, 3, -1 }
+				};
+				int k = 0;
+				while (whole[k].type != c->type)
+				{
+					k++;
+				}
+				int ins = (whole[k].ins >= 0) ? whole[k].ins : (int) c->ports - 1;
+				int flags = 0;
+				if ((c->type == T_COMPARATOR) && !attr_is (im, c, "mode", "unsigned", false))
+				{
+					flags |= NL_SIGNED;
+				}
+				if (attr_is (im, c, "trigger", "falling", false))
+				{
+					flags |= NL_FALLING;
+				}
+				nl_element_t *e = element_new (im, whole[k].kind, flags,
+					(whole[k].wide >= 0) ? p[whole[k].wide].width : 1, c, name);
+				for (uint32_t j = 0; j < c->ports; j++)
+				{
+					port_add (im, &p[j], base);
+				}
+				for (int j = 0; j < ins; j++)
+				{
+					e->ins += p[j].width;
+				}
+				if (c->type == T_RAM)
+				{
+					// the bidirectional data bus is an output as well
+					port_add (im, &p[4], base);
+				}
+				e->outs = im->nl->npins - e->pin - e->ins;
+				if ((c->type == T_MUX) || (c->type == T_DECODER))
+				{
+					e->arg = p[(c->type == T_MUX) ? ins - 1 : 0].width;
+				}
+				else if ((c->type == T_ROM) || (c->type == T_RAM))
+				{
+					e->arg = p[0].width;
+				}
+				if (c->type == T_ROM)
+				{
+					rom_load (im, e, attr (im, c, "contents"));
+				}
+				break;
+			}
+		}
+	}
+}
+
+// how many nodes an instance of each circuit takes, which also finds any circuit that
+// contains itself
+static bool count_nodes (import_t *im, int ci)
+{
+	circuit_t *circuit = &im->circuit[ci];
+	if (circuit->visiting == 2)
+	{
+		return true;
+	}
+	if (circuit->visiting == 1)
+	{
+		fprintf (stderr, "%s: %s contains itself\n", im->path, im->str + circuit->name);
+		return false;
+	}
+	circuit->visiting = 1;
+	circuit->nodes = circuit->classes - 2;
+	for (uint32_t i = 0; i < circuit->comps; i++)
+	{
+		const comp_t *c = &im->comp[circuit->comp + i];
+		if (c->type == T_SUB)
+		{
+			if (!count_nodes (im, c->sub))
+			{
+				return false;
+			}
+			circuit->nodes += im->circuit[c->sub].nodes;
+		}
+	}
+	circuit->visiting = 2;
+	return true;
+}
+
+static import_t *side_im;
+
+static int pin_cmp (const void *a, const void *b)
+{
+	const comp_t *p = &side_im->comp[*(const uint32_t *) a];
+	const comp_t *q = &side_im->comp[*(const uint32_t *) b];
+	return (p->y != q->y) ? ((p->y > q->y) - (p->y < q->y)) : ((p->x > q->x) - (p->x < q->x));
+}
+
+static void import_free (import_t *im)
+{
+	free (im->str);
+	free (im->attr);
+	free (im->comp);
+	free (im->wire);
+	free (im->circuit);
+	free (im->port);
+	free (im->bits);
+	free (im->side);
+	free (im->up);
+	free (im->named);
+}
+
+bool nl_import (netlist_t *nl, const char *path, const char *top)
+{
+	import_t im = { 0 };
+	char *main_name = NULL;
+
+	memset (nl, 0, sizeof (*nl));
+	im.path = path;
+	im.nl = nl;
+	im.gate_ignore = true;
+
+	FILE *f = fopen (path, "r");
+	if (f == NULL)
+	{
+		fprintf (stderr, "Can't open %s\n", path);
+		return false;
+	}
+	bool ok = parse (&im, f, &main_name);
+	fclose (f);
+
+	// subcircuits by name, and the pins each shows on its sides
+	for (size_t i = 0; ok && (i < im.comps); i++)
+	{
+		comp_t *c = &im.comp[i];
+		if (c->type != T_SUB)
+		{
+			continue;
+		}
+		c->sub = -1;
+		for (size_t j = 0; j < im.circuits; j++)
+		{
+			if (strcmp (im.str + im.circuit[j].name, im.str + c->name) == 0)
+			{
+				c->sub = (int) j;
+			}
+		}
+		if (c->sub < 0)
+		{
+			fprintf (stderr, "%s: there is no circuit %s\n", path, im.str + c->name);
+			ok = false;
+		}
+	}
+	for (size_t i = 0; ok && (i < im.circuits); i++)
+	{
+		circuit_t *circuit = &im.circuit[i];
+		circuit->side = (uint32_t) im.sides;
+		for (int out = 1; out >= 0; out--)
+		{
+			uint32_t first = (uint32_t) im.sides;
+			for (uint32_t j = 0; j < circuit->comps; j++)
+			{
+				const comp_t *c = &im.comp[circuit->comp + j];
+				if ((c->type == T_PIN) && (attr_is (&im, c, "output", "true", false) == out))
+				{
+					PUSH (im.side, im.sides, im.side_cap, circuit->comp + j);
+				}
+			}
+			side_im = &im;
+			qsort (&im.side[first], im.sides - first, sizeof (uint32_t), pin_cmp);
+			*(out ? &circuit->east : &circuit->west) = (uint32_t) im.sides - first;
+		}
+	}
+	for (size_t i = 0; ok && (i < im.circuits); i++)
+	{
+		ok = wire_up (&im, &im.circuit[i]);
+	}
+
+	int ci = -1;
+	if (top == NULL)
+	{
+		top = (main_name != NULL) ? main_name : "";
+	}
+	for (size_t i = 0; ok && (i < im.circuits); i++)
+	{
+		if (strcmp (im.str + im.circuit[i].name, top) == 0)
+		{
+			ci = (int) i;
+		}
+	}
+	if (ok && (ci < 0))
+	{
+		fprintf (stderr, "%s: there is no circuit %s\n", path, top);
+		ok = false;
+	}
+	if (ok)
+	{
+		ok = count_nodes (&im, ci);
+	}
+
+	if (ok)
+	{
+		nl->top = strdup (top);
+		name_add (&im, "");
+		nodes_new (&im, 2);
+		im.up = grow (im.up, 2 + im.circuit[ci].nodes, &im.up_cap, sizeof (uint32_t));
+		uint32_t base = nodes_new (&im, im.circuit[ci].classes - 2);
+		flatten (&im, ci, base, "", 0);
+	}
+
+	// Logisim leaves out a gate input that nothing drives, with gateUndefined = ignore
+	uint32_t *driven = NULL;
+	if (ok && im.gate_ignore)
+	{
+		driven = calloc (im.nodes, sizeof (uint32_t));
+		driven[NL_LOW] = driven[NL_HIGH] = 1;
+		for (uint32_t i = 0; i < nl->elements; i++)
+		{
+			const nl_element_t *e = &nl->element[i];
+			for (uint32_t j = 0; j < e->outs; j++)
+			{
+				driven[find (im.up, nl->pins[e->pin + e->ins + j])] = 1;
+			}
+		}
+		uint32_t npins = 0;
+		uint32_t kept = 0;
+		for (uint32_t i = 0; i < nl->elements; i++)
+		{
+			nl_element_t e = nl->element[i];
+			uint32_t pin = npins;
+			uint32_t ins = 0;
+			bool gate = (e.kind == NL_AND) || (e.kind == NL_OR) || (e.kind == NL_XOR);
+			for (uint32_t j = 0; j < (uint32_t) e.ins + e.outs; j++)
+			{
+				uint32_t node = nl->pins[e.pin + j];
+				if ((j < e.ins) && gate && !driven[find (im.up, node)])
+				{
+					continue;
+				}
+				nl->pins[npins++] = node;
+				ins += (j < e.ins);
+			}
+			if (gate && (ins == 0))
+			{
+				npins = pin;
+				continue;
+			}
+			e.pin = pin;
+			e.ins = ins;
+			nl->element[kept++] = e;
+		}
+		nl->npins = npins;
+		nl->elements = kept;
+	}
+
+	// the nets, numbered as the elements come to them
+	if (ok)
+	{
+		uint32_t *net = malloc (im.nodes * sizeof (uint32_t));
+		memset (net, 0xff, im.nodes * sizeof (uint32_t));
+		if (find (im.up, NL_HIGH) == NL_LOW)
+		{
+			fprintf (stderr, "%s: 0 and 1 are connected\n", path);
+			ok = false;
+		}
+		net[NL_LOW] = NL_LOW;
+		net[NL_HIGH] = NL_HIGH;
+		nl->nets = 2;
+		for (uint32_t i = 0; i < nl->npins; i++)
+		{
+			uint32_t r = find (im.up, nl->pins[i]);
+			if (net[r] == UINT32_MAX)
+			{
+				net[r] = nl->nets++;
+			}
+			nl->pins[i] = net[r];
+		}
+
+		// each net is named after the pin or tunnel on it nearest the top
+		nl->net_name = calloc (nl->nets, sizeof (uint32_t));
+		uint32_t *depth = malloc (nl->nets * sizeof (uint32_t));
+		memset (depth, 0xff, nl->nets * sizeof (uint32_t));
+		for (size_t i = 0; i < im.nnamed; i += 3)
+		{
+			uint32_t n = net[find (im.up, im.named[i])];
+			if ((n != UINT32_MAX) && (n > NL_HIGH) && (im.named[i + 2] < depth[n]))
+			{
+				nl->net_name[n] = im.named[i + 1];
+				depth[n] = im.named[i + 2];
+			}
+		}
+		free (depth);
+		free (net);
+	}
+
+	free (driven);
+	free (main_name);
+	import_free (&im);
+	if (!ok)
+	{
+		nl_free (nl);
+	}
+	return ok;
+}
+
+void nl_free (netlist_t *nl)
+{
+	free (nl->top);
+	free (nl->net_name);
+	free (nl->element);
+	free (nl->pins);
+	free (nl->words);
+	free (nl->names);
+	memset (nl, 0, sizeof (*nl));
+}
+
+static bool tri_state (const nl_element_t *e)
+{
+	return (e->kind == NL_TRI) || (e->kind == NL_RAM);
+}
+
+int nl_check (const netlist_t *nl)
+{
+	uint32_t *drivers = calloc (nl->nets, sizeof (uint32_t));
+	uint32_t *others = calloc (nl->nets, sizeof (uint32_t));	// not through a TRI or RAM
+	uint8_t *read = calloc (nl->nets, 1);
+	int problems = 0;
+
+	for (uint32_t i = 0; i < nl->elements; i++)
+	{
+		const nl_element_t *e = &nl->element[i];
+		const uint32_t *in = nl_in (nl, e);
+		const uint32_t *out = nl_out (nl, e);
+		for (uint32_t j = 0; j < e->ins; j++)
+		{
+			read[in[j]] = 1;
+		}
+		for (uint32_t j = 0; j < e->outs; j++)
+		{
+			drivers[out[j]]++;
+			others[out[j]] += !tri_state (e);
+		}
+	}
+	for (uint32_t n = 2; n < nl->nets; n++)
+	{
+		const char *name = nl->names + nl->net_name[n];
+		if ((drivers[n] > 1) && (others[n] > 0))
+		{
+			fprintf (stderr, "net %u%s%s%s has %u drivers\n", n, name[0] ? " (" : "", name, name[0] ? ")" : "", drivers[n]);
+			problems++;
+		}
+		if (read[n] && (drivers[n] == 0))
+		{
+			fprintf (stderr, "net %u%s%s%s is read and not driven\n", n, name[0] ? " (" : "", name, name[0] ? ")" : "");
+			problems++;
+		}
+	}
+	free (read);
+	free (others);
+	free (drivers);
+	return problems;
+}
+
+int nl_clock (const nl_element_t *e)
+{
+	switch (e->kind)
+	{
+		case NL_DFF:		return 1;
+		case NL_JKFF:		return 2;
+		case NL_REG:		return e->width + 1;
+		case NL_RAM:		return e->arg + 2;
+		case NL_TTY:		return 7;
+		case NL_KEYBOARD:	return 0;
+		default:			return -1;
+	}
+}
+
+bool nl_follows (const nl_element_t *e, uint32_t j)
+{
+	switch (e->kind)
+	{
+		case NL_DFF:		return j >= 2;
+		case NL_JKFF:		return j >= 3;
+		case NL_REG:		return j == e->ins - 1u;
+		case NL_RAM:		return (j < e->arg) || (j == e->arg + 1);
+		case NL_TTY:
+		case NL_KEYBOARD:
+		case NL_OUTPUT:		return false;
+		default:			return true;
+	}
+}
+
+// the net to break a loop at when every element left is waiting: one of the nets they
+// wait for, a bus if there is one, as a TRI or a RAM is the likeliest to be switched off
+// on one side of the loop whenever it is on at the other
+static uint32_t loop_cut (const netlist_t *nl, const uint32_t *waiting, const uint32_t *left)
+{
+	uint32_t cut = 0;
+
+	for (uint32_t i = 0; i < nl->elements; i++)
+	{
+		const nl_element_t *e = &nl->element[i];
+		for (uint32_t j = 0; (waiting[i] != 0) && (j < e->ins); j++)
+		{
+			uint32_t net = nl_in (nl, e)[j];
+			if (nl_follows (e, j) && (left[net] != 0))
+			{
+				for (uint32_t d = 0; d < nl->elements; d++)
+				{
+					const nl_element_t *f = &nl->element[d];
+					if ((f->kind == NL_TRI) || (f->kind == NL_RAM))
+					{
+						for (uint32_t k = 0; k < f->outs; k++)
+						{
+							if (nl_out (nl, f)[k] == net)
+							{
+								return net;
+							}
+						}
+					}
+				}
+				cut = (cut == 0) ? net : cut;
+			}
+		}
+	}
+	return cut;
+}
+
+int nl_levelize (const netlist_t *nl, uint32_t *order, uint32_t *level, uint8_t *cut)
+{
+	uint32_t *left = calloc (nl->nets, sizeof (uint32_t));			// drivers still to come
+	uint32_t *first = calloc (nl->nets + 1, sizeof (uint32_t));		// its readers in reader
+	uint32_t *reader = malloc ((nl->npins + 1) * sizeof (uint32_t));
+	uint32_t *waiting = calloc (nl->elements + 1, sizeof (uint32_t));
+	uint32_t *net_level = calloc (nl->nets, sizeof (uint32_t));
+	uint32_t *queue = malloc ((nl->elements + 1) * sizeof (uint32_t));
+	uint32_t head = 0;
+	uint32_t tail = 0;
+	int n = 0;
+
+	for (uint32_t i = 0; i < nl->elements; i++)
+	{
+		const nl_element_t *e = &nl->element[i];
+		for (uint32_t j = 0; j < e->outs; j++)
+		{
+			left[nl_out (nl, e)[j]]++;
+		}
+		for (uint32_t j = 0; j < e->ins; j++)
+		{
+			first[nl_in (nl, e)[j] + 1] += nl_follows (e, j);
+		}
+	}
+	for (uint32_t i = 0; i < nl->nets; i++)
+	{
+		first[i + 1] += first[i];
+	}
+	for (uint32_t i = 0; i < nl->elements; i++)
+	{
+		const nl_element_t *e = &nl->element[i];
+		for (uint32_t j = 0; j < e->ins; j++)
+		{
+			uint32_t net = nl_in (nl, e)[j];
+			if (nl_follows (e, j))
+			{
+				reader[first[net]++] = i;
+				waiting[i] += (left[net] != 0);
+			}
+		}
+		if (waiting[i] == 0)
+		{
+			queue[tail++] = i;
+		}
+	}
+	// first[net] has moved on to the start of the next net's readers
+	for (uint32_t i = nl->nets; i > 0; i--)
+	{
+		first[i] = first[i - 1];
+	}
+	first[0] = 0;
+
+	if (cut != NULL)
+	{
+		memset (cut, 0, nl->nets);
+	}
+	for (;;)
+	{
+		if (head == tail)
+		{
+			// everything left is on a loop, or after one
+			uint32_t net = (cut != NULL) ? loop_cut (nl, waiting, left) : 0;
+			if (net == 0)
+			{
+				break;
+			}
+			cut[net] = 1;
+			left[net] = 0;
+			for (uint32_t r = first[net]; r < first[net + 1]; r++)
+			{
+				if (--waiting[reader[r]] == 0)
+				{
+					queue[tail++] = reader[r];
+				}
+			}
+			continue;
+		}
+
+		uint32_t i = queue[head++];
+		const nl_element_t *e = &nl->element[i];
+		bool follows = false;
+		level[i] = 0;
+		for (uint32_t j = 0; j < e->ins; j++)
+		{
+			if (nl_follows (e, j))
+			{
+				uint32_t l = net_level[nl_in (nl, e)[j]];
+				level[i] = (l > level[i]) ? l : level[i];
+				follows = true;
+			}
+		}
+		level[i] += follows;
+		if (e->outs)
+		{
+			order[n++] = i;
+		}
+		for (uint32_t j = 0; j < e->outs; j++)
+		{
+			uint32_t net = nl_out (nl, e)[j];
+			net_level[net] = (level[i] > net_level[net]) ? level[i] : net_level[net];
+			if ((left[net] != 0) && (--left[net] == 0))
+			{
+				for (uint32_t r = first[net]; r < first[net + 1]; r++)
+				{
+					if (--waiting[reader[r]] == 0)
+					{
+						queue[tail++] = reader[r];
+					}
+				}
+			}
+		}
+	}
+
+	if (tail < nl->elements)
+	{
+		for (uint32_t i = 0; i < nl->elements; i++)
+		{
+			const nl_element_t *e = &nl->element[i];
+			if (waiting[i] != 0)
+			{
+				uint32_t net = nl_out (nl, e)[0];
+				fprintf (stderr, "net %u%s%s%s is on or after a combinational loop\n", net, nl->net_name[net] ? " (" : "",
+					nl->names + nl->net_name[net], nl->net_name[net] ? ")" : "");
+				break;
+			}
+		}
+		n = -1;
+	}
+
+	free (queue);
+	free (net_level);
+	free (waiting);
+	free (reader);
+	free (first);
+	free (left);
+	return n;
+}
@@ -0,0 +1,137 @@
+// the hardware design as a flat netlist, imported from Logisim's .circ file
+//
+// every subcircuit is inlined, and wires, tunnels, splitters, constants and the pins of
+// subcircuits are resolved away, leaving elements joined by nets of one bit each. The
+// nets are numbered densely in the order the elements first use them, with net 0 tied
+// low and net 1 tied high; multi bit gates are split into one element per bit and a
+// negated gate input gets a NOT of its own, so the gates form a plain graph
+//
+// each element's nets are a run of nl->pins, its inputs followed by its outputs, laid
+// out by kind as below (w is the element's width; buses are bit 0 first):
+//
+// kind			inputs										outputs
+// AND OR XOR	one net per input							1
+// NOT			1											1
+// TRI			data[w], enable								out[w]
+// MUX			in0[w] .. in(2^s - 1)[w], select[s]			out[w]
+// DECODER		select[s], enable							2^s, one per value
+// COMPARE		a[w], b[w]									greater, equal, less
+// DFF			d, clock, preset, reset						q, not q
+// JKFF			j, k, clock, preset, reset					q, not q
+// REG			d[w], enable, clock, clear					q[w]
+// ROM			address[a]									data[w]
+// RAM			address[a], write, output, clock, data[w]	data[w]
+// CLOCK		-											1
+// INPUT		-											w, a pin of the top circuit or a button
+// OUTPUT		w											-, a pin of the top circuit
+// TTY			data[7], clock, write, clear				-
+// KEYBOARD		clock, read, clear							available, data[7]
+//
+// s and a are in the element's arg. A RAM's data nets are the same as inputs and as
+// outputs: it drives them only while its output enable is high, as a TRI does while
+// its enable is. The clocked elements take their clock's rising edge unless they are
+// FALLING. An input Logisim would leave unconnected is tied to the level that leaves
+// the element working (enables high, clears low), and one on a gate is left out, as
+// the design's "gateUndefined = ignore" option has Logisim do
+//
+// the import takes the port positions of each kind of component from where Logisim 3.7
+// draws them with the attributes this design uses, and refuses the options whose layout
+// it doesn't know; if Logisim is upgraded or the design starts using something else, a
+// port in the wrong place shows up in nl_check as a net nothing drives
+
+#ifndef NETLIST_H
+#define NETLIST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+enum
+{
+	NL_AND, NL_OR, NL_XOR, NL_NOT, NL_TRI, NL_MUX, NL_DECODER, NL_COMPARE,
+	NL_DFF, NL_JKFF, NL_REG, NL_ROM, NL_RAM,
+	NL_CLOCK, NL_INPUT, NL_OUTPUT, NL_TTY, NL_KEYBOARD,
+	NL_KINDS
+};
+
+// element flags
+#define NL_INVERT		0x01			// NAND, NOR and XNOR
+#define NL_SIGNED		0x02			// a two's complement COMPARE
+#define NL_FALLING		0x04			// clocked on the falling edge
+
+#define NL_LOW			0				// the nets tied to the constants
+#define NL_HIGH			1
+
+typedef struct
+{
+	uint8_t		kind;
+	uint8_t		flags;
+	uint16_t	width;
+	uint16_t	ins;					// how many of its nets are inputs
+	uint16_t	outs;
+	uint32_t	pin;					// its first net in pins
+	uint32_t	arg;					// select or address bits
+	uint32_t	words;					// a ROM's contents, 2^a of them from here in nl->words
+	uint32_t	name;					// the subcircuit it came from, and its label if it has
+										// one, in nl->names
+	uint16_t	x, y;					// where it is in that subcircuit
+} nl_element_t;
+
+typedef struct
+{
+	char		*top;					// the circuit that was imported
+
+	uint32_t	nets;
+	uint32_t	*net_name;				// the pin or tunnel nearest the top that the net
+										// passes through, or 0 for none
+
+	nl_element_t *element;
+	uint32_t	elements;
+	uint32_t	*pins;
+	uint32_t	npins;
+
+	uint32_t	*words;					// ROM contents
+	uint32_t	nwords;
+
+	char		*names;					// nul terminated strings; offset 0 is ""
+	uint32_t	names_len;
+} netlist_t;
+
+extern const char *const nl_kind_name[NL_KINDS];
+
+// reads path and flattens circuit top, or the file's main circuit if top is NULL
+bool nl_import (netlist_t *nl, const char *path, const char *top);
+void nl_free (netlist_t *nl);
+
+// which input of e, if any, clocks it: for the DFF, JKFF, REG, RAM, TTY and KEYBOARD
+// that is the input their state changes on the edge of; -1 for everything else
+int nl_clock (const nl_element_t *e);
+
+// whether e's outputs follow its input j within a clock: every input of the other
+// kinds, but only the preset and reset of a flip-flop, the clear of a REG and the
+// address and output enable of a RAM, as the rest are only looked at on the clock edge
+bool nl_follows (const nl_element_t *e, uint32_t j);
+
+// puts the elements with outputs in order so that each comes after everything driving
+// the inputs it follows, and gives every element its level: 0 for those that follow no
+// input, and otherwise one more than the deepest element driving them. A loop through
+// the gates is broken at one of its nets, a bus where it can be, which is marked in
+// cut (nl->nets bytes), and the elements reading it go first with the value it had;
+// with cut NULL a loop is an error. Returns how many elements went into order, or -1
+// after printing a net on a loop
+int nl_levelize (const netlist_t *nl, uint32_t *order, uint32_t *level, uint8_t *cut);
+
+// prints what looks wrong to stderr: nets with more than one driver other than through
+// a TRI or a RAM, and nets that are read and not driven. Returns how many there were
+int nl_check (const netlist_t *nl);
+
+static inline const uint32_t *nl_in (const netlist_t *nl, const nl_element_t *e)
+{
+	return &nl->pins[e->pin];
+}
+
+static inline const uint32_t *nl_out (const netlist_t *nl, const nl_element_t *e)
+{
+	return &nl->pins[e->pin + e->ins];
+}
+
+#endif
@@ -0,0 +1,150 @@
+// loader for Logisim "v2.0 raw" images
+//
+// this is the format seq.c prints and Logisim reads into its ROM and RAM components:
+// a header line followed by whitespace separated hex values, where N*value repeats a
+// value N times and # starts a comment
+//
+// a file whose name ends in .bin is taken instead as the entries in little endian
+// binary, as seq -b writes the whole ROM, with nothing to parse
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "fake8080.h"
+
+static long load_bin (FILE *f, const char *path, void *dst, size_t max, int width)
+{
+	uint8_t buf[4096];
+	size_t n = 0;
+	size_t got;
+
+	memset (dst, 0, max * width);
+	while ((got = fread (buf, width, sizeof (buf) / width, f)) > 0)
+	{
+		if (n + got > max)
+		{
+			fprintf (stderr, "%s is too large\n", path);
+			fclose (f);
+			return -1;
+		}
+		for (size_t i = 0; i < got; i++, n++)
+		{
+			if (width == 1)
+			{
+				((uint8_t *) dst)[n] = buf[i];
+			}
+			else
+			{
+				const uint8_t *w = &buf[4 * i];
+				((uint32_t *) dst)[n] = w[0] | (w[1] << 8) | (w[2] << 16) | ((uint32_t) w[3] << 24);
+			}
+		}
+	}
+	fclose (f);
+	return (long) n;
+}
+
+// read an image into dst, which holds max entries of width bytes (1 or 4)
+// returns the number of entries loaded, or -1 on error
+long load_raw (const char *path, void *dst, size_t max, int width)
+{
+	size_t name = strlen (path);
+	bool bin = (name > 4) && (strcmp (path + name - 4, ".bin") == 0);
+	FILE *f = fopen (path, bin ? "rb" : "r");
+	if (f == NULL)
+	{
+		fprintf (stderr, "Can't open %s\n", path);
+		return -1;
+	}
+	if (bin)
+	{
+		return load_bin (f, path, dst, max, width);
+	}
+
+	char line[256];
+	if ((fgets (line, sizeof (line), f) == NULL) || (strncmp (line, "v2.0 raw", 8) != 0))
+	{
+		fprintf (stderr, "%s is not a v2.0 raw image\n", path);
+		fclose (f);
+		return -1;
+	}
+
+	memset (dst, 0, max * width);
+
+	size_t n = 0;
+	char tok[64];
+	int len = 0;
+	int c;
+	do
+	{
+		c = fgetc (f);
+		if (c == '#')
+		{
+			while ((c != EOF) && (c != '\n'))
+			{
+				c = fgetc (f);
+			}
+		}
+		if ((c == EOF) || isspace (c))
+		{
+			if (len == 0)
+			{
+				continue;
+			}
+			tok[len] = 0;
+			len = 0;
+
+			unsigned long count = 1;
+			char *val = tok;
+			char *star = strchr (tok, '*');
+			if (star != NULL)
+			{
+				*star = 0;
+				count = strtoul (tok, NULL, 10);
+				val = star + 1;
+			}
+			unsigned long v = strtoul (val, NULL, 16);
+			if (n + count > max)
+			{
+				fprintf (stderr, "%s is too large\n", path);
+				fclose (f);
+				return -1;
+			}
+			for (unsigned long i = 0; i < count; i++, n++)
+			{
+				if (width == 1)
+				{
+					((uint8_t *) dst)[n] = (uint8_t) v;
+				}
+				else
+				{
+					((uint32_t *) dst)[n] = (uint32_t) v;
+				}
+			}
+		}
+		else if (len < (int) sizeof (tok) - 1)
+		{
+			tok[len++] = (char) c;
+		}
+	}
+	while (c != EOF);
+
+	fclose (f);
+	return (long) n;
+}
+
+// FNV-1a over the control words, so an engine built from one table can tell if it has
+// been handed another
+uint32_t rom_hash (const uint32_t *rom, size_t words)
+{
+	uint32_t h = 2166136261u;
+
+	for (size_t i = 0; i < words; i++)
+	{
+		h ^= rom[i];
+		h *= 16777619u;
+	}
+	return h;
+}
@@ -1,4352 +1,1380 @@
-// 8080 cycle by cycle operation codes
+// 8080 cycle by cycle operation codes, from the table in control.h
 // to be placed in a nice wide ROM with lots of signal outputs
 //
-// bits		name		function
-// 0-3		src			the source of a transfer
-// 4-7		dest		the destination of a transfer
-// 8-9		add			which register pair drives the address bus
-// 10-13	maths		the desired alu funtion
-// 14		carry		we want the carry to be stored
-// 15		zerosign	we want the zero and sign to be stored
-// 16		inton		true to enable interrupts
-// 17		intoff		true to disable interrupts
-// 18		stc			set carry flag
-// 19		cmc			complement carry flag
-// 20		xchg		alias de <=> hl
-// 31		last		this is the last cycle of an instruction
+// with no arguments this prints the ROM in Logisim's "v2.0 raw" format; -c [profile], -b, -d, -n,
+// -t and -p are the other outputs below, and -l only checks the table. Any of them can
+// be preceded by -v name to generate from a variant of the table instead
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 
-// source registers - bits 0-3
-#define S_B 	0
-#define S_C 	1
-#define S_D 	2
-#define S_E 	3
-#define S_H 	4
-#define S_L 	5
-#define S_M 	6
-#define S_A 	7
-#define S_PCH 	8
-#define S_PCL 	9
-#define S_SPH 	10
-#define S_SPL 	11
-#define S_MAH 	12
-#define S_MAL 	13
-#define S_FLAG 	14
-#define S_IR	15
+#include "fake8080.h"
+#include "control.h"
 
-// destination registers - bits 4-7
-#define D_B 	(0 << 4)
-#define D_C 	(1 << 4)
-#define D_D 	(2 << 4)
-#define D_E 	(3 << 4)
-#define D_H 	(4 << 4)
-#define D_L 	(5 << 4)
-#define D_M 	(6 << 4)
-#define D_A 	(7 << 4)
-#define D_PCH 	(8 << 4)
-#define D_PCL 	(9 << 4)
-#define D_SPH 	(10 << 4)
-#define D_SPL 	(11 << 4)
-#define D_MAH 	(12 << 4)
-#define D_MAL 	(13 << 4)
-#define D_FLAG 	(14 << 4)
-#define D_IR	(15 << 4)
+_Static_assert (sizeof (control) == (64 * 256) * sizeof (uint32_t), "control table must hold 256 opcode blocks of 64 slots");
 
-// address source - bits 8-9
-#define	HL		(0 << 8)
-#define PC		(1 << 8)
-#define SP		(2 << 8)
-#define MA		(3 << 8)
+// what everything below is generated from: control.h's table, rewritten by the
+// variants given, if any
+static uint32_t table[64 * 256];
 
-// arithmetic operations - bits 10-13
-#define ADDOP	(0 << 10)
-#define ADCOP	(1 << 10)
-#define	SUBOP	(2 << 10)
-#define SBBOP	(3 << 10)
-#define	ANDOP	(4 << 10)
-#define	XOROP	(5 << 10)
-#define OROP	(6 << 10)
-#define CMPOP	(7 << 10)
-#define INCLOP	(8 << 10)
-#define INCHOP 	(9 << 10)
-#define DECLOP	(10 << 10)
-#define DECHOP	(11 << 10)
-#define RAROP	(12 << 10)
-#define RRCOP	(13 << 10)
-#define ZEROOP	(14 << 10)
-#define BYPASS	(15 << 10)
+#define ALU_OF(w)		(((w) >> 10) & 0x0f)
+#define SRC_OF(w)		((w) & 0x0f)
+#define DEST_OF(w)		(((w) >> 4) & 0x0f)
+#define ADDR_OF(w)		(((w) >> 8) & 0x03)
 
-// flags
-#define	CARRYF	(1 << 14)
-#define ZSF		(1 << 15)		// zero and sign flags are always set together
+// variants (seq -v name, as many times as wanted, before the other options): the table
+// as it would be on hardware the board doesn't have yet, so the outputs and the cycle
+// report can be compared with control.h's. Each rewrites the table in place, or says
+// why it can't and returns false
 
-// interrupts
-#define INTON	(1 << 16)
-#define INTOFF	(1 << 17)
+static const char *applied[8];
+static int applied_count;
 
-// carry set and complement
-#define STC		(1 << 18)
-#define CMC		(1 << 19)
+// a step that changes nothing, for a half left with nothing to do after its fetch
+#define IDLE			(S_A + D_A + PC + BYPASS)
 
-// xchg flip bit for de-hl swap
-#define XCHG	(1 << 20)
+// the bits that can go on any step of a half without changing what it does
+#define MOVABLE			(INTON + INTOFF + LAST)
 
+static bool reads_pc (uint32_t w)
+{
+	return (SRC_OF (w) == S_PCH) || (SRC_OF (w) == S_PCL)
+		|| (((SRC_OF (w) == S_M) || (DEST_OF (w) == (D_M >> 4))) && (ADDR_OF (w) == (PC >> 8)));
+}
 
+// 1 for pcl and 2 for pch
+static int writes_pc (uint32_t w)
+{
+	return (DEST_OF (w) == (D_PCL >> 4)) ? 1 : (DEST_OF (w) == (D_PCH >> 4)) ? 2 : 0;
+}
 
+// take n steps out of a half at step at, moving the rest up. INTON or INTOFF on them
+// goes to the step that moves into their place, and a LAST to the step before, or to
+// an IDLE if they were all the half did after its fetch
+static void remove_steps (uint32_t *w, int at, int n)
+{
+	uint32_t extra = 0;
 
-#define LAST	(1 << 31)
+	for (int i = at; i < at + n; i++)
+	{
+		extra |= w[i] & MOVABLE;
+	}
+	memmove (&w[at], &w[at + n], (32 - at - n) * sizeof (uint32_t));
+	memset (&w[32 - n], 0, n * sizeof (uint32_t));
+	if (!(extra & LAST))
+	{
+		w[at] |= extra;
+	}
+	else if (at > 1)
+	{
+		w[at - 1] |= extra;
+	}
+	else
+	{
+		w[at] = IDLE | extra;
+	}
+}
 
+// the steps of a pc increment at step: INC_PCL, INC_PCH, or the one step of the inc16
+// variant; 0 if there isn't one
+#define INC_PC16		(S_PCL + D_PCL + PC + BYPASS + INC16)
 
-// now we make constants for individual operations
-//
-// an operation requires one memory address; thirty-two operations are permitted per instruction
-// instructions are (generally) repeated twice in a sixty-four address block; an address input is
-// false if a flag matches a selected flag in a conditional instruction and high if not (for non-
-// conditional instructions the input could be either)
-//
-// every instruction must begin by loading the IR
-//
-// in general, the bits that make up the control word can be ignored if not required; unused equates
-// will contribute zero bitss to the word
+static int pc_increment (const uint32_t *w, int step)
+{
+	if ((w[step] & ~MOVABLE) == (INC_PC16))
+	{
+		return 1;
+	}
+	if ((step < 31) && ((w[step] & ~MOVABLE) == (INC_PCL)) && ((w[step + 1] & ~MOVABLE) == (INC_PCH)))
+	{
+		return 2;
+	}
+	return 0;
+}
+
+// overlap: the pc is a counter that steps during the fetch, so the INC_PCL, INC_PCH
+// that takes each instruction past its opcode goes. Step 0 runs from the block of the
+// instruction before, so it has to be the same everywhere: every half gets the
+// counting fetch and loses its first increment, which can be brought forward to the
+// fetch if nothing before it uses the pc. A half without one has to load the whole pc
+// before it reads it
+static bool variant_overlap (void)
+{
+	if (table[0] & PCINC)
+	{
+		fprintf (stderr, "overlap: the table already counts the pc on the fetch\n");
+		return false;
+	}
+	for (int half = 0; half < 512; half++)
+	{
+		uint32_t *w = &table[half * 32];
+		int at = 0;
+		int n = 0;
+		int loaded = 0;
+
+		for (int step = 1; step < 32; step++)
+		{
+			n = pc_increment (w, step);
+			if (n)
+			{
+				at = step;
+				break;
+			}
+			if (reads_pc (w[step]) && (loaded != 3))
+			{
+				fprintf (stderr, "overlap: op=%02x cond=%d uses the pc at step %d before it steps past the opcode\n",
+					half / 2, half % 2, step);
+				return false;
+			}
+			loaded |= writes_pc (w[step]);
+			if (w[step] & LAST)
+			{
+				break;
+			}
+		}
+		if (at)
+		{
+			remove_steps (w, at, n);
+		}
+		w[0] |= PCINC;
+	}
+	return true;
+}
+
+// inc16: a 16 bit incrementer for the register pairs, so the INCL of a pair's low
+// register and then the INCH of its high one, or DECL and DECH, become one INC16 or
+// DEC16 step. The carry out of the pair ends up in icarry either way
+static bool variant_inc16 (void)
+{
+	for (int half = 0; half < 512; half++)
+	{
+		uint32_t *w = &table[half * 32];
+
+		for (int step = 1; (step < 31) && !(w[step] & LAST); step++)
+		{
+			uint32_t a = w[step] & ~MOVABLE;
+			uint32_t b = w[step + 1] & ~MOVABLE;
+			uint32_t low = SRC_OF (a);
+			bool pair = (low & 1) && (low != S_A) && (low < S_FLAG)
+				&& (DEST_OF (a) == low) && (SRC_OF (b) == low - 1) && (DEST_OF (b) == low - 1)
+				&& !(a & ~0x3fff) && !(b & ~0x3fff);
+			bool up = (ALU_OF (a) == (INCLOP >> 10)) && (ALU_OF (b) == (INCHOP >> 10));
+			bool down = (ALU_OF (a) == (DECLOP >> 10)) && (ALU_OF (b) == (DECHOP >> 10));
+			if (pair && (up || down))
+			{
+				uint32_t extra = (w[step] | w[step + 1]) & MOVABLE;
+				w[step] = low + (low << 4) + PC + BYPASS + (up ? INC16 : DEC16) + extra;
+				w[step + 1] = 0;
+				remove_steps (w, step + 1, 1);
+			}
+		}
+	}
+	return true;
+}
+
+// the one step of each half of opcode that is fast becomes the n steps of slow, for
+// the sequences control.h keeps from before the hardware that does them in one
+static bool expand_step (int opcode, uint32_t fast, const uint32_t *slow, int n)
+{
+	for (int half = opcode * 2; half < opcode * 2 + 2; half++)
+	{
+		uint32_t *w = &table[half * 32];
+		int step = 1;
+		int last = 0;
+
+		while ((step < 32) && ((w[step] & ~MOVABLE) != fast))
+		{
+			step++;
+		}
+		while ((last < 31) && !(w[last] & LAST))
+		{
+			last++;
+		}
+		// the one step becomes n, so the LAST ends up at slot last + n - 1
+		if ((step == 32) || (last + n - 1 > 31))
+		{
+			fprintf (stderr, "Opcode %02x has %s\n", opcode, (step == 32) ? "been changed by another variant" : "no room for the slow steps");
+			return false;
+		}
+		uint32_t extra = w[step] & MOVABLE;
+		memmove (&w[step + n], &w[step + 1], (32 - step - n) * sizeof (uint32_t));
+		memcpy (&w[step], slow, n * sizeof (uint32_t));
+		w[step + n - 1] |= extra;
+	}
+	return true;
+}
+
+// slowcarry: STC and CMC the way they were before the STC and CMC bits, by getting the
+// alu to set or toggle the carry in two and four steps
+static bool variant_slowcarry (void)
+{
+	static const uint32_t stc[] = { SLOW_STC1, SLOW_STC2 };
+	static const uint32_t cmc[] = { SLOW_CMC1, SLOW_CMC2, SLOW_CMC3, SLOW_CMC4 };
+
+	return expand_step (0x37, STC1, stc, 2) && expand_step (0x3f, CMC1, cmc, 4);
+}
+
+// slowxchg: XCHG copying DE and HL through MA in six steps, instead of flipping which
+// registers the codes for them name with the XCHG bit
+static bool variant_slowxchg (void)
+{
+	static const uint32_t xchg[] = { SLOW_XCHG1, SLOW_XCHG2, SLOW_XCHG3, SLOW_XCHG4, SLOW_XCHG5, SLOW_XCHG6 };
+
+	return expand_step (0xeb, XCHG1, xchg, 6);
+}
+
+static const struct
+{
+	const char *name;
+	bool (*apply) (void);
+	const char *what;
+} variants[] =
+{
+	{ "overlap", variant_overlap, "the pc counts up during the fetch instead of in two alu steps" },
+	{ "inc16", variant_inc16, "a 16 bit incrementer counts a register pair in one step instead of two" },
+	{ "slowcarry", variant_slowcarry, "STC and CMC by the alu, without the STC and CMC bits" },
+	{ "slowxchg", variant_slowxchg, "XCHG by copying through MA, without the XCHG bit" },
+};
+
+// what STC and CMC leave in the carry, for every A and carry they start with, run on
+// the registers alone with fake8080.h's alu (memory reads as zero). Every variant is
+// checked, since nothing else it is run on would notice: STC has to set the carry and
+// CMC invert it, without changing A
+static bool carry_ok (const char *name)
+{
+	static const uint8_t opcode[2] = { 0x37, 0x3f };
+
+	for (int half = 0; half < 4; half++)
+	{
+		const uint32_t *w = &table[((opcode[half / 2] * 2) + (half % 2)) * 32];
+		for (int in = 0; in < 512; in++)
+		{
+			uint8_t reg[16] = { 0 };
+			uint8_t carry = in >> 8;
+			uint8_t icarry = 0;
+			uint8_t cout;
+			reg[S_A] = (uint8_t) in;
+
+			for (int step = 1; step < 32; step++)
+			{
+				uint8_t bus = (SRC_OF (w[step]) == S_FLAG) ? (carry ? FLAG_C : 0) : (SRC_OF (w[step]) == S_M) ? 0 : reg[SRC_OF (w[step])];
+				uint8_t r = alu (ALU_OF (w[step]), reg[S_A], bus, carry, icarry, &cout);
+				if (DEST_OF (w[step]) == (D_FLAG >> 4))
+				{
+					carry = r & FLAG_C;
+				}
+				else if (DEST_OF (w[step]) != (D_M >> 4))
+				{
+					reg[DEST_OF (w[step])] = r;
+				}
+				if (w[step] & CARRYF)
+				{
+					carry = (w[step] & STC) ? 1 : (w[step] & CMC) ? !carry : cout;
+				}
+				icarry = cout;
+				if (w[step] & LAST)
+				{
+					break;
+				}
+			}
+			if ((carry != ((half < 2) ? 1 : !(in >> 8))) || (reg[S_A] != (uint8_t) in))
+			{
+				fprintf (stderr, "Variant %s leaves A=%02x carry=%d after %s with A=%02x carry=%d\n",
+					name, reg[S_A], carry, (half < 2) ? "STC" : "CMC", in & 0xff, in >> 8);
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static bool apply_variant (const char *name)
+{
+	for (size_t i = 0; i < sizeof (variants) / sizeof (variants[0]); i++)
+	{
+		if (strcmp (variants[i].name, name) == 0)
+		{
+			if ((applied_count == 8) || !variants[i].apply () || !carry_ok (name))
+			{
+				return false;
+			}
+			applied[applied_count++] = variants[i].name;
+			return true;
+		}
+	}
+	fprintf (stderr, "No variant %s; there are:\n", name);
+	for (size_t i = 0; i < sizeof (variants) / sizeof (variants[0]); i++)
+	{
+		fprintf (stderr, "  %-10s %s\n", variants[i].name, variants[i].what);
+	}
+	return false;
+}
+
+// every half starts with the same fetch, since step 0 runs from the block of the
+// instruction before
+static bool fetch_ok (uint32_t w)
+{
+	return (w == table[0]) && ((w & ~PCINC) == LD_IR);
+}
+
+// the linter, run over the table before anything is generated from it (seq -l runs
+// it on its own). Each problem is one line on the given stream:
 //
-// SRC		DEST	ADDR	ALUOP	FLAGS
+//		rule op=xx cond=n step=n word=xxxxxxxx
 //
-// these are a mix of individual instructions and generic things that we might use lots of
+// after-last		a nonzero word after the LAST of its half, which never runs
+// no-last			a half without a LAST, whose step counter just wraps (word is its step 0)
+// m-to-m			memory as both source and destination, which the one address bus can't do
+// flags-bypass		carry or zero and sign stored from a BYPASS step, which leaves the alu's
+//					flags meaningless; carry is allowed where STC or CMC decides it
+// pc-count			PCINC on a step that also writes the pc
+// pair-count		INC16 or DEC16 on a step whose destination isn't in a pair, or both at once
+
+static void lint_report (FILE *f, const char *rule, int half, int step)
+{
+	fprintf (f, "%s op=%02x cond=%d step=%d word=%08x\n", rule, half / 2, half % 2, step, table[(half * 32) + step]);
+}
+
+static int lint (FILE *f)
+{
+	int problems = 0;
+
+	for (int half = 0; half < 512; half++)
+	{
+		bool ended = false;
+		for (int step = 0; step < 32; step++)
+		{
+			uint32_t w = table[(half * 32) + step];
+			if (ended)
+			{
+				if (w != 0)
+				{
+					lint_report (f, "after-last", half, step);
+					problems++;
+				}
+				continue;
+			}
+			if ((SRC_OF (w) == S_M) && (DEST_OF (w) == (D_M >> 4)))
+			{
+				lint_report (f, "m-to-m", half, step);
+				problems++;
+			}
+			if ((ALU_OF (w) == (BYPASS >> 10))
+				&& ((w & ZSF) || ((w & CARRYF) && !(w & (STC | CMC)))))
+			{
+				lint_report (f, "flags-bypass", half, step);
+				problems++;
+			}
+			if ((w & PCINC) && writes_pc (w))
+			{
+				lint_report (f, "pc-count", half, step);
+				problems++;
+			}
+			if ((w & (INC16 | DEC16))
+				&& (((w & INC16) && (w & DEC16)) || (DEST_OF (w) == (D_M >> 4)) || (DEST_OF (w) == (D_A >> 4))
+					|| (DEST_OF (w) >= (D_FLAG >> 4))))
+			{
+				lint_report (f, "pair-count", half, step);
+				problems++;
+			}
+			ended = (w & LAST) != 0;
+		}
+		if (!ended)
+		{
+			lint_report (f, "no-last", half, 0);
+			problems++;
+		}
+	}
+	return problems;
+}
+
+// generator for the native simulator's compiled engine (seq -c > ops.c)
 //
-// add LAST if an operation the last in the instruction sequence
-// this first block is for frequently used constants
+// every opcode and condition becomes one C function that runs steps 1 to LAST of its
+// sequence as straight-line code and returns how many steps that was; step 0, which
+// loads the IR from the previous instruction's block, gets a function of its own.
+// The names used in the output are the ones in fake8080.h
 
-#define	LD_IR		S_M + D_IR + PC + BYPASS
-#define INC_PCL		S_PCL +	D_PCL + PC + INCLOP
-#define INC_PCH		S_PCH +	D_PCH +	PC + INCHOP
-#define INC_MAL		S_MAL + D_MAL + PC + INCLOP
-#define INC_MAH		S_MAH + D_MAH + PC + INCHOP
-#define INC_SPL		S_SPL + D_SPL + PC + INCLOP
-#define INC_SPH		S_SPH + D_SPH + PC + INCHOP
-#define DEC_SPL		S_SPL + D_SPL + PC + DECLOP
-#define DEC_SPH		S_SPH + D_SPH + PC + DECHOP
-#define M2MAL		S_M + D_MAL + PC + BYPASS
-#define M2MAH		S_M + D_MAH + PC + BYPASS
+static const char *reg_name[16] =
+{
+	"REG_B", "REG_C", "REG_D", "REG_E", "REG_H", "REG_L", "REG_M", "REG_A",
+	"REG_PCH", "REG_PCL", "REG_SPH", "REG_SPL", "REG_MAH", "REG_MAL", "REG_FLAG", "REG_IR"
+};
 
-#define SPHL1		S_H + D_SPH + PC + BYPASS			// copy HL to SP
-#define SPHL2		S_L + D_SPL + PC + BYPASS
+static const char *alu_name[16] =
+{
+	"ALU_ADD", "ALU_ADC", "ALU_SUB", "ALU_SBB", "ALU_AND", "ALU_XOR", "ALU_OR", "ALU_CMP",
+	"ALU_INCL", "ALU_INCH", "ALU_DECL", "ALU_DECH", "ALU_RAR", "ALU_RRC", "ALU_ZERO", "ALU_PASS"
+};
 
-#define PCHL1		S_H + D_PCH + PC + BYPASS			// copy HL to PC
-#define PCHL2		S_L + D_PCL	+ PC + BYPASS
+static const char *addr_expr[4] =
+{
+	"(m->reg[map[REG_H]] << 8) | m->reg[map[REG_L]]",
+	"(m->reg[REG_PCH] << 8) | m->reg[REG_PCL]",
+	"(m->reg[REG_SPH] << 8) | m->reg[REG_SPL]",
+	"(m->reg[REG_MAH] << 8) | m->reg[REG_MAL]"
+};
 
-#define XTHL1		S_H + D_MAH + PC + BYPASS			// swap HL and the top of stack
-#define XTHL2		S_L + D_MAL + PC + BYPASS
+// d, e, h and l are the registers that xchg aliases
+static bool aliased (int r)
+{
+	return (r >= 2) && (r <= 5);
+}
 
-/*
-// the slow way
-#define XCHG1		S_H + D_MAH + PC + BYPASS			// swap DE and HL (via MA)
-#define XCHG2		S_L + D_MAL + PC + BYPASS
-#define XCHG3		S_D + D_H + PC + BYPASS
-#define XCHG4		S_E + D_L + PC + BYPASS
-#define XCHG5		S_MAH + D_D + PC + BYPASS
-#define XCHG6		S_MAL + D_E + PC + BYPASS
-*/
-// the quick wat
-#define XCHG1		S_A + D_MAH + PC + BYPASS + XCHG
+static bool uses_memory (uint32_t w)
+{
+	return ((w & 0x0f) == 6) || (((w >> 4) & 0x0f) == 6);
+}
 
-// alu immediate
-#define ADI			S_M + D_A + PC + ADDOP + CARRYF + ZSF
-#define ACI			S_M + D_A + PC + ADCOP + CARRYF + ZSF
-#define SUI			S_M + D_A + PC + SUBOP + CARRYF + ZSF
-#define SBI			S_M + D_A + PC + SBBOP + CARRYF + ZSF
-#define ANI			S_M + D_A + PC + ANDOP + CARRYF + ZSF
-#define XRI			S_M + D_A + PC + XOROP + CARRYF + ZSF
-#define ORI			S_M + D_A + PC + OROP  + CARRYF + ZSF
-#define CPI			S_M + D_MAH + PC + CMPOP + CARRYF + ZSF
+static bool uses_map (uint32_t w)
+{
+	return aliased (w & 0x0f) || aliased ((w >> 4) & 0x0f) || (uses_memory (w) && (((w >> 8) & 3) == 0));
+}
 
-// jmp absolute
-#define JMP1		M2MAH								// low byte target address to MAH
-#define JMP2		S_M + D_PCH + PC + BYPASS			// high byte straight to PCH
-#define JMP3		S_MAH + D_PCL + PC + BYPASS			// and low byte to PCL
+static void emit_reg (int r)
+{
+	if (aliased (r))
+	{
+		printf ("m->reg[map[%s]]", reg_name[r]);
+	}
+	else
+	{
+		printf ("m->reg[%s]", reg_name[r]);
+	}
+}
 
+// a profile from sim -P, for seq -t and -c: how often each half ran, and each slot.
+// The slot counts are only used if the profile was taken with this table, variants
+// and all; otherwise, or in a profile that doesn't have them, every step of a half
+// is taken to have run as often as the half
+static uint64_t runs[512];
+static uint64_t slots[64 * 256];
+static bool profiled;
+
+// one microcycle, the same work as execute() in decode.c with everything that depends
+// only on the control word decided here; remap when steps after an xchg use d, e, h or l.
+// With a profile the comment says how often the step ran
+static void emit_step (uint32_t w, bool remap, uint64_t ran)
+{
+	int src = w & 0x0f;
+	int dest = (w >> 4) & 0x0f;
 
-// call/rst
-#define CALL1		S_MAH + D_PCH + PC + BYPASS
-#define CALL2		S_MAL + D_PCL + PC + BYPASS
+	if (profiled)
+	{
+		printf ("\t// %08x, ran %llu times\n", w, (unsigned long long) ran);
+	}
+	else
+	{
+		printf ("\t// %08x\n", w);
+	}
+	if (uses_memory (w))
+	{
+		printf ("\taddr = %s;\n", addr_expr[(w >> 8) & 3]);
+	}
+	printf ("\tr = alu (%s, m->reg[REG_A], ", alu_name[(w >> 10) & 0x0f]);
+	switch (src)
+	{
+		case 6:		printf ("machine_read (m, addr)");		break;
+		case 14:	printf ("machine_flags (m)");			break;
+		case 15:	printf ("m->reg[REG_IR] & 0x38");		break;
+		default:	emit_reg (src);						break;
+	}
+	printf (", m->carry, m->icarry, &cout);\n");
 
-#define RST1		S_A + D_PCH + PC + ZEROOP
-#define RST2		S_IR + D_PCL + PC + BYPASS			// sets restart vector to 0000 0000 00xx x000 where xxx is the rst number
+	switch (dest)
+	{
+		case 6:
+			printf ("\tmachine_write (m, addr, r);\n");
+			break;
+		case 14:
+			printf ("\tm->carry = (r & FLAG_C) != 0;\n");
+			printf ("\tm->zero = (r & FLAG_Z) != 0;\n");
+			printf ("\tm->sign = (r & FLAG_S) != 0;\n");
+			break;
+		case 15:
+			printf ("\tm->reg[REG_IR] = r;\n");
+			printf ("\tm->cond = machine_condition (m, r);\n");
+			break;
+		default:
+			printf ("\t");
+			emit_reg (dest);
+			printf (" = r;\n");
+			break;
+	}
 
-// push and pop
-#define PUSHB		S_B + D_M + SP + BYPASS
-#define PUSHC		S_C + D_M + SP + BYPASS
-#define PUSHD		S_D + D_M + SP + BYPASS
-#define PUSHE		S_E + D_M + SP + BYPASS
-#define PUSHH		S_H + D_M + SP + BYPASS
-#define PUSHL		S_L + D_M + SP + BYPASS
-#define PUSHA		S_A + D_M + SP + BYPASS
-#define PUSHF		S_FLAG + D_M + SP + BYPASS
-#define PUSHPCL		S_PCL + D_M + SP + BYPASS
-#define PUSHPCH		S_PCH + D_M + SP + BYPASS
-#define PUSHMAL		S_MAL + D_M + SP + BYPASS
-#define PUSHMAH		S_MAH + D_M + SP + BYPASS
+	if (w & CARRYF)
+	{
+		printf ("\tm->carry = %s;\n", (w & STC) ? "1" : (w & CMC) ? "!m->carry" : "cout");
+	}
+	if (w & ZSF)
+	{
+		printf ("\tm->zero = (r == 0);\n");
+		printf ("\tm->sign = r >> 7;\n");
+	}
+	printf ("\tm->icarry = cout;\n");
+	if (w & (INC16 | DEC16))
+	{
+		printf ("\tmachine_count_pair (m, %s, %s, %s);\n", aliased (dest) ? "map" : "xmap[0]", reg_name[dest],
+			(w & DEC16) ? "true" : "false");
+	}
+	if (w & INTON)
+	{
+		printf ("\tm->inte = 1;\n");
+	}
+	if (w & INTOFF)
+	{
+		printf ("\tm->inte = 0;\n");
+	}
+	if (w & XCHG)
+	{
+		printf ("\tm->flip ^= 1;\n");
+		if (remap)
+		{
+			printf ("\tmap = xmap[m->flip];\n");
+		}
+	}
+	if (w & PCINC)
+	{
+		printf ("\tif (++m->reg[REG_PCL] == 0)\n\t{\n\t\tm->reg[REG_PCH]++;\n\t}\n");
+	}
+}
 
-#define POPB		S_M + D_B + SP + BYPASS
-#define POPC		S_M + D_C + SP + BYPASS
-#define POPD		S_M + D_D + SP + BYPASS
-#define POPE		S_M + D_E + SP + BYPASS
-#define POPH		S_M + D_H + SP + BYPASS
-#define POPL		S_M + D_L + SP + BYPASS
-#define POPA		S_M + D_A + SP + BYPASS
-#define POPF		S_M + D_FLAG + SP + BYPASS
-#define POPPCL		S_M + D_PCL + SP + BYPASS
-#define POPPCH		S_M + D_PCH + SP + BYPASS
-#define POPMAL		S_M + D_MAL + SP + BYPASS
-#define POPMAH		S_M + D_MAH + SP + BYPASS
+// the locals a function running words first..last needs
+static void emit_locals (int first, int last)
+{
+	bool map = false;
+	bool addr = false;
 
+	for (int i = first; i <= last; i++)
+	{
+		map |= uses_map (table[i]);
+		addr |= uses_memory (table[i]);
+	}
+	if (map)
+	{
+		printf ("\tconst uint8_t *map = xmap[m->flip];\n");
+	}
+	if (addr)
+	{
+		printf ("\tuint16_t addr;\n");
+	}
+	printf ("\tuint8_t r;\n");
+	printf ("\tuint8_t cout;\n\n");
+}
 
-/*
-// set and complement carry
-// my approach is extremely slow - six and seven clocks - while the 8080 does it in four clocks
-// I suspect the designers used a JK latch for the carry, in which case a single bit would either
-// set it (STC) or toggle it (CMC) but for now I will explicitly perform operations which set
-// or toggle the carry. They're a bit sneaky, and slow :(
+// the same hash rom_hash() in rom.c takes, so the simulator can tell whether the
+// compiled engine was generated from the ROM image it has loaded
+static uint32_t table_hash (void)
+{
+	uint32_t h = 2166136261u;
 
-#define STC1		S_MAH + D_MAH + PC + ZEROOP			// get a zero
-#define STC2		S_MAH + D_MAH + PC + DECLOP			// turn it into minus one
-#define STC3		S_MAH + D_MAH + PC + ADDOP + CARRYF	// and add it to itself to set the carry... slow, but doesn't
-														// require a direct control to the carry flip-flop
+	for (int i = 0; i < (64 * 256); i++)
+	{
+		h ^= table[i];
+		h *= 16777619u;
+	}
+	return h;
+}
 
-#define CMC1		S_A + D_MAH + PC + BYPASS			// save the accumulator: complementing the carry is even slower
-#define CMC2		S_FLAG + D_A + PC + INCLOP			// carry is bit one; incrementing inverts bit one
-#define CMC3		S_A + D_A + PC + RAROP + CARRYF		// shift that bit into the carry flag
-#define CMC4		S_MAH + D_A + PC + BYPASS			// and restore the accumulator
-*/
+static int half_length (const uint32_t *t, int half)
+{
+	for (int step = 0; step < 32; step++)
+	{
+		if (t[(half * 32) + step] & LAST)
+		{
+			return step + 1;
+		}
+	}
+	return 0;
+}
 
-// or the hardware versions
-#define STC1		S_A + D_MAH + PC + STC + CARRYF
-#define CMC1		S_A + D_MAH + PC + CMC + CARRYF
+static bool read_profile (const char *path)
+{
+	FILE *f = fopen (path, "r");
+	char line[1024];
+	int n = 0;
+	bool ours = false;
+	bool counted = false;
 
+	if (f == NULL)
+	{
+		fprintf (stderr, "Can't open %s\n", path);
+		return false;
+	}
+	while (fgets (line, sizeof (line), f) != NULL)
+	{
+		unsigned op;
+		int cond;
+		unsigned long long c;
+		int used;
 
-// absolute store and load
-#define LDA			S_M + D_A + MA + BYPASS
-#define STA			S_A + D_M + MA + BYPASS
+		n++;
+		if (line[0] == '#')
+		{
+			char *rom = strstr (line, "microcode ");
+			unsigned hash;
+			ours |= (rom != NULL) && (sscanf (rom, "microcode %x", &hash) == 1) && (hash == table_hash ());
+			continue;
+		}
+		if (line[strspn (line, " \t\r\n")] == 0)
+		{
+			continue;
+		}
+		if ((sscanf (line, "%x %d %llu%n", &op, &cond, &c, &used) != 3) || (op > 255) || (cond < 0) || (cond > 1))
+		{
+			fprintf (stderr, "%s:%d: expected op cond count\n", path, n);
+			fclose (f);
+			return false;
+		}
+		int half = (op * 2) + cond;
+		int step = 0;
+		runs[half] += c;
+		for (char *tok = strtok (line + used, " \t\r\n"); tok != NULL; tok = strtok (NULL, " \t\r\n"))
+		{
+			char *star = strchr (tok, '*');
+			int k = (star != NULL) ? atoi (tok) : 1;
+			unsigned long long v = strtoull ((star != NULL) ? star + 1 : tok, NULL, 10);
+			if ((k < 1) || (step + k > 32))
+			{
+				fprintf (stderr, "%s:%d: more than 32 slots\n", path, n);
+				fclose (f);
+				return false;
+			}
+			while (k--)
+			{
+				slots[(half * 32) + step++] += v;
+			}
+			counted = true;
+		}
+	}
+	fclose (f);
 
-// cma				one's complement of accumulator, doesn't affect flags - can't do it in one :(
-#define CMA1		S_A + D_MAH + PC + ZEROOP			// put a zero in mah
-#define CMA2		S_MAH + D_MAH + PC + DECLOP			// make it 0xff
-#define CMA3		S_MAH + D_A + PC + XOROP			// and invert the acc
+	if (!ours || !counted)
+	{
+		memset (slots, 0, sizeof (slots));
+		for (int half = 0; half < 512; half++)
+		{
+			for (int step = 0; step < half_length (table, half); step++)
+			{
+				slots[(half * 32) + step] = runs[half];
+			}
+		}
+	}
+	profiled = true;
+	return true;
+}
 
-// shld and lhld
-#define SHLD1		S_L + D_M + MA + BYPASS
-#define SHLD2		S_H + D_M + MA + BYPASS
-#define LHLD1		S_M + D_L + MA + BYPASS
-#define LHLD2		S_M + D_H + MA + BYPASS
+// the true half of an opcode does the same as the false half, so can use its function
+static bool same_as_false (const int *length, int half)
+{
+	return (half & 1) && (length[half] == length[half - 1])
+		&& (memcmp (&table[half * 32], &table[(half - 1) * 32], length[half] * sizeof (uint32_t)) == 0);
+}
 
-// dad - only affect carry flag
-// sadly, we can only add a register to the accumulator, not another accumulator, so we have to move things around
-#define DAD1		S_A + D_MAH + PC + BYPASS			// save the accumulator
-#define DADB2		S_L + D_A + PC + BYPASS				// put L in instead
-#define DADB3		S_C + D_L + PC + ADDOP	+ CARRYF	// add low reg to L - we need to maintain carry
-#define DADB4		S_H + D_A + PC + BYPASS				// now get H in Acc
-#define DADB5		S_B + D_H + PC + ADCOP	+ CARRYF	// result in HL
-#define DAD6		S_MAH + D_A + PC + BYPASS			// and return the accumulator from exile
+static int emit_compiled (const char *path)
+{
+	// where each half ends, and whether its steps after the first can be run straight
+	// through; a sequence without a LAST, or one that reloads the IR part way through,
+	// is left to the simulator to step
+	int length[512];
+	bool straight[512];
 
-#define DADD2		S_L + D_A + PC + BYPASS				// put L in instead
-#define DADD3		S_E + D_L + PC + ADDOP	+ CARRYF	// add low reg to L - we need to maintain carry
-#define DADD4		S_H + D_A + PC + BYPASS				// now get H in Acc
-#define DADD5		S_D + D_H + PC + ADCOP	+ CARRYF	// result in HL
+	if ((path != NULL) && !read_profile (path))
+	{
+		return 1;
+	}
+	for (int half = 0; half < 512; half++)
+	{
+		length[half] = 0;
+		for (int step = 0; step < 32; step++)
+		{
+			if (table[half * 32 + step] & LAST)
+			{
+				length[half] = step + 1;
+				break;
+			}
+		}
+		straight[half] = (length[half] > 1);
+		for (int step = 1; step < length[half]; step++)
+		{
+			if (((table[half * 32 + step] >> 4) & 0x0f) == 15)
+			{
+				straight[half] = false;
+			}
+		}
+	}
 
-#define DADH2		S_L + D_A + PC + BYPASS				// put L in instead
-#define DADH3		S_L + D_L + PC + ADDOP	+ CARRYF	// add low reg to L - we need to maintain carry
-#define DADH4		S_H + D_A + PC + BYPASS				// now get H in Acc
-#define DADH5		S_H + D_H + PC + ADCOP	+ CARRYF	// result in HL
+	printf ("// generated by seq -c from the control table in control.h");
+	for (int i = 0; i < applied_count; i++)
+	{
+		printf ("%s%s", i ? ", " : " with -v ", applied[i]);
+	}
+	printf (" - do not edit\n");
+	if (path != NULL)
+	{
+		printf ("// with how often each step ran in %s\n", path);
+	}
+	printf ("\n");
+	printf ("#include \"fake8080.h\"\n\n");
 
-#define DADSP2		S_L + D_A + PC + BYPASS				// put L in instead
-#define DADSP3		S_SPL + D_L + PC + ADDOP + CARRYF	// add low reg to L - we need to maintain carry
-#define DADSP4		S_H + D_A + PC + BYPASS				// now get H in Acc
-#define DADSP5		S_SPH + D_H + PC + ADCOP + CARRYF	// result in HL
+	// step 0: one function per distinct control word
+	for (int half = 0; half < 512; half++)
+	{
+		uint32_t w = table[half * 32];
+		uint64_t ran = 0;
+		bool seen = false;
+		for (int h = 0; h < 512; h++)
+		{
+			seen |= (h < half) && (table[h * 32] == w);
+			ran += (table[h * 32] == w) ? slots[h * 32] : 0;
+		}
+		if (!seen)
+		{
+			printf ("static void step0_%08x (machine_t *m)\n{\n", w);
+			emit_locals (half * 32, half * 32);
+			emit_step (w, false, ran);
+			printf ("}\n\n");
+		}
+	}
 
+	// the rest of each sequence; the condition halves are usually the same, in which
+	// case the true half uses the false half's function
+	for (int half = 0; half < 512; half++)
+	{
+		if (!straight[half] || same_as_false (length, half))
+		{
+			continue;
+		}
+		bool both = !(half & 1) && straight[half + 1] && same_as_false (length, half + 1);
+		printf ("// opcode %02x, condition %s", half >> 1, (half & 1) ? "true" : "false");
+		if (profiled)
+		{
+			printf (": ran %llu times%s", (unsigned long long) (runs[half] + (both ? runs[half + 1] : 0)),
+				both ? ", with either condition" : "");
+		}
+		printf ("\n");
+		printf ("static int op_%02x_%d (machine_t *m)\n{\n", half >> 1, half & 1);
+		emit_locals (half * 32 + 1, half * 32 + length[half] - 1);
+		for (int step = 1; step < length[half]; step++)
+		{
+			bool remap = false;
+			for (int later = step + 1; later < length[half]; later++)
+			{
+				remap |= uses_map (table[half * 32 + later]);
+			}
+			uint64_t ran = slots[half * 32 + step] + (both ? slots[(half + 1) * 32 + step] : 0);
+			emit_step (table[half * 32 + step], remap, ran);
+		}
+		printf ("\treturn %d;\n}\n\n", length[half] - 1);
+	}
 
-// rotates all operate on the accumulator and affect the carry
-// rlc shifts left one bit, bit seven goes to carry and also to bit zero
-#define RLC1		S_A + D_A + PC + ADDOP	+ CARRYF			// does the shift into the carry
-#define RLC2		S_A + D_A + PC + INCHOP						// and adds the carry to the result
-// rrc shifts right one bit; bit zero goes to carry and also to bit seven
-#define RRC			S_A + D_A + PC + RRCOP + CARRYF
-// ral shifts left one bit into the carry; original carry moves to bit zero
-#define RAL			S_A + D_A + PC + ADCOP + CARRYF
-// rar shifts right one bit into the carry; original carry moves to bit seven
-#define RAR			S_A + D_A + PC + RAROP + CARRYF
+	printf ("const compiled_fetch_t compiled_fetch[512] =\n{\n");
+	for (int half = 0; half < 512; half++)
+	{
+		printf ("\tstep0_%08x,\n", table[half * 32]);
+	}
+	printf ("};\n\n");
 
-// 8 bit move immediates
-#define	MVIB		S_M + D_B + PC + BYPASS
-#define	MVIC		S_M + D_C + PC + BYPASS
-#define	MVID		S_M + D_D + PC + BYPASS
-#define	MVIE		S_M + D_E + PC + BYPASS
-#define	MVIH		S_M + D_H + PC + BYPASS
-#define	MVIL		S_M + D_L + PC + BYPASS
-#define	MVIM1		S_M + D_MAH + PC + BYPASS 					// use MAH as a temporary store
-#define	MVIM2		S_MAH + D_M + HL + BYPASS 					// and write to [HL]
-#define	MVIA		S_M + D_A + PC + BYPASS
+	printf ("const compiled_op_t compiled_ops[512] =\n{\n");
+	for (int half = 0; half < 512; half++)
+	{
+		if (!straight[half])
+		{
+			printf ("\tNULL,\n");
+		}
+		else if (same_as_false (length, half))
+		{
+			printf ("\top_%02x_0,\n", half >> 1);
+		}
+		else
+		{
+			printf ("\top_%02x_%d,\n", half >> 1, half & 1);
+		}
+	}
+	printf ("};\n\n");
 
-// 16-bit decrements
-#define DCXB1		S_C + D_C + PC + DECLOP						// by following a declop immediately with dechop the carry is automatic
-#define DCXB2		S_B + D_B + PC + DECHOP
-#define DCXD1		S_E + D_E + PC + DECLOP
-#define DCXD2		S_D + D_D + PC + DECHOP
-#define DCXH1		S_L + D_L + PC + DECLOP
-#define DCXH2		S_H + D_H + PC + DECHOP
-#define DCXSP1		S_SPL + D_SPL + PC + DECLOP
-#define DCXSP2		S_SPH + D_SPH + PC + DECHOP
+	printf ("const uint32_t compiled_rom_hash = 0x%08x;\n", table_hash ());
+	return 0;
+}
 
-// 16-bit increments
-#define INXB1		S_C + D_C + PC + INCLOP						// and the same for inclop/inchop
-#define INXB2		S_B + D_B + PC + INCHOP
-#define INXD1		S_E + D_E + PC + INCLOP
-#define INXD2		S_D + D_D + PC + INCHOP
-#define INXH1		S_L + D_L + PC + INCLOP
-#define INXH2		S_H + D_H + PC + INCHOP
-#define INXSP1		S_SPL + D_SPL + PC + INCLOP
-#define INXSP2		S_SPH + D_SPH + PC + INCHOP
+// the rom as binary for an eprom programmer: one image per byte lane, each the size of
+// a 27C128 (16384 x 8), with bits 0-7 in name_0-7.bin and so on up to name_24-31.bin,
+// and the whole table as 32 bit little endian words in name.bin
+static int emit_binary (const char *name)
+{
+	static const char *lane[4] = { "0-7", "8-15", "16-23", "24-31" };
+	static uint8_t image[5][4 * 64 * 256];
+	char path[1024];
 
-// 16 bit stores and load
-#define C2MAL		S_C + D_MAL + PC + BYPASS					// copy C to MAL
-#define B2MAH		S_B + D_MAH + PC + BYPASS					// copy B to MAH
-#define E2MAL		S_E + D_MAL + PC + BYPASS
-#define D2MAH		S_D + D_MAH + PC + BYPASS					// and the same for DE
-#define	LDAX		S_M + D_A + MA + BYPASS						// once address bus is set up, read
-#define STAX		S_A + D_M + MA + BYPASS						// or write
+	for (int i = 0; i < (64 * 256); i++)
+	{
+		if (((i % 64) == 0) && !fetch_ok (table[i]))
+		{
+			fprintf (stderr, "Alignment error at instruction %02x\n", i / 64);
+			return 1;
+		}
+		for (int b = 0; b < 4; b++)
+		{
+			image[b][i] = (uint8_t) (table[i] >> (8 * b));
+			image[4][(4 * i) + b] = (uint8_t) (table[i] >> (8 * b));
+		}
+	}
 
-// lxi
-#define	LXIB1		S_M + D_C + PC + BYPASS
-#define LXIB2		S_M + D_B + PC + BYPASS
-#define	LXID1		S_M + D_E + PC + BYPASS
-#define LXID2		S_M + D_D + PC + BYPASS
-#define	LXIH1		S_M + D_L + PC + BYPASS
-#define LXIH2		S_M + D_H + PC + BYPASS
-#define	LXISP1		S_M + D_SPL + PC + BYPASS
-#define LXISP2		S_M + D_SPH + PC + BYPASS
+	for (int b = 0; b < 5; b++)
+	{
+		size_t size = (b < 4) ? (64 * 256) : (4 * 64 * 256);
+		if (b < 4)
+		{
+			snprintf (path, sizeof (path), "%s_%s.bin", name, lane[b]);
+		}
+		else
+		{
+			snprintf (path, sizeof (path), "%s.bin", name);
+		}
 
-// 8-bit increments
-#define INRB		S_B + D_B + HL + INCLOP + ZSF
-#define INRC		S_C + D_C + HL + INCLOP + ZSF
-#define INRD		S_D + D_D + HL + INCLOP + ZSF
-#define INRE		S_E + D_E + HL + INCLOP + ZSF
-#define INRH		S_H + D_H + HL + INCLOP + ZSF
-#define INRL		S_L + D_L + HL + INCLOP + ZSF
-#define INRM1		S_M + D_MAH + HL + INCLOP + ZSF				// memory to temporary MAH
-#define INRM2		S_MAH + D_M + HL + BYPASS					// MAH to memory
-#define INRA		S_A + D_A + HL + INCLOP + ZSF
+		FILE *f = fopen (path, "wb");
+		if ((f == NULL) || (fwrite (image[b], 1, size, f) != size) || (fclose (f) != 0))
+		{
+			fprintf (stderr, "Can't write %s\n", path);
+			return 1;
+		}
+	}
+	return 0;
+}
 
-// 8-bit decrements
-#define DCRB		S_B + D_B + HL + DECLOP + ZSF
-#define DCRC		S_C + D_C + HL + DECLOP + ZSF
-#define DCRD		S_D + D_D + HL + DECLOP + ZSF
-#define DCRE		S_E + D_E + HL + DECLOP + ZSF
-#define DCRH		S_H + D_H + HL + DECLOP + ZSF
-#define DCRL		S_L + D_L + HL + DECLOP + ZSF
-#define DCRM1		S_M + D_MAH + HL + DECLOP + ZSF				// memory to temporary MAH, decrementing
-#define DCRM2		S_MAH + D_M + HL + BYPASS					// MAH to memory
-#define DCRA		S_A + D_A + HL + DECLOP + ZSF
+// the table with each distinct half stored once (seq -d name): most opcodes don't
+// test a condition, so both their halves are the same. name_index.raw maps (opcode,
+// condition), the top 9 bits of a ROM address, to a sequence and name_seq.raw holds
+// the sequences, 32 words each; the pair is expanded again and checked against the
+// flat table before either is written
 
+static uint32_t half_index[512];
+static uint32_t half_seq[512 * 32];
 
-// register to a ALU operations
-#define ADDB		S_B + D_A + HL + ADDOP + CARRYF + ZSF
-#define ADCB		S_B + D_A + HL + ADCOP + CARRYF + ZSF
-#define SUBB		S_B + D_A + HL + SUBOP + CARRYF + ZSF
-#define SBBB		S_B + D_A + HL + SBBOP + CARRYF + ZSF
-#define ANDB		S_B + D_A + HL + ANDOP + CARRYF + ZSF
-#define XORB		S_B + D_A + HL + XOROP + CARRYF + ZSF
-#define ORB			S_B + D_A + HL + OROP + CARRYF + ZSF
-#define CMPB		S_B + D_MAH + HL + CMPOP + CARRYF + ZSF
+static int dedup_halves (void)
+{
+	int n = 0;
 
-#define ADDC		S_C + D_A + HL + ADDOP + CARRYF + ZSF
-#define ADCC		S_C + D_A + HL + ADCOP + CARRYF + ZSF
-#define SUBC		S_C + D_A + HL + SUBOP + CARRYF + ZSF
-#define SBBC		S_C + D_A + HL + SBBOP + CARRYF + ZSF
-#define ANDC		S_C + D_A + HL + ANDOP + CARRYF + ZSF
-#define XORC		S_C + D_A + HL + XOROP + CARRYF + ZSF
-#define ORC			S_C + D_A + HL + OROP + CARRYF + ZSF
-#define CMPC		S_C + D_MAH + HL + CMPOP + CARRYF + ZSF
+	for (int half = 0; half < 512; half++)
+	{
+		int s = 0;
+		while ((s < n) && (memcmp (&half_seq[s * 32], &table[half * 32], 32 * sizeof (uint32_t)) != 0))
+		{
+			s++;
+		}
+		if (s == n)
+		{
+			memcpy (&half_seq[n * 32], &table[half * 32], 32 * sizeof (uint32_t));
+			n++;
+		}
+		half_index[half] = s;
+	}
+	return n;
+}
 
-#define ADDD		S_D + D_A + HL + ADDOP + CARRYF + ZSF
-#define ADCD		S_D + D_A + HL + ADCOP + CARRYF + ZSF
-#define SUBD		S_D + D_A + HL + SUBOP + CARRYF + ZSF
-#define SBBD		S_D + D_A + HL + SBBOP + CARRYF + ZSF
-#define ANDD		S_D + D_A + HL + ANDOP + CARRYF + ZSF
-#define XORD		S_D + D_A + HL + XOROP + CARRYF + ZSF
-#define ORD			S_D + D_A + HL + OROP + CARRYF + ZSF
-#define CMPD		S_D + D_MAH + HL + CMPOP + CARRYF + ZSF
+static bool check_halves (void)
+{
+	for (int i = 0; i < (64 * 256); i++)
+	{
+		if (half_seq[(half_index[i / 32] * 32) + (i % 32)] != table[i])
+		{
+			fprintf (stderr, "Sequence table differs from the control table at %04x\n", i);
+			return false;
+		}
+	}
+	return true;
+}
 
-#define ADDE		S_E + D_A + HL + ADDOP + CARRYF + ZSF
-#define ADCE		S_E + D_A + HL + ADCOP + CARRYF + ZSF
-#define SUBE		S_E + D_A + HL + SUBOP + CARRYF + ZSF
-#define SBBE		S_E + D_A + HL + SBBOP + CARRYF + ZSF
-#define ANDE		S_E + D_A + HL + ANDOP + CARRYF + ZSF
-#define XORE		S_E + D_A + HL + XOROP + CARRYF + ZSF
-#define ORE			S_E + D_A + HL + OROP + CARRYF + ZSF
-#define CMPE		S_E + D_MAH + HL + CMPOP + CARRYF + ZSF
+// a "v2.0 raw" image of n words, each written with the given number of hex digits
+static bool write_raw (const char *path, const uint32_t *words, int n, int digits)
+{
+	FILE *f = fopen (path, "w");
+	if (f == NULL)
+	{
+		fprintf (stderr, "Can't write %s\n", path);
+		return false;
+	}
+	fprintf (f, "v2.0 raw\n");
+	for (int i = 0; i < n; i++)
+	{
+		fprintf (f, "%0*x%s", digits, words[i], ((i % 8) == 7) ? " \n" : " ");
+	}
+	if (fclose (f) != 0)
+	{
+		fprintf (stderr, "Can't write %s\n", path);
+		return false;
+	}
+	return true;
+}
 
-#define ADDH		S_H + D_A + HL + ADDOP + CARRYF + ZSF
-#define ADCH		S_H + D_A + HL + ADCOP + CARRYF + ZSF
-#define SUBH		S_H + D_A + HL + SUBOP + CARRYF + ZSF
-#define SBBH		S_H + D_A + HL + SBBOP + CARRYF + ZSF
-#define ANDH		S_H + D_A + HL + ANDOP + CARRYF + ZSF
-#define XORH		S_H + D_A + HL + XOROP + CARRYF + ZSF
-#define ORH			S_H + D_A + HL + OROP + CARRYF + ZSF
-#define CMPH		S_H + D_MAH + HL + CMPOP + CARRYF + ZSF
+static int emit_halves (const char *name)
+{
+	char path[1024];
+	int n = dedup_halves ();
 
-#define ADDL		S_L + D_A + HL + ADDOP + CARRYF + ZSF
-#define ADCL		S_L + D_A + HL + ADCOP + CARRYF + ZSF
-#define SUBL		S_L + D_A + HL + SUBOP + CARRYF + ZSF
-#define SBBL		S_L + D_A + HL + SBBOP + CARRYF + ZSF
-#define ANDL		S_L + D_A + HL + ANDOP + CARRYF + ZSF
-#define XORL		S_L + D_A + HL + XOROP + CARRYF + ZSF
-#define ORL			S_L + D_A + HL + OROP + CARRYF + ZSF
-#define CMPL		S_L + D_MAH + HL + CMPOP + CARRYF + ZSF
+	if (!check_halves ())
+	{
+		return 1;
+	}
+	snprintf (path, sizeof (path), "%s_index.raw", name);
+	if (!write_raw (path, half_index, 512, 3))
+	{
+		return 1;
+	}
+	snprintf (path, sizeof (path), "%s_seq.raw", name);
+	if (!write_raw (path, half_seq, n * 32, 8))
+	{
+		return 1;
+	}
+	printf ("%d sequences for 512 halves, %d words instead of %d\n", n, n * 32, 64 * 256);
+	return 0;
+}
 
-#define ADDM		S_M + D_A + HL + ADDOP + CARRYF + ZSF
-#define ADCM		S_M + D_A + HL + ADCOP + CARRYF + ZSF
-#define SUBM		S_M + D_A + HL + SUBOP + CARRYF + ZSF
-#define SBBM		S_M + D_A + HL + SBBOP + CARRYF + ZSF
-#define ANDM		S_M + D_A + HL + ANDOP + CARRYF + ZSF
-#define XORM		S_M + D_A + HL + XOROP + CARRYF + ZSF
-#define ORM			S_M + D_A + HL + OROP + CARRYF + ZSF
-#define CMPM		S_M + D_MAH + HL + CMPOP + CARRYF + ZSF
+// two level nanocode (seq -n name): the sequencer ROM holds only the number of each
+// slot's control word and a nanocode ROM holds the distinct words, so name_micro.raw
+// is 16384 entries as wide as a word number and name_nano.raw is a few hundred full
+// words. Words are numbered in order of value, so the unused slots, being zero, are
+// zero in both. Every slot is read back through the pair and compared with the flat
+// table before either is written, which for a table this size is the whole proof
 
-#define ADDA		S_A + D_A + HL + ADDOP + CARRYF + ZSF
-#define ADCA		S_A + D_A + HL + ADCOP + CARRYF + ZSF
-#define SUBA		S_A + D_A + HL + SUBOP + CARRYF + ZSF
-#define SBBA		S_A + D_A + HL + SBBOP + CARRYF + ZSF
-#define ANDA		S_A + D_A + HL + ANDOP + CARRYF + ZSF
-#define XORA		S_A + D_A + HL + XOROP + CARRYF + ZSF
-#define ORA			S_A + D_A + HL + OROP + CARRYF + ZSF
-#define CMPA		S_A + D_MAH + HL + CMPOP + CARRYF + ZSF
+static uint32_t nano[64 * 256];
+static uint32_t micro[64 * 256];
 
+static int compare_words (const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *) a;
+	uint32_t y = *(const uint32_t *) b;
 
+	return (x > y) - (x < y);
+}
 
-// register-register moves
-#define MOVBB		S_B + D_B +	HL + BYPASS
-#define MOVBC		S_C + D_B +	HL + BYPASS
-#define MOVBD		S_D + D_B +	HL + BYPASS
-#define MOVBE		S_E + D_B +	HL + BYPASS
-#define MOVBH		S_H + D_B +	HL + BYPASS
-#define MOVBL		S_L + D_B +	HL + BYPASS
-#define MOVBM		S_M + D_B +	HL + BYPASS
-#define MOVBA		S_A + D_B +	HL + BYPASS
+static int emit_nanocode (const char *name)
+{
+	char path[1024];
+	int words = 0;
+	int width = 0;
 
-#define MOVCB		S_B + D_C +	HL + BYPASS
-#define MOVCC		S_C + D_C +	HL + BYPASS
-#define MOVCD		S_D + D_C +	HL + BYPASS
-#define MOVCE		S_E + D_C +	HL + BYPASS
-#define MOVCH		S_H + D_C +	HL + BYPASS
-#define MOVCL		S_L + D_C +	HL + BYPASS
-#define MOVCM		S_M + D_C +	HL + BYPASS
-#define MOVCA		S_A + D_C +	HL + BYPASS
+	memcpy (nano, table, sizeof (nano));
+	qsort (nano, 64 * 256, sizeof (uint32_t), compare_words);
+	for (int i = 0; i < (64 * 256); i++)
+	{
+		if ((i == 0) || (nano[i] != nano[words - 1]))
+		{
+			nano[words++] = nano[i];
+		}
+	}
+	while ((1 << width) < words)
+	{
+		width++;
+	}
 
-#define MOVDB		S_B + D_D +	HL + BYPASS
-#define MOVDC		S_C + D_D +	HL + BYPASS
-#define MOVDD		S_D + D_D +	HL + BYPASS
-#define MOVDE		S_E + D_D +	HL + BYPASS
-#define MOVDH		S_H + D_D +	HL + BYPASS
-#define MOVDL		S_L + D_D +	HL + BYPASS
-#define MOVDM		S_M + D_D +	HL + BYPASS
-#define MOVDA		S_A + D_D +	HL + BYPASS
+	for (int i = 0; i < (64 * 256); i++)
+	{
+		uint32_t *w = bsearch (&table[i], nano, words, sizeof (uint32_t), compare_words);
+		micro[i] = (uint32_t) (w - nano);
+	}
+	for (int i = 0; i < (64 * 256); i++)
+	{
+		if ((micro[i] >= (uint32_t) words) || (nano[micro[i]] != table[i]))
+		{
+			fprintf (stderr, "Nanocode differs from the control table at %04x\n", i);
+			return 1;
+		}
+	}
 
-#define MOVEB		S_B + D_E +	HL + BYPASS
-#define MOVEC		S_C + D_E +	HL + BYPASS
-#define MOVED		S_D + D_E +	HL + BYPASS
-#define MOVEE		S_E + D_E +	HL + BYPASS
-#define MOVEH		S_H + D_E +	HL + BYPASS
-#define MOVEL		S_L + D_E +	HL + BYPASS
-#define MOVEM		S_M + D_E +	HL + BYPASS
-#define MOVEA		S_A + D_E +	HL + BYPASS
+	snprintf (path, sizeof (path), "%s_micro.raw", name);
+	if (!write_raw (path, micro, 64 * 256, (width + 3) / 4))
+	{
+		return 1;
+	}
+	snprintf (path, sizeof (path), "%s_nano.raw", name);
+	if (!write_raw (path, nano, words, 8))
+	{
+		return 1;
+	}
+	printf ("all %d slots match through %d distinct words\n", 64 * 256, words);
+	printf ("sequencer ROM %d bits wide, nanocode ROM %d x 32: %d bits instead of %d\n",
+		width, words, (64 * 256 * width) + (words * 32), 64 * 256 * 32);
+	return 0;
+}
+
+// cycle report (seq -t [profile]): the microsteps each opcode takes, step 0 to its
+// LAST, in its condition false and true halves, next to the Intel 8080's T-states for
+// the same, and the ratio of the two. The totals count every half once, or as often
+// as the profile says it ran: lines of "op cond count", the opcode in hex, with #
+// comments, as sim -P writes them, and then how often each opcode ran and where
+// shorter sequences would gain most. Opcodes marked * are undocumented aliases. With a
+// variant the steps control.h takes are shown too, and totalled on a line of their own
 
-#define MOVHB		S_B + D_H +	HL + BYPASS
-#define MOVHC		S_C + D_H +	HL + BYPASS
-#define MOVHD		S_D + D_H +	HL + BYPASS
-#define MOVHE		S_E + D_H +	HL + BYPASS
-#define MOVHH		S_H + D_H +	HL + BYPASS
-#define MOVHL		S_L + D_H +	HL + BYPASS
-#define MOVHM		S_M + D_H +	HL + BYPASS
-#define MOVHA		S_A + D_H +	HL + BYPASS
+static const struct
+{
+	const char *name;
+	int t[2];				// T-states with the condition false and true
+} intel[256] =
+{
+	{ "NOP", { 4, 4 } }, { "LXI B", { 10, 10 } }, { "STAX B", { 7, 7 } }, { "INX B", { 5, 5 } },
+	{ "INR B", { 5, 5 } }, { "DCR B", { 5, 5 } }, { "MVI B", { 7, 7 } }, { "RLC", { 4, 4 } },
+	{ "*NOP", { 4, 4 } }, { "DAD B", { 10, 10 } }, { "LDAX B", { 7, 7 } }, { "DCX B", { 5, 5 } },
+	{ "INR C", { 5, 5 } }, { "DCR C", { 5, 5 } }, { "MVI C", { 7, 7 } }, { "RRC", { 4, 4 } },
+	{ "*NOP", { 4, 4 } }, { "LXI D", { 10, 10 } }, { "STAX D", { 7, 7 } }, { "INX D", { 5, 5 } },
+	{ "INR D", { 5, 5 } }, { "DCR D", { 5, 5 } }, { "MVI D", { 7, 7 } }, { "RAL", { 4, 4 } },
+	{ "*NOP", { 4, 4 } }, { "DAD D", { 10, 10 } }, { "LDAX D", { 7, 7 } }, { "DCX D", { 5, 5 } },
+	{ "INR E", { 5, 5 } }, { "DCR E", { 5, 5 } }, { "MVI E", { 7, 7 } }, { "RAR", { 4, 4 } },
+	{ "*NOP", { 4, 4 } }, { "LXI H", { 10, 10 } }, { "SHLD", { 16, 16 } }, { "INX H", { 5, 5 } },
+	{ "INR H", { 5, 5 } }, { "DCR H", { 5, 5 } }, { "MVI H", { 7, 7 } }, { "DAA", { 4, 4 } },
+	{ "*NOP", { 4, 4 } }, { "DAD H", { 10, 10 } }, { "LHLD", { 16, 16 } }, { "DCX H", { 5, 5 } },
+	{ "INR L", { 5, 5 } }, { "DCR L", { 5, 5 } }, { "MVI L", { 7, 7 } }, { "CMA", { 4, 4 } },
+	{ "*NOP", { 4, 4 } }, { "LXI SP", { 10, 10 } }, { "STA", { 13, 13 } }, { "INX SP", { 5, 5 } },
+	{ "INR M", { 10, 10 } }, { "DCR M", { 10, 10 } }, { "MVI M", { 10, 10 } }, { "STC", { 4, 4 } },
+	{ "*NOP", { 4, 4 } }, { "DAD SP", { 10, 10 } }, { "LDA", { 13, 13 } }, { "DCX SP", { 5, 5 } },
+	{ "INR A", { 5, 5 } }, { "DCR A", { 5, 5 } }, { "MVI A", { 7, 7 } }, { "CMC", { 4, 4 } },
+	{ "MOV B,B", { 5, 5 } }, { "MOV B,C", { 5, 5 } }, { "MOV B,D", { 5, 5 } }, { "MOV B,E", { 5, 5 } },
+	{ "MOV B,H", { 5, 5 } }, { "MOV B,L", { 5, 5 } }, { "MOV B,M", { 7, 7 } }, { "MOV B,A", { 5, 5 } },
+	{ "MOV C,B", { 5, 5 } }, { "MOV C,C", { 5, 5 } }, { "MOV C,D", { 5, 5 } }, { "MOV C,E", { 5, 5 } },
+	{ "MOV C,H", { 5, 5 } }, { "MOV C,L", { 5, 5 } }, { "MOV C,M", { 7, 7 } }, { "MOV C,A", { 5, 5 } },
+	{ "MOV D,B", { 5, 5 } }, { "MOV D,C", { 5, 5 } }, { "MOV D,D", { 5, 5 } }, { "MOV D,E", { 5, 5 } },
+	{ "MOV D,H", { 5, 5 } }, { "MOV D,L", { 5, 5 } }, { "MOV D,M", { 7, 7 } }, { "MOV D,A", { 5, 5 } },
+	{ "MOV E,B", { 5, 5 } }, { "MOV E,C", { 5, 5 } }, { "MOV E,D", { 5, 5 } }, { "MOV E,E", { 5, 5 } },
+	{ "MOV E,H", { 5, 5 } }, { "MOV E,L", { 5, 5 } }, { "MOV E,M", { 7, 7 } }, { "MOV E,A", { 5, 5 } },
+	{ "MOV H,B", { 5, 5 } }, { "MOV H,C", { 5, 5 } }, { "MOV H,D", { 5, 5 } }, { "MOV H,E", { 5, 5 } },
+	{ "MOV H,H", { 5, 5 } }, { "MOV H,L", { 5, 5 } }, { "MOV H,M", { 7, 7 } }, { "MOV H,A", { 5, 5 } },
+	{ "MOV L,B", { 5, 5 } }, { "MOV L,C", { 5, 5 } }, { "MOV L,D", { 5, 5 } }, { "MOV L,E", { 5, 5 } },
+	{ "MOV L,H", { 5, 5 } }, { "MOV L,L", { 5, 5 } }, { "MOV L,M", { 7, 7 } }, { "MOV L,A", { 5, 5 } },
+	{ "MOV M,B", { 7, 7 } }, { "MOV M,C", { 7, 7 } }, { "MOV M,D", { 7, 7 } }, { "MOV M,E", { 7, 7 } },
+	{ "MOV M,H", { 7, 7 } }, { "MOV M,L", { 7, 7 } }, { "HLT", { 7, 7 } }, { "MOV M,A", { 7, 7 } },
+	{ "MOV A,B", { 5, 5 } }, { "MOV A,C", { 5, 5 } }, { "MOV A,D", { 5, 5 } }, { "MOV A,E", { 5, 5 } },
+	{ "MOV A,H", { 5, 5 } }, { "MOV A,L", { 5, 5 } }, { "MOV A,M", { 7, 7 } }, { "MOV A,A", { 5, 5 } },
+	{ "ADD B", { 4, 4 } }, { "ADD C", { 4, 4 } }, { "ADD D", { 4, 4 } }, { "ADD E", { 4, 4 } },
+	{ "ADD H", { 4, 4 } }, { "ADD L", { 4, 4 } }, { "ADD M", { 7, 7 } }, { "ADD A", { 4, 4 } },
+	{ "ADC B", { 4, 4 } }, { "ADC C", { 4, 4 } }, { "ADC D", { 4, 4 } }, { "ADC E", { 4, 4 } },
+	{ "ADC H", { 4, 4 } }, { "ADC L", { 4, 4 } }, { "ADC M", { 7, 7 } }, { "ADC A", { 4, 4 } },
+	{ "SUB B", { 4, 4 } }, { "SUB C", { 4, 4 } }, { "SUB D", { 4, 4 } }, { "SUB E", { 4, 4 } },
+	{ "SUB H", { 4, 4 } }, { "SUB L", { 4, 4 } }, { "SUB M", { 7, 7 } }, { "SUB A", { 4, 4 } },
+	{ "SBB B", { 4, 4 } }, { "SBB C", { 4, 4 } }, { "SBB D", { 4, 4 } }, { "SBB E", { 4, 4 } },
+	{ "SBB H", { 4, 4 } }, { "SBB L", { 4, 4 } }, { "SBB M", { 7, 7 } }, { "SBB A", { 4, 4 } },
+	{ "ANA B", { 4, 4 } }, { "ANA C", { 4, 4 } }, { "ANA D", { 4, 4 } }, { "ANA E", { 4, 4 } },
+	{ "ANA H", { 4, 4 } }, { "ANA L", { 4, 4 } }, { "ANA M", { 7, 7 } }, { "ANA A", { 4, 4 } },
+	{ "XRA B", { 4, 4 } }, { "XRA C", { 4, 4 } }, { "XRA D", { 4, 4 } }, { "XRA E", { 4, 4 } },
+	{ "XRA H", { 4, 4 } }, { "XRA L", { 4, 4 } }, { "XRA M", { 7, 7 } }, { "XRA A", { 4, 4 } },
+	{ "ORA B", { 4, 4 } }, { "ORA C", { 4, 4 } }, { "ORA D", { 4, 4 } }, { "ORA E", { 4, 4 } },
+	{ "ORA H", { 4, 4 } }, { "ORA L", { 4, 4 } }, { "ORA M", { 7, 7 } }, { "ORA A", { 4, 4 } },
+	{ "CMP B", { 4, 4 } }, { "CMP C", { 4, 4 } }, { "CMP D", { 4, 4 } }, { "CMP E", { 4, 4 } },
+	{ "CMP H", { 4, 4 } }, { "CMP L", { 4, 4 } }, { "CMP M", { 7, 7 } }, { "CMP A", { 4, 4 } },
+	{ "RNZ", { 5, 11 } }, { "POP B", { 10, 10 } }, { "JNZ", { 10, 10 } }, { "JMP", { 10, 10 } },
+	{ "CNZ", { 11, 17 } }, { "PUSH B", { 11, 11 } }, { "ADI", { 7, 7 } }, { "RST 0", { 11, 11 } },
+	{ "RZ", { 5, 11 } }, { "RET", { 10, 10 } }, { "JZ", { 10, 10 } }, { "*JMP", { 10, 10 } },
+	{ "CZ", { 11, 17 } }, { "CALL", { 17, 17 } }, { "ACI", { 7, 7 } }, { "RST 1", { 11, 11 } },
+	{ "RNC", { 5, 11 } }, { "POP D", { 10, 10 } }, { "JNC", { 10, 10 } }, { "OUT", { 10, 10 } },
+	{ "CNC", { 11, 17 } }, { "PUSH D", { 11, 11 } }, { "SUI", { 7, 7 } }, { "RST 2", { 11, 11 } },
+	{ "RC", { 5, 11 } }, { "*RET", { 10, 10 } }, { "JC", { 10, 10 } }, { "IN", { 10, 10 } },
+	{ "CC", { 11, 17 } }, { "*CALL", { 17, 17 } }, { "SBI", { 7, 7 } }, { "RST 3", { 11, 11 } },
+	{ "RPO", { 5, 11 } }, { "POP H", { 10, 10 } }, { "JPO", { 10, 10 } }, { "XTHL", { 18, 18 } },
+	{ "CPO", { 11, 17 } }, { "PUSH H", { 11, 11 } }, { "ANI", { 7, 7 } }, { "RST 4", { 11, 11 } },
+	{ "RPE", { 5, 11 } }, { "PCHL", { 5, 5 } }, { "JPE", { 10, 10 } }, { "XCHG", { 4, 4 } },
+	{ "CPE", { 11, 17 } }, { "*CALL", { 17, 17 } }, { "XRI", { 7, 7 } }, { "RST 5", { 11, 11 } },
+	{ "RP", { 5, 11 } }, { "POP PSW", { 10, 10 } }, { "JP", { 10, 10 } }, { "DI", { 4, 4 } },
+	{ "CP", { 11, 17 } }, { "PUSH PSW", { 11, 11 } }, { "ORI", { 7, 7 } }, { "RST 6", { 11, 11 } },
+	{ "RM", { 5, 11 } }, { "SPHL", { 5, 5 } }, { "JM", { 10, 10 } }, { "EI", { 4, 4 } },
+	{ "CM", { 11, 17 } }, { "*CALL", { 17, 17 } }, { "CPI", { 7, 7 } }, { "RST 7", { 11, 11 } },
+};
 
-#define MOVLB		S_B + D_L +	HL + BYPASS
-#define MOVLC		S_C + D_L +	HL + BYPASS
-#define MOVLD		S_D + D_L +	HL + BYPASS
-#define MOVLE		S_E + D_L +	HL + BYPASS
-#define MOVLH		S_H + D_L +	HL + BYPASS
-#define MOVLL		S_L + D_L +	HL + BYPASS
-#define MOVLM		S_M + D_L +	HL + BYPASS
-#define MOVLA		S_A + D_L +	HL + BYPASS
+// the totals line for one table
+static void cycle_totals (const char *what, uint64_t steps, uint64_t states, uint64_t runs)
+{
+	printf ("%s: %llu steps, %llu T-states, ratio %.3f", what,
+		(unsigned long long) steps, (unsigned long long) states, states ? (double) steps / states : 0.0);
+	if (runs)
+	{
+		printf (", %.2f steps and %.2f T-states an instruction", (double) steps / runs, (double) states / runs);
+	}
+	printf ("\n");
+}
 
-#define MOVMB		S_B + D_M +	HL + BYPASS
-#define MOVMC		S_C + D_M +	HL + BYPASS
-#define MOVMD		S_D + D_M +	HL + BYPASS
-#define MOVME		S_E + D_M +	HL + BYPASS
-#define MOVMH		S_H + D_M +	HL + BYPASS
-#define MOVML		S_L + D_M +	HL + BYPASS
-//#define MOVMM		S_M + D_M +	HL + BYPASS		// no, you can't do this!
-#define MOVMA		S_A + D_M +	HL + BYPASS
+// the opcodes that would gain most from shorter sequences on the profile: the steps
+// each spent past its fetch and one more, which is as much as shortening it could
+// save, and what one step less in both halves would
+static void suggest (uint64_t steps)
+{
+	int order[256];
+	uint64_t room[256];
 
-#define MOVAB		S_B + D_A +	HL + BYPASS
-#define MOVAC		S_C + D_A +	HL + BYPASS
-#define MOVAD		S_D + D_A +	HL + BYPASS
-#define MOVAE		S_E + D_A +	HL + BYPASS
-#define MOVAH		S_H + D_A +	HL + BYPASS
-#define MOVAL		S_L + D_A +	HL + BYPASS
-#define MOVAM		S_M + D_A +	HL + BYPASS
-#define MOVAA		S_A + D_A +	HL + BYPASS
+	for (int op = 0; op < 256; op++)
+	{
+		room[op] = 0;
+		for (int half = op * 2; half < (op * 2) + 2; half++)
+		{
+			int n = half_length (table, half);
+			room[op] += runs[half] * ((n > 2) ? n - 2 : 0);
+		}
 
+		// insertion sort, most room first
+		int i = op;
+		while ((i > 0) && (room[order[i - 1]] < room[op]))
+		{
+			order[i] = order[i - 1];
+			i--;
+		}
+		order[i] = op;
+	}
 
+	printf ("\nwhere shorter sequences would gain most:\n");
+	printf ("op  instruction        runs  steps  past two   one less saves\n");
+	for (int i = 0; (i < 12) && room[order[i]]; i++)
+	{
+		int op = order[i];
+		int n[2] = { half_length (table, op * 2), half_length (table, (op * 2) + 1) };
+		char length[16];
+		snprintf (length, sizeof (length), (n[0] == n[1]) ? "%d" : "%d/%d", n[0], n[1]);
+		printf ("%02x  %-11s  %10llu  %5s  %8.1f%%  %8.1f%%\n", op, intel[op].name,
+			(unsigned long long) (runs[op * 2] + runs[(op * 2) + 1]), length,
+			100.0 * room[op] / steps, 100.0 * (runs[op * 2] + runs[(op * 2) + 1]) / steps);
+	}
+}
 
-// now build the control seqences, fill unused slots with zeros
-// the first 32 entries in each named block are for the condition false
-// instructions and the second 32 for the condition true
-// these are only different for the conditional call, jump, returns
+static int emit_cycles (const char *path)
+{
+	uint64_t steps = 0;
+	uint64_t was = 0;
+	uint64_t states = 0;
+	uint64_t instructions = 0;
+	bool compare = applied_count > 0;
 
-#include <stdio.h>
-#include <stdbool.h>
-#include <stdint.h>
+	if (path != NULL)
+	{
+		if (!read_profile (path))
+		{
+			return 1;
+		}
+	}
+	else
+	{
+		for (int half = 0; half < 512; half++)
+		{
+			runs[half] = 1;
+		}
+	}
+	for (int half = 0; half < 512; half++)
+	{
+		steps += runs[half] * half_length (table, half);
+	}
+
+	printf ("op  instruction  steps       T-states    ratio     %s%s\n", compare ? "  control.h" : "",
+		(path != NULL) ? "        runs  of steps" : "");
+	printf ("                 false true  false true  false true%s\n", compare ? "  false true" : "");
+	for (int op = 0; op < 256; op++)
+	{
+		int n[2] = { half_length (table, op * 2), half_length (table, (op * 2) + 1) };
+		int base[2] = { half_length (control, op * 2), half_length (control, (op * 2) + 1) };
+		uint64_t *count = &runs[op * 2];
+		printf ("%02x  %-11s  %5d %4d  %5d %4d  %5.2f %4.2f", op, intel[op].name, n[0], n[1],
+			intel[op].t[0], intel[op].t[1], (double) n[0] / intel[op].t[0], (double) n[1] / intel[op].t[1]);
+		if (compare)
+		{
+			printf ("  %5d %4d", base[0], base[1]);
+		}
+		if ((path != NULL) && (count[0] + count[1]))
+		{
+			printf ("  %10llu  %7.2f%%", (unsigned long long) (count[0] + count[1]),
+				100.0 * ((count[0] * n[0]) + (count[1] * n[1])) / steps);
+		}
+		printf ("\n");
+		for (int cond = 0; cond < 2; cond++)
+		{
+			was += count[cond] * base[cond];
+			states += count[cond] * intel[op].t[cond];
+			instructions += count[cond];
+		}
+	}
+
+	printf ("\n");
+	cycle_totals ((path != NULL) ? path : "every half once", steps, states, instructions);
+	if (compare)
+	{
+		cycle_totals ("control.h", was, states, instructions);
+		printf ("the variant saves %.1f%% of the steps\n", was ? 100.0 * ((double) was - (double) steps) / was : 0.0);
+	}
+	if ((path != NULL) && steps)
+	{
+		suggest (steps);
+	}
+	return 0;
+}
 
-static uint32_t control [(64 * 256)] =
+// the table as Logisim writes rom contents: hex without leading zeros, eight tokens to
+// a line, every run written as N*value where that's no longer than writing it out,
+// and the zeroes at the end left off since Logisim fills them in
+static size_t format_contents (char *out)
 {
-// 0x00 - NOP
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,LDA,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,LDA,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x01 - LXI B
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	LXIB1,
-	INC_PCL,
-	INC_PCH,
-	LXIB2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	LXIB1,
-	INC_PCL,
-	INC_PCH,
-	LXIB2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x02 - STAX B
-	LD_IR,
-	C2MAL,
-	B2MAH,
-	STAX,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	C2MAL,
-	B2MAH,
-	STAX,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x03 - INXB
-	LD_IR,
-	INXB1,
-	INXB2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INXB1,
-	INXB2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x04 - INR B
-	LD_IR,
-	INRB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INRB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x05 - DEC B
-	LD_IR,
-	DCRB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DCRB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x06 - MVI B
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	MVIB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	MVIB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x07 - RLC
-	LD_IR,
-	RLC1,
-	RLC2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	RLC1,
-	RLC2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x08 - NOP
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x09 - DAD B
-	LD_IR,
-	DAD1,
-	DADB2,
-	DADB3,
-	DADB4,
-	DADB5,
-	DAD6,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DAD1,
-	DADB2,
-	DADB3,
-	DADB4,
-	DADB5,
-	DAD6,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x0a - LDAX B
-	LD_IR,
-	C2MAL,
-	B2MAH,
-	LDAX,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	C2MAL,
-	B2MAH,
-	LDAX,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x0b - DCX B
-	LD_IR,
-	DCXB1,
-	DCXB2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DCXB1,
-	DCXB2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x0c - INR C
-	LD_IR,
-	INRC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INRC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x0d - DCR C
-	LD_IR,
-	DCRC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DCRC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x0e - MVI C
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	MVIC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	MVIC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x0f - RRC
-	LD_IR,
-	RRC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	RRC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x10 - NOP
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x11 - LXI D
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	LXID1,
-	INC_PCL,
-	INC_PCH,
-	LXID2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	LXID1,
-	INC_PCL,
-	INC_PCH,
-	LXID2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x12 - STAX D
-	LD_IR,
-	E2MAL,
-	D2MAH,
-	STAX,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	E2MAL,
-	D2MAH,
-	STAX,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x13 - INXD
-	LD_IR,
-	INXD1,
-	INXD2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INXD1,
-	INXD2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x14 - INR D
-	LD_IR,
-	INRD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INRD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x15 - DCR D
-	LD_IR,
-	DCRD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DCRD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x16 - MVI D
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	MVID,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	MVID,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x17 - RAL
-	LD_IR,
-	RAL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	RAL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x18 - NOP
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x19 - DAD D
-	LD_IR,
-	DAD1,
-	DADD2,
-	DADD3,
-	DADD4,
-	DADD5,
-	DAD6,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DAD1,
-	DADD2,
-	DADD3,
-	DADD4,
-	DADD5,
-	DAD6,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x1a - LDAX D
-	LD_IR,
-	E2MAL,
-	D2MAH,
-	LDAX,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	E2MAL,
-	D2MAH,
-	LDAX,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x1b - DCX D
-	LD_IR,
-	DCXD1,
-	DCXD2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DCXD1,
-	DCXD2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x1c - INR E
-	LD_IR,
-	INRE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INRE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x1d - DCR E
-	LD_IR,
-	DCRE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DCRE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x1e - MVI E
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	MVIE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	MVIE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x1f - RAR
-	LD_IR,
-	RAR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	RAR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x20 - NOP
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x21 - LXI H
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	LXIH1,
-	INC_PCL,
-	INC_PCH,
-	LXIH2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	LXIH1,
-	INC_PCL,
-	INC_PCH,
-	LXIH2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x22 - SHLD
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	M2MAL,
-	INC_PCL,
-	INC_PCH,
-	M2MAH,
-	SHLD1,
-	INC_MAL,
-	INC_MAH,
-	SHLD2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	M2MAL,
-	INC_PCL,
-	INC_PCH,
-	M2MAH,
-	SHLD1,
-	INC_MAL,
-	INC_MAH,
-	SHLD2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x23 - INXH
-	LD_IR,
-	INXH1,
-	INXH2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INXH1,
-	INXH2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x24 - INR H
-	LD_IR,
-	INRH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INRH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x25 - DCR H
-	LD_IR,
-	DCRH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DCRH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x26 - MVIH
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	MVIH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	MVIH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x27 - NOP (DAA)
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x28 - NOP
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x29 - DAD H
-	LD_IR,
-	DAD1,
-	DADH2,
-	DADH3,
-	DADH4,
-	DADH5,
-	DAD6,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DAD1,
-	DADH2,
-	DADH3,
-	DADH4,
-	DADH5,
-	DAD6,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x2A - LHLD
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	M2MAL,
-	INC_PCL,
-	INC_PCH,
-	M2MAH,
-	LHLD1,
-	INC_MAL,
-	INC_MAH,
-	LHLD2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	M2MAL,
-	INC_PCL,
-	INC_PCH,
-	M2MAH,
-	LHLD1,
-	INC_MAL,
-	INC_MAH,
-	LHLD2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x2b - DCX H
-	LD_IR,
-	DCXH1,
-	DCXH2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DCXH1,
-	DCXH2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x2c - INR L
-	LD_IR,
-	INRL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INRL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x2d - DCR L
-	LD_IR,
-	DCRL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DCRL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x2e - MVI L
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	MVIL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	MVIL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x2f - CMA
-	LD_IR,
-	CMA1,
-	CMA2,
-	CMA3,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	CMA1,
-	CMA2,
-	CMA3,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x30 - NOP
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x31 - LXI SP
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	LXISP1,
-	INC_PCL,
-	INC_PCH,
-	LXISP2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	LXISP1,
-	INC_PCL,
-	INC_PCH,
-	LXISP2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x32 - STA abs
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	M2MAL,
-	INC_PCL,
-	INC_PCH,
-	M2MAH,
-	STA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	M2MAL,
-	INC_PCL,
-	INC_PCH,
-	M2MAH,
-	STA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x33 - INX SP
-	LD_IR,
-	INXSP1,
-	INXSP2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INXSP1,
-	INXSP2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x34 - INR M
-	LD_IR,
-	INRM1,
-	INRM2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INRM1,
-	INRM2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x35 - DCR M
-	LD_IR,
-	DCRM1,
-	DCRM2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DCRM1,
-	DCRM2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x36 - MVI M
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	MVIM1,
-	MVIM2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	MVIM1,
-	MVIM2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x37 - STC
-	LD_IR,
-	STC1,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	STC1,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x38 - NOP
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x39 - DAD SP
-	LD_IR,
-	DAD1,
-	DADSP2,
-	DADSP3,
-	DADSP4,
-	DADSP5,
-	DAD6,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DAD1,
-	DADSP2,
-	DADSP3,
-	DADSP4,
-	DADSP5,
-	DAD6,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x3a - LDA abs
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	M2MAL,
-	INC_PCL,
-	INC_PCH,
-	M2MAH,
-	LDA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	M2MAL,
-	INC_PCL,
-	INC_PCH,
-	M2MAH,
-	LDA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x3b - DCX SP
-	LD_IR,
-	DCXSP1,
-	DCXSP2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DCXSP1,
-	DCXSP2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x3c - INR A
-	LD_IR,
-	INRA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INRA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x3d - DCR A
-	LD_IR,
-	DCRA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DCRA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x3e - MVI A
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	MVIA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	MVIA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x3f - CMC
-	LD_IR,
-	CMC1,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	CMC1,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0x40 - Mov B,B
-	LD_IR,
-	MOVBB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVBB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x41 - MOV B,C
-	LD_IR,
-	MOVBC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVBC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x42 - MOV B,D
-	LD_IR,
-	MOVBD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVBD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x43 - MOV B,E
-	LD_IR,
-	MOVBE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVBE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x44 - MOV B,H
-	LD_IR,
-	MOVBH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVBH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x45 - MOV B,L
-	LD_IR,
-	MOVBL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVBL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x46 - Mov B,M
-	LD_IR,
-	MOVBM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVBM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x47 - Mov B,A
-	LD_IR,
-	MOVBA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVBA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x48 - Mov C,B
-	LD_IR,
-	MOVCB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVCB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x49 - MOV C,C
-	LD_IR,
-	MOVCC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVCC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x4a - MOV C,D
-	LD_IR,
-	MOVCD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVCD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x4b - MOV C,E
-	LD_IR,
-	MOVCE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVCE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x4c - MOV C,H
-	LD_IR,
-	MOVCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x4d - MOV C,L
-	LD_IR,
-	MOVCL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVCL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x4e - Mov C,M
-	LD_IR,
-	MOVCM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVCM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x4f - Mov C,A
-	LD_IR,
-	MOVCA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVCA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x50 - Mov D,B
-	LD_IR,
-	MOVDB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVDB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x51 - MOV D,C
-	LD_IR,
-	MOVDC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVDC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x52 - MOV D,D
-	LD_IR,
-	MOVDD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVDD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x53 - MOV D,E
-	LD_IR,
-	MOVDE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVDE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x54 - MOV D,H
-	LD_IR,
-	MOVDH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVDH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x55 - MOV D,L
-	LD_IR,
-	MOVDL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVDL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x56 - Mov D,M
-	LD_IR,
-	MOVDM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVDM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x57 - Mov D,A
-	LD_IR,
-	MOVDA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVDA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x58 - Mov E,B
-	LD_IR,
-	MOVEB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVEB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x59 - MOV E,C
-	LD_IR,
-	MOVEC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVEC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x5a - MOV E,D
-	LD_IR,
-	MOVED,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVED,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x5b - MOV E,E
-	LD_IR,
-	MOVEE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVEE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x5c - MOV E,H
-	LD_IR,
-	MOVEH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVEH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x5d - MOV E,L
-	LD_IR,
-	MOVEL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVEL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x5e - Mov E,M
-	LD_IR,
-	MOVEM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVEM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x5f - Mov E,A
-	LD_IR,
-	MOVEA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVEA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x60 - Mov H,B
-	LD_IR,
-	MOVHB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVHB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x61 - MOV H,C
-	LD_IR,
-	MOVHC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVHC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x62 - MOV H,D
-	LD_IR,
-	MOVHD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVHD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x63 - MOV H,E
-	LD_IR,
-	MOVHE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVHE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x64 - MOV H,H
-	LD_IR,
-	MOVHH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVHH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x65 - MOV H,L
-	LD_IR,
-	MOVHL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVHL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x66 - Mov H,M
-	LD_IR,
-	MOVHM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVHM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x67 - Mov H,A
-	LD_IR,
-	MOVHA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVHA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x68 - Mov L,B
-	LD_IR,
-	MOVLB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVLB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x69 - MOV L,C
-	LD_IR,
-	MOVLC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVLC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x6a - MOV L,D
-	LD_IR,
-	MOVLD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVLD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x6b - MOV L,E
-	LD_IR,
-	MOVLE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVLE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x6c - MOV L,H
-	LD_IR,
-	MOVLH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVLH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x6d - MOV L,L
-	LD_IR,
-	MOVLL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVLL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x6e - Mov L,M
-	LD_IR,
-	MOVLM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVLM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x6f - Mov L,A
-	LD_IR,
-	MOVLA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVLA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x70 - Mov M,B
-	LD_IR,
-	MOVMB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVMB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x71 - MOV M,C
-	LD_IR,
-	MOVMC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVMC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x72 - MOV M,D
-	LD_IR,
-	MOVMD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVMD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x73 - MOV M,E
-	LD_IR,
-	MOVME,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVME,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x74 - MOV M,H
-	LD_IR,
-	MOVMH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVMH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x75 - MOV M,L
-	LD_IR,
-	MOVML,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVML,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x76 - NOP
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x77 - Mov M,A
-	LD_IR,
-	MOVMA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVMA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x78 - Mov A,B
-	LD_IR,
-	MOVAB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVAB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x79 - MOV A,C
-	LD_IR,
-	MOVAC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVAC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x7a - MOV A,D
-	LD_IR,
-	MOVAD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVAD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x7b - MOV A,E
-	LD_IR,
-	MOVAE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVAE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x7c - MOV A,H
-	LD_IR,
-	MOVAH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVAH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x7d - MOV A,L
-	LD_IR,
-	MOVAL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVAL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x7e - Mov A,M
-	LD_IR,
-	MOVAM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVAM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x7f - Mov A,A
-	LD_IR,
-	MOVAA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	MOVAA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x80 - ADD B
-	LD_IR,
-	ADDB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ADDB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x81 - ADD C
-	LD_IR,
-	ADDC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ADDC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x82 - ADD D
-	LD_IR,
-	ADDD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ADDD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x83 - ADD E
-	LD_IR,
-	ADDE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ADDE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x84 - ADD H
-	LD_IR,
-	ADDH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ADDH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x85 - ADD L
-	LD_IR,
-	ADDL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ADDL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x86 - ADD M
-	LD_IR,
-	ADDM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ADDM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x87 - ADD A
-	LD_IR,
-	ADDA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ADDA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x88 - ADC B
-	LD_IR,
-	ADCB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ADCB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x89 - ADC C
-	LD_IR,
-	ADCC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ADCC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x8a - ADC D
-	LD_IR,
-	ADCD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ADCD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x8b - ADC E
-	LD_IR,
-	ADCE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ADCE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x8c - ADC H
-	LD_IR,
-	ADCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ADCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x8d - ADC L
-	LD_IR,
-	ADCL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ADCL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x8e - ADC M
-	LD_IR,
-	ADCM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ADCM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x8f - ADC A
-	LD_IR,
-	ADCA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ADCA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x90 - SUB B
-	LD_IR,
-	SUBB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	SUBB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x91 - SUB C
-	LD_IR,
-	SUBC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	SUBC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x92 - SUB D
-	LD_IR,
-	SUBD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	SUBD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x93 - SUB E
-	LD_IR,
-	SUBE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	SUBE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x94 - SUB H
-	LD_IR,
-	SUBH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	SUBH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x95 - SUB L
-	LD_IR,
-	SUBL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	SUBL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x96 - SUB M
-	LD_IR,
-	SUBM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	SUBM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x97 - SUB A
-	LD_IR,
-	SUBA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	SUBA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x98 - SBB B
-	LD_IR,
-	SBBB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	SBBB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x99 - SBB C
-	LD_IR,
-	SBBC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	SBBC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x9a - SBB D
-	LD_IR,
-	SBBD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	SBBD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x9b - SBB E
-	LD_IR,
-	SBBE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	SBBE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x9c - SBB H
-	LD_IR,
-	SBBH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	SBBH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x9d - SBB L
-	LD_IR,
-	SBBL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	SBBL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x9e - SBB M
-	LD_IR,
-	SBBM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	SBBM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0x9f - SBB A
-	LD_IR,
-	SBBA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	SBBA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xa0 - AND B
-	LD_IR,
-	ANDB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ANDB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xa1 - AND C
-	LD_IR,
-	ANDC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ANDC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xa2 - AND D
-	LD_IR,
-	ANDD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ANDD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xa3 - AND E
-	LD_IR,
-	ANDE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ANDE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xa4 - AND H
-	LD_IR,
-	ANDH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ANDH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xa5 - AND L
-	LD_IR,
-	ANDL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ANDL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xa6 - AND M
-	LD_IR,
-	ANDM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ANDM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xa7 - AND A
-	LD_IR,
-	ANDA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ANDA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xa8 - XOR B
-	LD_IR,
-	XORB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	XORB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xa9 - XOR C
-	LD_IR,
-	XORC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	XORC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xaa - XOR D
-	LD_IR,
-	XORD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	XORD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xab - XOR E
-	LD_IR,
-	XORE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	XORE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xac - XOR H
-	LD_IR,
-	XORH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	XORH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xad - XOR L
-	LD_IR,
-	XORL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	XORL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xae - XOR M
-	LD_IR,
-	XORM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	XORM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xaf - XOR A
-	LD_IR,
-	XORA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	XORA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xb0 - OR B
-	LD_IR,
-	ORB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ORB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xb1 - OR C
-	LD_IR,
-	ORC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ORC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xb2 - OR D
-	LD_IR,
-	ORD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ORD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xb3 - OR E
-	LD_IR,
-	ORE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ORE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xb4 - OR H
-	LD_IR,
-	ORH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ORH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xb5 - OR L
-	LD_IR,
-	ORL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ORL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xb6 - OR M
-	LD_IR,
-	ORM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ORM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xb7 - OR A
-	LD_IR,
-	ORA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	ORA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xb8 - CMP B
-	LD_IR,
-	CMPB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	CMPB,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xb9 - CMP C
-	LD_IR,
-	CMPC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	CMPC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xba - CMP D
-	LD_IR,
-	CMPD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	CMPD,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xbb - CMP E
-	LD_IR,
-	CMPE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	CMPE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xbc - CMP H
-	LD_IR,
-	CMPH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	CMPH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xbd - CMP L
-	LD_IR,
-	CMPL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	CMPL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xbe - CMP M
-	LD_IR,
-	CMPM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	CMPM,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xbf - CMP A
-	LD_IR,
-	CMPA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	LD_IR,
-	CMPA,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-// 0xc0 - RNZ
-	LD_IR,				// condition does not match
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,				// condition matches
-	POPPCL,
-	INC_SPL,
-	INC_SPH,
-	POPPCH,
-	INC_SPL,
-	INC_SPH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xc1 - POP B		; inc sp after pop
-	LD_IR,
-	POPC,
-	INC_SPL,
-	INC_SPH,
-	POPB,
-	INC_SPL,
-	INC_SPH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	POPC,
-	INC_SPL,
-	INC_SPH,
-	POPB,
-	INC_SPL,
-	INC_SPH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xc2 - JNZ
-	LD_IR,				// condition not matched; move to next instruction
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,				// condition matched, do the jump
-	INC_PCL,
-	INC_PCH,
-	JMP1,
-	INC_PCL,
-	INC_PCH,
-	JMP2,
-	JMP3 + LAST,
-	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xc3 - JMP abs
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	JMP1,
-	INC_PCL,
-	INC_PCH,
-	JMP2,
-	JMP3 + LAST,
-	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	JMP1,
-	INC_PCL,
-	INC_PCH,
-	JMP2,
-	JMP3 + LAST,
-	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xc4 - CNZ
-	LD_IR,				// condition not matched; move to next instruction
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,	// move to low byte of target
-	M2MAL,		// and grab it
-	INC_PCL,
-	INC_PCH,
-	M2MAH,		// same for high byte
-	INC_PCL,
-	INC_PCH,	// move to next instruction
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	CALL1,		// copy
-	CALL2 + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xc5 - PUSH B	; dec sp before push
-	LD_IR,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHB,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHB,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHC,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xc6 - ADI
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	ADI,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	ADI,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xc7 - RST 0
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	RST1,
-	RST2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	RST1,
-	RST2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xc8 - RZ
-	LD_IR,				// condition does not match
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,				// condition matches
-	POPPCL,
-	INC_SPL,
-	INC_SPH,
-	POPPCH,
-	INC_SPL,
-	INC_SPH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-/// 0xc9 - RET
-	LD_IR,
-	POPPCL,
-	INC_SPL,
-	INC_SPH,
-	POPPCH,
-	INC_SPL,
-	INC_SPH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	POPPCL,
-	INC_SPL,
-	INC_SPH,
-	POPPCH,
-	INC_SPL,
-	INC_SPH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xca - JZ
-	LD_IR,				// condition not matched; move to next instruction
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,				// condition matched, do the jump
-	INC_PCL,
-	INC_PCH,
-	JMP1,
-	INC_PCL,
-	INC_PCH,
-	JMP2,
-	JMP3 + LAST,
-	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xcb - jmp abs
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	JMP1,
-	INC_PCL,
-	INC_PCH,
-	JMP2,
-	JMP3 + LAST,
-	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	JMP1,
-	INC_PCL,
-	INC_PCH,
-	JMP2,
-	JMP3 + LAST,
-	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xcc - CZ
-	LD_IR,				// condition not matched; move to next instruction
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,	// move to low byte of target
-	M2MAL,		// and grab it
-	INC_PCL,
-	INC_PCH,
-	M2MAH,		// same for high byte
-	INC_PCL,
-	INC_PCH,	// move to next instruction
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	CALL1,		// copy
-	CALL2 + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xcd - CALL
-	LD_IR,
-	INC_PCL,
-	INC_PCH,	// move to low byte of target
-	M2MAL,		// and grab it
-	INC_PCL,
-	INC_PCH,
-	M2MAH,		// same for high byte
-	INC_PCL,
-	INC_PCH,	// move to next instruction
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	CALL1,		// copy
-	CALL2 + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,	// move to low byte of target
-	M2MAL,		// and grab it
-	INC_PCL,
-	INC_PCH,
-	M2MAH,		// same for high byte
-	INC_PCL,
-	INC_PCH,	// move to next instruction
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	CALL1,		// copy
-	CALL2 + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xce - ACI
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	ACI,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	ACI,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xcf - RST1
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	RST1,
-	RST2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	RST1,
-	RST2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xd0 - RNC
-	LD_IR,				// condition does not match
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,				// condition matches
-	POPPCL,
-	INC_SPL,
-	INC_SPH,
-	POPPCH,
-	INC_SPL,
-	INC_SPH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xd1 - POP D
-	LD_IR,
-	POPE,
-	INC_SPL,
-	INC_SPH,
-	POPD,
-	INC_SPL,
-	INC_SPH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	POPE,
-	INC_SPL,
-	INC_SPH,
-	POPD,
-	INC_SPL,
-	INC_SPH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xd2 - JNC
-	LD_IR,				// condition not matched; move to next instruction
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,				// condition matched, do the jump
-	INC_PCL,
-	INC_PCH,
-	JMP1,
-	INC_PCL,
-	INC_PCH,
-	JMP2,
-	JMP3 + LAST,
-	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xd3 - NOP
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xd4 - CNC
-	LD_IR,				// condition not matched; move to next instruction
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,	// move to low byte of target
-	M2MAL,		// and grab it
-	INC_PCL,
-	INC_PCH,
-	M2MAH,		// same for high byte
-	INC_PCL,
-	INC_PCH,	// move to next instruction
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	CALL1,		// copy
-	CALL2 + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xd5 - PUSH D
-	LD_IR,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHD,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHD,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHE,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xd6 - SUI
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	SUI,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	SUI,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xd7 - RST2
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	RST1,
-	RST2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	RST1,
-	RST2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xd8 - RC
-	LD_IR,				// condition does not match
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,				// condition matches
-	POPPCL,
-	INC_SPL,
-	INC_SPH,
-	POPPCH,
-	INC_SPL,
-	INC_SPH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xd9 - RET
-	LD_IR,
-	POPPCL,
-	INC_SPL,
-	INC_SPH,
-	POPPCH,
-	INC_SPL,
-	INC_SPH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	POPPCL,
-	INC_SPL,
-	INC_SPH,
-	POPPCH,
-	INC_SPL,
-	INC_SPH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xda - JC
-	LD_IR,				// condition not matched; move to next instruction
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,				// condition matched, do the jump
-	INC_PCL,
-	INC_PCH,
-	JMP1,
-	INC_PCL,
-	INC_PCH,
-	JMP2,
-	JMP3 + LAST,
-	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xdb - NOP
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xdc - CC
-	LD_IR,				// condition not matched; move to next instruction
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,	// move to low byte of target
-	M2MAL,		// and grab it
-	INC_PCL,
-	INC_PCH,
-	M2MAH,		// same for high byte
-	INC_PCL,
-	INC_PCH,	// move to next instruction
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	CALL1,		// copy
-	CALL2 + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xdd - CALL
-	LD_IR,
-	INC_PCL,
-	INC_PCH,	// move to low byte of target
-	M2MAL,		// and grab it
-	INC_PCL,
-	INC_PCH,
-	M2MAH,		// same for high byte
-	INC_PCL,
-	INC_PCH,	// move to next instruction
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	CALL1,		// copy
-	CALL2 + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,	// move to low byte of target
-	M2MAL,		// and grab it
-	INC_PCL,
-	INC_PCH,
-	M2MAH,		// same for high byte
-	INC_PCL,
-	INC_PCH,	// move to next instruction
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	CALL1,		// copy
-	CALL2 + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xde - SBI
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	SBI,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	SBI,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xdf - RST3
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	RST1,
-	RST2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	RST1,
-	RST2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xe0 - RPO not implemented
-	LD_IR,				// condition does not match
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,				// condition matches
-	POPPCL,
-	INC_SPL,
-	INC_SPH,
-	POPPCH,
-	INC_SPL,
-	INC_SPH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xe1 - POP h
-	LD_IR,
-	POPL,
-	INC_SPL,
-	INC_SPH,
-	POPH,
-	INC_SPL,
-	INC_SPH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	POPL,
-	INC_SPL,
-	INC_SPH,
-	POPH,
-	INC_SPL,
-	INC_SPH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xe2 - JPO - not implemented, no P flag
-	LD_IR,				// condition not matched; move to next instruction
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,				// condition matched, do the jump
-	INC_PCL,
-	INC_PCH,
-	JMP1,
-	INC_PCL,
-	INC_PCH,
-	JMP2,
-	JMP3 + LAST,
-	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xe3 - XTHL
-	LD_IR,
-	XTHL1,
-	XTHL2,
-	POPL,
-	INC_SPL,
-	INC_SPH,
-	POPH,
-	PUSHMAH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHMAL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	XTHL1,
-	XTHL2,
-	POPL,
-	INC_SPL,
-	INC_SPH,
-	POPH,
-	PUSHMAH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHMAL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xe4 - CPO - not implemented
-	LD_IR,				// condition not matched; move to next instruction
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,	// move to low byte of target
-	M2MAL,		// and grab it
-	INC_PCL,
-	INC_PCH,
-	M2MAH,		// same for high byte
-	INC_PCL,
-	INC_PCH,	// move to next instruction
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	CALL1,		// copy
-	CALL2 + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xe5 - PUSH H
-	LD_IR,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHL,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xe6 - ANI
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	ANI,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	ANI,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xe7 - RST4
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	RST1,
-	RST2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	RST1,
-	RST2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xe8 - RPE not implemented
-	LD_IR,				// condition does not match
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,				// condition matches
-	POPPCL,
-	INC_SPL,
-	INC_SPH,
-	POPPCH,
-	INC_SPL,
-	INC_SPH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xe9 - PCHL
-	LD_IR,
-	PCHL1,
-	PCHL2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	PCHL1,
-	PCHL2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xea - JPE - not implemented, no P flag
-	LD_IR,				// condition not matched; move to next instruction
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,				// condition matched, do the jump
-	INC_PCL,
-	INC_PCH,
-	JMP1,
-	INC_PCL,
-	INC_PCH,
-	JMP2,
-	JMP3 + LAST,
-	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xeb - XCHG							swap hl and de
-	LD_IR,
-	XCHG1,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	XCHG1,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xec - CPE - not implemented
-	LD_IR,				// condition not matched; move to next instruction
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,	// move to low byte of target
-	M2MAL,		// and grab it
-	INC_PCL,
-	INC_PCH,
-	M2MAH,		// same for high byte
-	INC_PCL,
-	INC_PCH,	// move to next instruction
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	CALL1,		// copy
-	CALL2 + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xed - CALL
-	LD_IR,
-	INC_PCL,
-	INC_PCH,	// move to low byte of target
-	M2MAL,		// and grab it
-	INC_PCL,
-	INC_PCH,
-	M2MAH,		// same for high byte
-	INC_PCL,
-	INC_PCH,	// move to next instruction
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	CALL1,		// copy
-	CALL2 + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,	// move to low byte of target
-	M2MAL,		// and grab it
-	INC_PCL,
-	INC_PCH,
-	M2MAH,		// same for high byte
-	INC_PCL,
-	INC_PCH,	// move to next instruction
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	CALL1,		// copy
-	CALL2 + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xee - XRI
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	XRI,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	XRI,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xef - RST5
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	RST1,
-	RST2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	RST1,
-	RST2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xf0 - RP
-	LD_IR,				// condition does not match
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,				// condition matches
-	POPPCL,
-	INC_SPL,
-	INC_SPH,
-	POPPCH,
-	INC_SPL,
-	INC_SPH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-/// 0xf1 - POP PSW
-	LD_IR,
-	POPF,
-	INC_SPL,
-	INC_SPH,
-	POPA,
-	INC_SPL,
-	INC_SPH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	POPF,
-	INC_SPL,
-	INC_SPH,
-	POPA,
-	INC_SPL,
-	INC_SPH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xf2 - JP
-	LD_IR,				// condition not matched; move to next instruction
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,				// condition matched, do the jump
-	INC_PCL,
-	INC_PCH,
-	JMP1,
-	INC_PCL,
-	INC_PCH,
-	JMP2,
-	JMP3 + LAST,
-	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xf3 - DI
-	LD_IR,
-	INC_PCL + INTOFF,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL + INTOFF,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xf4 - CP
-	LD_IR,				// condition not matched; move to next instruction
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,	// move to low byte of target
-	M2MAL,		// and grab it
-	INC_PCL,
-	INC_PCH,
-	M2MAH,		// same for high byte
-	INC_PCL,
-	INC_PCH,	// move to next instruction
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	CALL1,		// copy
-	CALL2 + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xf5 - PUSH PSW
-	LD_IR,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHA,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHF,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHA,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHF,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xf6 - ORI
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	ORI,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	ORI,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xf7 - RST6
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	RST1,
-	RST2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	RST1,
-	RST2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xf8 - RM
-	LD_IR,				// condition does not match
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,				// condition matches
-	POPPCL,
-	INC_SPL,
-	INC_SPH,
-	POPPCH,
-	INC_SPL,
-	INC_SPH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xf9 - SPHL				copy hl to sp, hl remains unchanged
-	LD_IR,
-	SPHL1,
-	SPHL2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	SPHL1,
-	SPHL2,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xfa - JM
-	LD_IR,				// condition not matched; move to next instruction
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,				// condition matched, do the jump
-	INC_PCL,
-	INC_PCH,
-	JMP1,
-	INC_PCL,
-	INC_PCH,
-	JMP2,
-	JMP3 + LAST,
-	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xfb - EI
-	LD_IR,
-	INC_PCL + INTON,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL + INTON,
-	INC_PCH + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xfc - CM
-	LD_IR,				// condition not matched; move to next instruction
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,	// move to low byte of target
-	M2MAL,		// and grab it
-	INC_PCL,
-	INC_PCH,
-	M2MAH,		// same for high byte
-	INC_PCL,
-	INC_PCH,	// move to next instruction
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	CALL1,		// copy
-	CALL2 + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xfd - CALL
-	LD_IR,
-	INC_PCL,
-	INC_PCH,	// move to low byte of target
-	M2MAL,		// and grab it
-	INC_PCL,
-	INC_PCH,
-	M2MAH,		// same for high byte
-	INC_PCL,
-	INC_PCH,	// move to next instruction
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	CALL1,		// copy
-	CALL2 + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,	// move to low byte of target
-	M2MAL,		// and grab it
-	INC_PCL,
-	INC_PCH,
-	M2MAH,		// same for high byte
-	INC_PCL,
-	INC_PCH,	// move to next instruction
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	CALL1,		// copy
-	CALL2 + LAST,
-	0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xfe - CPI
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	CPI,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	CPI,
-	INC_PCL,
-	INC_PCH + LAST,
-	0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-// 0xff - RST7
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	RST1,
-	RST2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-	LD_IR,
-	INC_PCL,
-	INC_PCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCH,
-	DEC_SPL,
-	DEC_SPH,
-	PUSHPCL,
-	RST1,
-	RST2 + LAST,
-	0,0,0,0,0,	0,0,0,0,0,0,0,0,	0,0,0,0,0,0,0,0,
-};
+	int end = 64 * 256;
+	size_t len = 0;
+	int tokens = 0;
+
+	while ((end > 0) && (table[end - 1] == 0))
+	{
+		end--;
+	}
+	for (int i = 0; i < end; )
+	{
+		int n = 1;
+		while ((i + n < end) && (table[i + n] == table[i]))
+		{
+			n++;
+		}
+
+		char value[16];
+		char run[32];
+		int vlen = sprintf (value, "%x", table[i]);
+		int rlen = sprintf (run, "%d*%s", n, value);
+		bool use_run = (n > 1) && (rlen <= (n * (vlen + 1)) - 1);
+		for (int k = 0; k < (use_run ? 1 : n); k++)
+		{
+			len += sprintf (out + len, "%s%s", use_run ? run : value, (++tokens % 8) ? " " : "\n");
+		}
+		i += n;
+	}
+	if (tokens % 8)
+	{
+		out[len - 1] = '\n';
+	}
+	out[len] = 0;
+	return len;
+}
+
+static char *read_text (const char *path, size_t *len)
+{
+	FILE *f = fopen (path, "rb");
+	if (f == NULL)
+	{
+		return NULL;
+	}
+	fseek (f, 0, SEEK_END);
+	long size = ftell (f);
+	fseek (f, 0, SEEK_SET);
+	char *text = malloc (size + 1);
+	*len = fread (text, 1, size, f);
+	text[*len] = 0;
+	fclose (f);
+	return text;
+}
+
+// put the table straight into the sequencer rom of a Logisim circuit file, in place
+// of the addr/data block that used to be pasted in by hand; everything else in the
+// file is left as it was
+static int patch_circuit (const char *path)
+{
+	static const char header[] = "<a name=\"contents\">addr/data: 14 32\n";
+	size_t len;
+	char *text = read_text (path, &len);
+	if (text == NULL)
+	{
+		fprintf (stderr, "Can't open %s\n", path);
+		return 1;
+	}
+
+	char *circuit = strstr (text, "<circuit name=\"Sequencer\">");
+	char *circuit_end = (circuit != NULL) ? strstr (circuit, "</circuit>") : NULL;
+	char *rom = (circuit != NULL) ? strstr (circuit, "name=\"ROM\">") : NULL;
+	char *contents = (rom != NULL) ? strstr (rom, header) : NULL;
+	char *contents_end = (contents != NULL) ? strstr (contents, "</a>") : NULL;
+	if ((contents_end == NULL) || (contents_end > circuit_end))
+	{
+		fprintf (stderr, "%s has no 14 x 32 ROM in a Sequencer circuit\n", path);
+		free (text);
+		return 1;
+	}
+	for (int i = 0; i < (64 * 256); i += 64)
+	{
+		if (!fetch_ok (table[i]))
+		{
+			fprintf (stderr, "Alignment error at instruction %02x\n", i / 64);
+			free (text);
+			return 1;
+		}
+	}
+
+	// at worst every word is written out with a separator
+	char *body = malloc ((64 * 256) * 10 + 1);
+	format_contents (body);
+
+	// write a new file alongside and rename it over the old one, so a failure part
+	// way through doesn't leave half a circuit
+	char tmp[1024];
+	snprintf (tmp, sizeof (tmp), "%s.tmp", path);
+	char *start = contents + strlen (header);
+	FILE *f = fopen (tmp, "wb");
+	bool ok = (f != NULL)
+		&& (fwrite (text, 1, start - text, f) == (size_t) (start - text))
+		&& (fputs (body, f) >= 0)
+		&& (fwrite (contents_end, 1, len - (contents_end - text), f) == len - (contents_end - text));
+	if ((f != NULL) && (fclose (f) != 0))
+	{
+		ok = false;
+	}
+	if (!ok || (rename (tmp, path) != 0))
+	{
+		fprintf (stderr, "Can't write %s\n", path);
+		remove (tmp);
+		ok = false;
+	}
+	free (body);
+	free (text);
+	return ok ? 0 : 1;
+}
 
-int main (void)
+int main (int argc, char **argv)
 {
 	bool halt = false;
 
+	memcpy (table, control, sizeof (table));
+	while ((argc > 2) && (strcmp (argv[1], "-v") == 0))
+	{
+		if (!apply_variant (argv[2]))
+		{
+			return 1;
+		}
+		argc -= 2;
+		argv += 2;
+	}
+
+	if ((argc > 1) && (strcmp (argv[1], "-l") == 0))
+	{
+		return (lint (stdout) != 0);
+	}
+	int problems = lint (stderr);
+	if (problems)
+	{
+		fprintf (stderr, "%d problems in the control table, nothing generated\n", problems);
+		return 1;
+	}
+
+	if ((argc > 1) && (strcmp (argv[1], "-c") == 0))
+	{
+		return emit_compiled ((argc > 2) ? argv[2] : NULL);
+	}
+	if ((argc > 2) && (strcmp (argv[1], "-b") == 0))
+	{
+		return emit_binary (argv[2]);
+	}
+	if ((argc > 2) && (strcmp (argv[1], "-d") == 0))
+	{
+		return emit_halves (argv[2]);
+	}
+	if ((argc > 2) && (strcmp (argv[1], "-n") == 0))
+	{
+		return emit_nanocode (argv[2]);
+	}
+	if ((argc > 1) && (strcmp (argv[1], "-t") == 0))
+	{
+		return emit_cycles ((argc > 2) ? argv[2] : NULL);
+	}
+	if ((argc > 2) && (strcmp (argv[1], "-p") == 0))
+	{
+		return patch_circuit (argv[2]);
+	}
+
 	printf ("v2.0 raw\n");
 	for (int r = 0; r < (256 * 8); r++)
 	{
@@ -4357,7 +1385,7 @@ int main (void)
 			{
 				if (q == 0)
 				{
-					if (control[q + (8 * r)] != LD_IR)
+					if (!fetch_ok (table[q + (8 * r)]))
 					{
 						fprintf (stderr, "Alignment error at instruction %02x\n", r / 8);
 						halt = true;
@@ -4365,7 +1393,7 @@ int main (void)
 					}
 				}
 			}
-			printf ("%08x ", control[q + (8 * r)]);
+			printf ("%08x ", table[q + (8 * r)]);
 		}
 		printf ("\n");
 		if (halt)
@@ -0,0 +1,776 @@
+// run an 8080 memory image on the native Fake8080 simulator
+//
+// usage: sim [-m microcode.raw] [-i keyboard.txt] [-n cycles] [-x stop_pc] [-w idle_polls]
+//			[-e engine] [-b runs] [-f] [-t trigger] [-l lanes] [-r] [-s snapshot] [-F forks] [-P profile] [-q] image.raw
+//        sim [-m microcode.raw] -z images
+//
+// -e picks the engine (raw decodes every control word as it runs, soa uses the tables
+// built by microcode_decode, switch and threaded run the handler records built by
+// thread_build, jit translates the 8080 program to x86-64 from those tables, fast
+// emulates whole instructions, charging each its sequence length, and compiled runs
+// the functions seq -c generated) and -b benchmarks every engine on the image
+// instead; -f reports what the threaded engine's superoperators save on the image,
+// and -P writes how often each opcode ran in each condition, for seq -t
+//
+// -z checks every engine against raw on that many images of random bytes instead, each
+// run to a random -n, so an engine stopping a microcycle either side of the limit is
+// caught, then again with some halves of the table left without a LAST
+//
+// -t fast forwards to a trigger and hands over to the -e engine there: pc=addr stops
+// before the instruction at addr, cycle=n before the instruction that would take the
+// count past n, and out after the first instruction to write to the terminal. Give
+// several and the first to fire wins
+//
+// -l runs that many copies of the image side by side on the batch engine, lane k
+// typing the k'th -i file (going round them again if there are more lanes than files),
+// and checks each input's first lane against the soa engine; build with -mavx2 to
+// have it step eight lanes to a vector
+//
+// -s saves a snapshot of the machine where it stopped, and -r takes the image to be
+// such a snapshot rather than a memory image, so a run can carry on from where another
+// left off; -i then types after any input the snapshot hadn't read yet, and -n counts
+// from the snapshot's cycle count. -F forks that many runs from the starting state,
+// each restored from a snapshot of it, to time the restore and check the runs agree
+//
+// the microcode is the "v2.0 raw" image printed by seq.c, so build it first:
+//		cc -o seq seq.c && ./seq > seq.raw
+//		cc -O2 -o sim sim.c machine.c decode.c threaded.c jit.c fast.c batch.c snapshot.c rom.c
+//		./sim -x 0 cpudiag.raw
+//
+// the compiled engine is only there when sim is built with the generated code:
+//		./seq -c > ops.c
+//		cc -O2 -DCOMPILED -o sim sim.c machine.c decode.c threaded.c jit.c fast.c batch.c snapshot.c compiled.c ops.c rom.c
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "fake8080.h"
+
+static uint32_t rom[ROM_WORDS];
+static microcode_t mc;
+static thread_t thread;
+static thread_t unfused;
+static jit_t jit;
+static fast_t fast;
+static const trigger_t no_trigger = { -1, 0, false };
+
+#define MAX_INPUTS	64			// -i files
+
+static const char *engines[] =
+{
+	"raw", "soa", "switch", "threaded", "jit", "fast",
+#ifdef COMPILED
+	"compiled",
+#endif
+};
+#define ENGINES		(sizeof (engines) / sizeof (engines[0]))
+static size_t engine_count = ENGINES;
+
+static double now (void)
+{
+	struct timespec ts;
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint8_t *read_file (const char *path, size_t *len)
+{
+	FILE *f = fopen (path, "rb");
+	if (f == NULL)
+	{
+		fprintf (stderr, "Can't open %s\n", path);
+		return NULL;
+	}
+	size_t cap = 4096;
+	uint8_t *buf = malloc (cap);
+	*len = 0;
+	size_t got;
+	while ((got = fread (buf + *len, 1, cap - *len, f)) > 0)
+	{
+		*len += got;
+		if (*len == cap)
+		{
+			cap *= 2;
+			buf = realloc (buf, cap);
+		}
+	}
+	fclose (f);
+	return buf;
+}
+
+static int run (machine_t *m, int engine, const run_limits_t *lim)
+{
+	switch (engine)
+	{
+		case 0:		return machine_run (m, lim);
+		case 1:		return machine_run_decoded (m, &mc, lim);
+		case 2:		return machine_run_switch (m, &thread, lim);
+		case 3:		return machine_run_threaded (m, &thread, lim);
+		case 4:		return machine_run_jit (m, &jit, lim);
+		case 5:		return machine_run_fast (m, &fast, lim, &no_trigger);
+#ifdef COMPILED
+		case 6:		return machine_run_compiled (m, &mc, lim);
+#endif
+		default:	return STOP_CYCLES;
+	}
+}
+
+// two runs agree if they end in the same place having printed the same thing
+static bool same_state (const machine_t *a, const machine_t *b)
+{
+	return (memcmp (a->reg, b->reg, sizeof (a->reg)) == 0)
+		&& (a->step == b->step) && (a->cond == b->cond) && (a->flip == b->flip)
+		&& (machine_flags (a) == machine_flags (b)) && (a->inte == b->inte)
+		&& (a->cycles == b->cycles) && (a->instructions == b->instructions)
+		&& (a->tty_len == b->tty_len) && (memcmp (a->tty, b->tty, a->tty_len) == 0)
+		&& (memcmp (a->mem, b->mem, MEM_SIZE) == 0);
+}
+
+// random images, each run to a random cycle limit on every engine and checked against
+// raw, so an engine that stops a cycle early or late at -n shows up. Image k is always
+// the same, from seed k
+static int fuzz_table (int images, const char *table)
+{
+	static machine_t boot;
+	static machine_t ref;
+	static machine_t m;
+	int bad = 0;
+
+	for (int k = 1; k <= images; k++)
+	{
+		uint64_t x = 0x9e3779b97f4a7c15ull * (uint64_t) k;
+		machine_reset (&boot, rom);
+		for (size_t a = 0; a < MEM_SIZE; a++)
+		{
+			x ^= x << 13;
+			x ^= x >> 7;
+			x ^= x << 17;
+			boot.mem[a] = (uint8_t) (x >> 32);
+		}
+		run_limits_t lim = { 1 + (x >> 40) % 10000, -1, 0 };
+		ref = boot;
+		run (&ref, 0, &lim);
+		for (size_t e = 1; e < engine_count; e++)
+		{
+			m = boot;
+			run (&m, (int) e, &lim);
+			if (!same_state (&m, &ref))
+			{
+				fprintf (stderr, "%s, image %d, -n %llu: %s engine stops at %llu microcycles, raw at %llu\n", table, k,
+					(unsigned long long) lim.max_cycles, engines[e], (unsigned long long) m.cycles,
+					(unsigned long long) ref.cycles);
+				bad++;
+			}
+			free (m.tty);
+		}
+		free (ref.tty);
+	}
+	printf ("%d random images on the %s, %d disagreements with raw\n", images, table, bad);
+	return bad;
+}
+
+// the images again on a copy of the table where a quarter of the halves have lost
+// their LAST, with their steps moved up so the one that was LAST is in slot 31. The
+// step counter then wraps to the fetch in the middle of an instruction, which every
+// engine has to follow and still stop at the limit
+static int fuzz (int images)
+{
+	int bad = fuzz_table (images, "table");
+	uint64_t x = 0x2545f4914f6cdd1dull;
+
+	for (int half = 0; half < 512; half++)
+	{
+		uint32_t *w = &rom[half << 5];
+		int last = 0;
+
+		x ^= x << 13;
+		x ^= x >> 7;
+		x ^= x << 17;
+		while ((last < 31) && !(w[last] & CW_LAST))
+		{
+			last++;
+		}
+		if (((x >> 32) & 3) || (last == 0) || !(w[last] & CW_LAST))
+		{
+			continue;
+		}
+		w[last] &= ~CW_LAST;
+		memmove (&w[32 - last], &w[1], last * sizeof (uint32_t));
+		for (int step = 1; step < 32 - last; step++)
+		{
+			w[step] = REG_A | (REG_A << 4) | (ADDR_PC << 8) | (ALU_PASS << 10);
+		}
+	}
+	microcode_decode (&mc, rom);
+	thread_build (&thread, &mc, true);
+	thread_build (&unfused, &mc, false);
+	jit_init (&jit, &mc);
+	fast_init (&fast, &mc);
+	engine_count = (engine_count < 6) ? engine_count : 6;
+	bad += fuzz_table (images, "table without some LASTs");
+	return bad ? 1 : 0;
+}
+
+// run the image on every engine, runs times each, and compare the speed
+static int benchmark (const machine_t *boot, const run_limits_t *lim, int runs)
+{
+	static machine_t m;
+	static machine_t ref;
+	bool ok = true;
+
+	if (!threaded_goto)
+	{
+		printf ("no computed goto: threaded is the switch engine\n");
+	}
+	if (jit.code == NULL)
+	{
+		printf ("no translator for this host or microcode: jit is the soa engine\n");
+	}
+	printf ("engine    microcycles     seconds     M cycles/s   speedup\n");
+	double base = 0;
+	for (size_t e = 0; e < engine_count; e++)
+	{
+		double t = 0;
+		for (int r = 0; r < runs; r++)
+		{
+			free (m.tty);
+			m = *boot;
+			m.tty = NULL;
+			m.echo = false;
+			double t0 = now ();
+			run (&m, (int) e, lim);
+			t += now () - t0;
+		}
+		if (e == 0)
+		{
+			base = t;
+			ref = m;
+			ref.tty = malloc (m.tty_len + 1);
+			memcpy (ref.tty, m.tty, m.tty_len);
+		}
+		else if (!same_state (&m, &ref))
+		{
+			fprintf (stderr, "%s engine disagrees with raw\n", engines[e]);
+			ok = false;
+		}
+		printf ("%-8s %12llu %11.3f %14.1f %9.2fx\n", engines[e], (unsigned long long) m.cycles * runs,
+			t, t > 0 ? m.cycles * runs / t * 1e-6 : 0.0, t > 0 ? base / t : 0.0);
+	}
+	return ok ? 0 : 1;
+}
+
+// run the image a microcycle at a time, counting how often each ROM slot runs
+static int profile (machine_t *m, const run_limits_t *lim, uint64_t *count)
+{
+	for (;;)
+	{
+		if (lim->max_cycles && (m->cycles >= lim->max_cycles))
+		{
+			return STOP_CYCLES;
+		}
+		count[(m->reg[REG_IR] << 6) | (m->cond << 5) | m->step]++;
+		machine_step_decoded (m, &mc);
+		if (m->step == 0)
+		{
+			int why = machine_limit (m, lim);
+			if (why >= 0)
+			{
+				return why;
+			}
+		}
+	}
+}
+
+// how many times each (opcode, condition) ran, in the form seq -t and -c read: a line
+// for each half that ran, "op cond count", then how often each of its slots ran from
+// step 0 to the last that did, a run of n the same written n*count. Every instruction
+// runs step 1 of its own half, whatever its length, which gives the count; step 0 is
+// the fetch for the instruction after, so its count can differ. The header names the
+// microcode by its hash, so that seq can tell whether the slot counts are for its table
+static int write_profile (const machine_t *boot, const run_limits_t *lim, const char *path)
+{
+	static uint64_t count[ROM_WORDS];
+	static machine_t m;
+
+	m = *boot;
+	m.tty = NULL;
+	m.tty_len = m.tty_cap = 0;
+	m.echo = false;
+	profile (&m, lim, count);
+	free (m.tty);
+
+	FILE *f = fopen (path, "w");
+	if (f == NULL)
+	{
+		fprintf (stderr, "Can't write %s\n", path);
+		return 1;
+	}
+	fprintf (f, "# op cond count, then the slots: %llu instructions, %llu microcycles, microcode %08x\n",
+		(unsigned long long) m.instructions, (unsigned long long) m.cycles, rom_hash (m.rom, ROM_WORDS));
+	for (int half = 0; half < 512; half++)
+	{
+		const uint64_t *c = &count[half * 32];
+		int end = 32;
+		while ((end > 0) && (c[end - 1] == 0))
+		{
+			end--;
+		}
+		if (end == 0)
+		{
+			continue;
+		}
+		fprintf (f, "%02x %d %llu", half / 2, half % 2, (unsigned long long) c[1]);
+		for (int step = 0; step < end; )
+		{
+			int n = 1;
+			while ((step + n < end) && (c[step + n] == c[step]))
+			{
+				n++;
+			}
+			if (n > 1)
+			{
+				fprintf (f, " %d*%llu", n, (unsigned long long) c[step]);
+			}
+			else
+			{
+				fprintf (f, " %llu", (unsigned long long) c[step]);
+			}
+			step += n;
+		}
+		fprintf (f, "\n");
+	}
+	if (fclose (f) != 0)
+	{
+		fprintf (stderr, "Can't write %s\n", path);
+		return 1;
+	}
+	return 0;
+}
+
+static double time_threaded (const machine_t *boot, const thread_t *t, const run_limits_t *lim, int runs)
+{
+	static machine_t m;
+	double total = 0;
+
+	for (int r = 0; r < runs; r++)
+	{
+		m = *boot;
+		m.tty = NULL;
+		m.tty_len = m.tty_cap = 0;
+		m.echo = false;
+		double t0 = now ();
+		machine_run_threaded (&m, t, lim);
+		total += now () - t0;
+		free (m.tty);
+	}
+	return total;
+}
+
+// the threaded engine dispatches once per microcycle, except that a superoperator does
+// the work of several; walk every sequence the way the engine does, weighting each
+// record by how often its slot ran, to see how many dispatches they save
+static int fusion_report (const machine_t *boot, const run_limits_t *lim, int runs)
+{
+	static const char *name[] = { "inc16", "dec16", "push", "dad" };
+	static uint64_t count[ROM_WORDS];
+	static machine_t m;
+	uint64_t saved[4] = { 0 };
+	uint64_t total = 0;
+
+	m = *boot;
+	m.tty = NULL;
+	m.tty_len = m.tty_cap = 0;
+	m.echo = false;
+	profile (&m, lim, count);
+	free (m.tty);
+
+	for (int half = 0; half < 512; half++)
+	{
+		for (int step = 1; step < 32; )
+		{
+			const thread_op_t *p = &thread.op[(mc.seq[half] << 5) | step];
+			if (p->op >= OP_INC16)
+			{
+				saved[(p->op - OP_INC16) >> 1] += count[half * 32 + step] * (p->span - 1);
+			}
+			if (p->op & 1)
+			{
+				break;
+			}
+			step += p->span;
+		}
+	}
+
+	printf ("%llu microcycles, %llu instructions\n", (unsigned long long) m.cycles, (unsigned long long) m.instructions);
+	for (int k = 0; k < 4; k++)
+	{
+		printf ("%-6s %12llu dispatches saved\n", name[k], (unsigned long long) saved[k]);
+		total += saved[k];
+	}
+	printf ("dispatches %llu unfused, %llu fused, %.1f%% fewer\n", (unsigned long long) m.cycles,
+		(unsigned long long) (m.cycles - total), m.cycles ? 100.0 * total / m.cycles : 0.0);
+
+	double plain = time_threaded (boot, &unfused, lim, runs);
+	double fused = time_threaded (boot, &thread, lim, runs);
+	printf ("threaded, %d runs: %.3f s unfused, %.3f s fused, %.2fx\n", runs, plain, fused, fused > 0 ? plain / fused : 0.0);
+	return 0;
+}
+
+// every lane through the batch engine at once; the result of each input is checked
+// against soa, and every lane against the first lane with the same input
+static int lockstep (machine_t *const *boot, int inputs, int lanes, const run_limits_t *lim)
+{
+	static batch_t batch;
+	static machine_t ref;
+	int bad = 0;
+
+	if (!batch_init (&batch, lanes, rom))
+	{
+		return 1;
+	}
+	for (int lane = 0; lane < batch.lanes; lane++)
+	{
+		batch_load (&batch, lane, boot[lane % inputs]);
+	}
+
+	double t0 = now ();
+	batch_run (&batch, lim);
+	double t = now () - t0;
+
+	uint64_t cycles = 0;
+	for (int lane = 0; lane < batch.lanes; lane++)
+	{
+		machine_t *m = batch_lane (&batch, lane);
+		cycles += m->cycles;
+		if (lane < inputs)
+		{
+			ref = *boot[lane];
+			ref.tty = NULL;
+			ref.tty_len = ref.tty_cap = 0;
+			ref.echo = false;
+			machine_run_decoded (&ref, &mc, lim);
+		}
+		else
+		{
+			ref = *batch_lane (&batch, lane % inputs);
+		}
+		if (!same_state (m, &ref))
+		{
+			fprintf (stderr, "lane %d disagrees with %s\n", lane, (lane < inputs) ? "soa" : "its first lane");
+			bad++;
+		}
+		if (lane < inputs)
+		{
+			free (ref.tty);
+		}
+	}
+
+	printf ("%d lanes%s, %llu microcycles in %.3f s, %.1f M microcycles/s\n", batch.lanes,
+		batch_simd ? "" : " (no AVX2: one lane at a time)", (unsigned long long) cycles, t, t > 0 ? cycles / t * 1e-6 : 0.0);
+	batch_free (&batch);
+	return bad ? 1 : 0;
+}
+
+// fork runs from snapshots of the starting machines, going round the inputs, all on
+// one machine that is restored each time; a machine restored from the snapshot it was
+// last restored from only gets back the pages the run wrote, so with one input only
+// the first restore copies everything. Each input's first fork is checked against a
+// run from the machine itself, and the rest against that
+static int forks (machine_t *const *boot, int inputs, int count, int engine, const run_limits_t *lim)
+{
+	static snapshot_t snap[MAX_INPUTS];
+	static machine_t ref[MAX_INPUTS];
+	static machine_t m;
+	double restore = 0;
+	double t = 0;
+	uint64_t cycles = 0;
+	uint64_t written = 0;
+	int bad = 0;
+
+	for (int k = 0; k < inputs; k++)
+	{
+		snapshot_take (&snap[k], boot[k]);
+		ref[k] = *boot[k];
+		ref[k].tty = NULL;
+		ref[k].tty_len = ref[k].tty_cap = 0;
+		ref[k].echo = false;
+		run (&ref[k], engine, lim);
+	}
+	m = *boot[0];
+	m.tty = NULL;
+	m.tty_len = m.tty_cap = 0;
+	m.echo = false;
+	m.origin = NULL;
+
+	for (int i = 0; i < count; i++)
+	{
+		const snapshot_t *s = &snap[i % inputs];
+		double t0 = now ();
+		snapshot_restore (&m, s);
+		double t1 = now ();
+		run (&m, engine, lim);
+		t += now () - t1;
+		restore += t1 - t0;
+		cycles += m.cycles - s->cycles;
+		for (int page = 0; page < PAGES; page++)
+		{
+			written += m.dirty[page];
+		}
+		if (!same_state (&m, &ref[i % inputs]))
+		{
+			if (bad++ == 0)
+			{
+				fprintf (stderr, "fork %d disagrees with a run from the machine itself\n", i);
+			}
+		}
+	}
+
+	printf ("%d runs forked from %d snapshot%s: %.2f us a restore, %.1f pages written a run\n", count, inputs,
+		(inputs > 1) ? "s" : "", count ? restore / count * 1e6 : 0.0, count ? (double) written / count : 0.0);
+	printf ("%llu microcycles in %.3f s, %.1f M microcycles/s\n", (unsigned long long) cycles, t, t > 0 ? cycles / t * 1e-6 : 0.0);
+	if (bad)
+	{
+		fprintf (stderr, "%d forks disagreed\n", bad);
+	}
+	for (int k = 0; k < inputs; k++)
+	{
+		snapshot_free (&snap[k]);
+	}
+	return bad ? 1 : 0;
+}
+
+static void usage (void)
+{
+	fprintf (stderr, "usage: sim [-m microcode.raw] [-i keyboard.txt] [-n cycles] [-x stop_pc] [-w idle_polls]\n"
+					 "           [-e engine] [-b runs] [-f] [-t trigger] [-l lanes] [-r] [-s snapshot] [-F forks] [-P profile] [-q] image.raw\n"
+					 "       sim [-m microcode.raw] -z images\n");
+	exit (2);
+}
+
+int main (int argc, char **argv)
+{
+	const char *micro = "seq.raw";
+	const char *input[MAX_INPUTS];
+	const char *save = NULL;
+	const char *prof = NULL;
+	int inputs = 0;
+	int lanes = 0;
+	int fork_runs = 0;
+	int fuzz_images = 0;
+	run_limits_t lim = { 0, -1, 0 };
+	trigger_t trig = no_trigger;
+	bool forward = false;
+	bool quiet = false;
+	bool fusion = false;
+	bool restore = false;
+	int engine = 3;
+	int runs = 0;
+	int opt;
+
+	while ((opt = getopt (argc, argv, "m:i:n:x:w:e:b:fl:rs:F:t:P:qz:")) != -1)
+	{
+		switch (opt)
+		{
+			case 'm':	micro = optarg;								break;
+			case 'i':
+				if (inputs == MAX_INPUTS)
+				{
+					usage ();
+				}
+				input[inputs++] = optarg;
+				break;
+			case 'n':	lim.max_cycles = strtoull (optarg, NULL, 0);	break;
+			case 'x':	lim.stop_pc = (int) strtol (optarg, NULL, 16);	break;
+			case 'w':	lim.idle_polls = strtoull (optarg, NULL, 0);	break;
+			case 'e':
+				for (engine = 0; (engine < (int) ENGINES) && strcmp (optarg, engines[engine]); engine++)
+				{
+				}
+				if (engine == ENGINES)
+				{
+					usage ();
+				}
+				break;
+			case 'b':	runs = atoi (optarg);						break;
+			case 'f':	fusion = true;								break;
+			case 'l':	lanes = atoi (optarg);						break;
+			case 'r':	restore = true;								break;
+			case 's':	save = optarg;								break;
+			case 'F':	fork_runs = atoi (optarg);					break;
+			case 'P':	prof = optarg;								break;
+			case 't':
+				if (strncmp (optarg, "pc=", 3) == 0)
+				{
+					trig.pc = (int) strtol (optarg + 3, NULL, 16);
+				}
+				else if (strncmp (optarg, "cycle=", 6) == 0)
+				{
+					trig.cycle = strtoull (optarg + 6, NULL, 0);
+				}
+				else if (strcmp (optarg, "out") == 0)
+				{
+					trig.output = true;
+				}
+				else
+				{
+					usage ();
+				}
+				forward = true;
+				break;
+			case 'q':	quiet = true;								break;
+			case 'z':	fuzz_images = atoi (optarg);				break;
+			default:	usage ();
+		}
+	}
+	if (optind != argc - (fuzz_images ? 0 : 1))
+	{
+		usage ();
+	}
+
+	if (load_raw (micro, rom, ROM_WORDS, 4) < 0)
+	{
+		return 1;
+	}
+	microcode_decode (&mc, rom);
+	if (!microcode_check (&mc, rom))
+	{
+		return 1;
+	}
+	thread_build (&thread, &mc, true);
+	thread_build (&unfused, &mc, false);
+	jit_init (&jit, &mc);
+	fast_init (&fast, &mc);
+#ifdef COMPILED
+	if (rom_hash (rom, ROM_WORDS) != compiled_rom_hash)
+	{
+		// the generated code is for some other microcode
+		if (engine == 6)
+		{
+			fprintf (stderr, "%s is not the microcode ops.c was generated from\n", micro);
+			return 1;
+		}
+		engine_count = 6;
+	}
+#endif
+	if (fuzz_images > 0)
+	{
+		return fuzz (fuzz_images);
+	}
+
+	// a machine for each input file, all starting from the same image
+	static machine_t boot[MAX_INPUTS];
+	static snapshot_t start;
+	machine_t *lane[MAX_INPUTS];
+	machine_reset (&boot[0], rom);
+	if (restore)
+	{
+		if (!snapshot_load (&start, argv[optind], rom))
+		{
+			return 1;
+		}
+		snapshot_restore (&boot[0], &start);
+		if (lim.max_cycles)
+		{
+			lim.max_cycles += start.cycles;
+		}
+	}
+	else if (load_raw (argv[optind], boot[0].mem, MEM_SIZE, 1) < 0)
+	{
+		return 1;
+	}
+	// boot[0] is typed into last, as the others are copied from it
+	for (int k = (inputs ? inputs : 1) - 1; k >= 0; k--)
+	{
+		lane[k] = &boot[k];
+		boot[k] = boot[0];
+		if (inputs > 0)
+		{
+			size_t len;
+			uint8_t *text = read_file (input[k], &len);
+			if (text == NULL)
+			{
+				return 1;
+			}
+			machine_type (&boot[k], text, len);
+			free (text);
+		}
+	}
+	static machine_t m;
+	m = boot[0];
+	m.echo = !quiet;
+
+	if ((runs > 0) || fusion || (lanes > 0) || (fork_runs > 0) || (prof != NULL))
+	{
+		if ((lim.max_cycles == 0) && (lim.stop_pc < 0) && (lim.idle_polls == 0))
+		{
+			fprintf (stderr, "a benchmark needs -n, -x or -w to stop\n");
+			return 2;
+		}
+		if (prof != NULL)
+		{
+			return write_profile (&m, &lim, prof);
+		}
+		if (fusion)
+		{
+			return fusion_report (&m, &lim, runs > 0 ? runs : 10);
+		}
+		if (lanes > 0)
+		{
+			return lockstep (lane, inputs ? inputs : 1, lanes, &lim);
+		}
+		if (fork_runs > 0)
+		{
+			return forks (lane, inputs ? inputs : 1, fork_runs, engine, &lim);
+		}
+		return benchmark (&m, &lim, runs);
+	}
+
+	static const char *reason[] = { "cycle limit", "stop address", "idle", "trigger" };
+	double t0 = now ();
+	int why = STOP_TRIGGER;
+	if (forward)
+	{
+		why = machine_run_fast (&m, &fast, &lim, &trig);
+		double t = now () - t0;
+		fflush (stdout);
+		fprintf (stderr, "\nfast forward: %llu instructions emulated, %llu stepped, %.3f s; ",
+			(unsigned long long) fast.fast, (unsigned long long) fast.stepped, t);
+		if (why == STOP_TRIGGER)
+		{
+			fprintf (stderr, "%s takes over at pc %04x after %llu microcycles\n",
+				engines[engine], machine_pc (&m), (unsigned long long) m.cycles);
+		}
+		else
+		{
+			fprintf (stderr, "no trigger before the %s\n", reason[why]);
+		}
+	}
+	if (why == STOP_TRIGGER)
+	{
+		why = run (&m, engine, &lim);
+	}
+	double t = now () - t0;
+
+	fflush (stdout);
+	fprintf (stderr, "\nstopped (%s) at pc %04x after %llu microcycles, %llu instructions\n",
+		reason[why], machine_pc (&m), (unsigned long long) m.cycles, (unsigned long long) m.instructions);
+	fprintf (stderr, "%.3f s, %.1f M microcycles/s\n", t, t > 0 ? m.cycles / t * 1e-6 : 0.0);
+	if ((engine == 4) && (jit.code != NULL))
+	{
+		fprintf (stderr, "%llu blocks translated, %llu code pages written to\n",
+			(unsigned long long) jit.translated, (unsigned long long) jit.invalidated);
+	}
+	if (save != NULL)
+	{
+		static snapshot_t s;
+		snapshot_take (&s, &m);
+		if (!snapshot_save (&s, save))
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
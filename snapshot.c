@@ -0,0 +1,295 @@
+// snapshots of a machine between runs, so a test can start from Tiny BASIC already
+// booted with its program typed in instead of spending millions of cycles getting there
+//
+// on disk a snapshot is little endian throughout:
+//
+//		8		"F8080SN1"
+//		4		hash of the microcode (rom_hash)
+//		16		registers, in src/dest code order
+//		8		step, cond, carry, zero, sign, icarry, flip, inte
+//		8 * 3	cycles, instructions, idle
+//		4		length of the keyboard input still to be read, then that input
+//		32		a bit for each page of memory that isn't all zeroes, bit 0 first
+//		256 * n	those pages
+//
+// in memory the pages are shared between snapshots and counted, and a machine
+// remembers which snapshot it was restored from and which pages it has written since,
+// so forking many runs from one snapshot costs a copy of the pages each one touches
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fake8080.h"
+
+#define MAGIC			"F8080SN1"
+
+static page_t *page_new (const uint8_t *data)
+{
+	page_t *p = malloc (sizeof (page_t));
+	p->refs = 1;
+	memcpy (p->data, data, PAGE_SIZE);
+	return p;
+}
+
+static bool page_zero (const uint8_t *data)
+{
+	for (int i = 0; i < PAGE_SIZE; i++)
+	{
+		if (data[i])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// snapshots may be taken and freed from several threads at once
+static void page_hold (page_t *p)
+{
+	if (p != NULL)
+	{
+		__atomic_add_fetch (&p->refs, 1, __ATOMIC_RELAXED);
+	}
+}
+
+static void page_drop (page_t *p)
+{
+	if ((p != NULL) && (__atomic_sub_fetch (&p->refs, 1, __ATOMIC_ACQ_REL) == 0))
+	{
+		free (p);
+	}
+}
+
+// the machine's origin, if it has one, has to outlive the new snapshot's pages being
+// taken from it, which is only for the length of this call
+void snapshot_take (snapshot_t *s, const machine_t *m)
+{
+	s->rom_hash = rom_hash (m->rom, ROM_WORDS);
+	memcpy (s->reg, m->reg, sizeof (s->reg));
+	s->step = m->step;
+	s->cond = m->cond;
+	s->carry = m->carry;
+	s->zero = m->zero;
+	s->sign = m->sign;
+	s->icarry = m->icarry;
+	s->flip = m->flip;
+	s->inte = m->inte;
+	s->cycles = m->cycles;
+	s->instructions = m->instructions;
+	s->idle = m->idle;
+
+	s->kbd_len = m->kbd_len - m->kbd_pos;
+	s->kbd = malloc (s->kbd_len + 1);
+	if (s->kbd_len)
+	{
+		memcpy (s->kbd, m->kbd + m->kbd_pos, s->kbd_len);
+	}
+
+	for (int i = 0; i < PAGES; i++)
+	{
+		const uint8_t *data = &m->mem[i * PAGE_SIZE];
+		if ((m->origin != NULL) && !m->dirty[i])
+		{
+			s->page[i] = m->origin->page[i];
+			page_hold (s->page[i]);
+		}
+		else
+		{
+			s->page[i] = page_zero (data) ? NULL : page_new (data);
+		}
+	}
+}
+
+// the machine keeps its rom and its terminal buffer, which is emptied, and reads the
+// keyboard input from the snapshot; a snapshot mustn't be freed while a machine
+// restored from it might be restored again
+void snapshot_restore (machine_t *m, const snapshot_t *s)
+{
+	memcpy (m->reg, s->reg, sizeof (m->reg));
+	m->step = s->step;
+	m->cond = s->cond;
+	m->carry = s->carry;
+	m->zero = s->zero;
+	m->sign = s->sign;
+	m->icarry = s->icarry;
+	m->flip = s->flip;
+	m->inte = s->inte;
+	m->cycles = s->cycles;
+	m->instructions = s->instructions;
+	m->idle = s->idle;
+	m->kbd = s->kbd;
+	m->kbd_len = s->kbd_len;
+	m->kbd_pos = 0;
+	m->tty_len = 0;
+
+	for (int i = 0; i < PAGES; i++)
+	{
+		if ((m->origin != s) || m->dirty[i])
+		{
+			uint8_t *data = &m->mem[i * PAGE_SIZE];
+			if (s->page[i] != NULL)
+			{
+				memcpy (data, s->page[i]->data, PAGE_SIZE);
+			}
+			else
+			{
+				memset (data, 0, PAGE_SIZE);
+			}
+		}
+	}
+	m->origin = s;
+	memset (m->dirty, 0, sizeof (m->dirty));
+}
+
+void snapshot_free (snapshot_t *s)
+{
+	for (int i = 0; i < PAGES; i++)
+	{
+		page_drop (s->page[i]);
+		s->page[i] = NULL;
+	}
+	free (s->kbd);
+	s->kbd = NULL;
+	s->kbd_len = 0;
+}
+
+static void put (uint8_t **p, uint64_t v, int bytes)
+{
+	for (int i = 0; i < bytes; i++)
+	{
+		*(*p)++ = (uint8_t) (v >> (8 * i));
+	}
+}
+
+static uint64_t get (const uint8_t **p, int bytes)
+{
+	uint64_t v = 0;
+
+	for (int i = 0; i < bytes; i++)
+	{
+		v |= (uint64_t) *(*p)++ << (8 * i);
+	}
+	return v;
+}
+
+#define HEADER			(8 + 4 + 16 + 8 + 8 * 3 + 4)
+
+bool snapshot_save (const snapshot_t *s, const char *path)
+{
+	FILE *f = fopen (path, "wb");
+	if (f == NULL)
+	{
+		fprintf (stderr, "Can't write %s\n", path);
+		return false;
+	}
+
+	uint8_t head[HEADER];
+	uint8_t *p = head;
+	memcpy (p, MAGIC, 8);
+	p += 8;
+	put (&p, s->rom_hash, 4);
+	memcpy (p, s->reg, 16);
+	p += 16;
+	put (&p, s->step, 1);
+	put (&p, s->cond, 1);
+	put (&p, s->carry, 1);
+	put (&p, s->zero, 1);
+	put (&p, s->sign, 1);
+	put (&p, s->icarry, 1);
+	put (&p, s->flip, 1);
+	put (&p, s->inte, 1);
+	put (&p, s->cycles, 8);
+	put (&p, s->instructions, 8);
+	put (&p, s->idle, 8);
+	put (&p, s->kbd_len, 4);
+
+	uint8_t present[PAGES / 8] = { 0 };
+	for (int i = 0; i < PAGES; i++)
+	{
+		if (s->page[i] != NULL)
+		{
+			present[i / 8] |= 1 << (i % 8);
+		}
+	}
+
+	bool ok = (fwrite (head, sizeof (head), 1, f) == 1)
+		&& (fwrite (s->kbd, 1, s->kbd_len, f) == s->kbd_len)
+		&& (fwrite (present, sizeof (present), 1, f) == 1);
+	for (int i = 0; ok && (i < PAGES); i++)
+	{
+		ok = (s->page[i] == NULL) || (fwrite (s->page[i]->data, PAGE_SIZE, 1, f) == 1);
+	}
+	if (fclose (f) != 0)
+	{
+		ok = false;
+	}
+	if (!ok)
+	{
+		fprintf (stderr, "Can't write %s\n", path);
+	}
+	return ok;
+}
+
+// refuses a snapshot taken with some other microcode than rom
+bool snapshot_load (snapshot_t *s, const char *path, const uint32_t *rom)
+{
+	FILE *f = fopen (path, "rb");
+	if (f == NULL)
+	{
+		fprintf (stderr, "Can't open %s\n", path);
+		return false;
+	}
+
+	uint8_t head[HEADER];
+	if ((fread (head, sizeof (head), 1, f) != 1) || (memcmp (head, MAGIC, 8) != 0))
+	{
+		fprintf (stderr, "%s is not a snapshot\n", path);
+		fclose (f);
+		return false;
+	}
+	const uint8_t *p = head + 8;
+	s->rom_hash = (uint32_t) get (&p, 4);
+	memcpy (s->reg, p, 16);
+	p += 16;
+	s->step = (uint8_t) get (&p, 1);
+	s->cond = (uint8_t) get (&p, 1);
+	s->carry = (uint8_t) get (&p, 1);
+	s->zero = (uint8_t) get (&p, 1);
+	s->sign = (uint8_t) get (&p, 1);
+	s->icarry = (uint8_t) get (&p, 1);
+	s->flip = (uint8_t) get (&p, 1);
+	s->inte = (uint8_t) get (&p, 1);
+	s->cycles = get (&p, 8);
+	s->instructions = get (&p, 8);
+	s->idle = get (&p, 8);
+	s->kbd_len = (size_t) get (&p, 4);
+	if (s->rom_hash != rom_hash (rom, ROM_WORDS))
+	{
+		fprintf (stderr, "%s was taken with different microcode\n", path);
+		fclose (f);
+		return false;
+	}
+
+	uint8_t present[PAGES / 8];
+	uint8_t data[PAGE_SIZE];
+	s->kbd = malloc (s->kbd_len + 1);
+	memset (s->page, 0, sizeof (s->page));
+	bool ok = (fread (s->kbd, 1, s->kbd_len, f) == s->kbd_len)
+		&& (fread (present, sizeof (present), 1, f) == 1);
+	for (int i = 0; ok && (i < PAGES); i++)
+	{
+		if (present[i / 8] & (1 << (i % 8)))
+		{
+			ok = (fread (data, PAGE_SIZE, 1, f) == 1);
+			s->page[i] = ok ? page_new (data) : NULL;
+		}
+	}
+	fclose (f);
+	if (!ok)
+	{
+		fprintf (stderr, "%s is cut short\n", path);
+		snapshot_free (s);
+	}
+	return ok;
+}
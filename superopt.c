@@ -0,0 +1,760 @@
+// microsequence superoptimizer: looks for shorter ways to do what the sequences in
+// control.h do, on the same model of the machine the simulator uses
+//
+// usage: superopt [-d depth] [-o opcode]
+//
+// each sequence is split at the steps that touch memory, the flags register, the IR,
+// the interrupt enable or the de/hl alias, which are left where they are. The steps
+// between them only move bytes between registers through the alu, and those are
+// split again into groups that share no register or flag, each of which is searched
+// on its own: every sequence of fewer steps, up to -d of them (3 by default), over
+// the registers the group uses, the scratch registers nothing else needs, all the alu
+// operations and the carry and zero/sign latches. A candidate has to leave every
+// register and flag that is read later, or is part of the 8080's state at the end of
+// the instruction, as the group would from any starting state.
+//
+// a candidate that passes on random states is then proved by running both over every
+// combination of the inputs either of them reads, which is done when those come to at
+// most 24 bits; a candidate with more inputs is listed as unproved. What is found is
+// printed as control.h lines for the group's steps
+//
+//		cc -O2 -o superopt superopt.c
+//		./superopt -o 2f
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "fake8080.h"
+#include "control.h"
+
+#define MAX_DEPTH		5
+#define VECTORS			4				// random states a candidate is first tried on
+#define CHECKS			256				// and then these many more
+#define PROOF_BITS		24
+
+// resources a step can read or write: the registers by code, then the latches
+#define R_CARRY			(1u << 16)
+#define R_ZS			(1u << 17)
+#define R_ICARRY		(1u << 18)
+#define R_REGS			0x3fbfu			// b to mal, but not m
+#define R_SCRATCH		((1u << REG_MAH) | (1u << REG_MAL))
+
+// at the end of an instruction the 8080's registers and flags matter, and the scratch
+// registers and the carry between steps don't
+#define R_ARCH			(((1u << REG_MAH) - 1) & ~(1u << REG_M)) | R_CARRY | R_ZS
+
+typedef struct
+{
+	uint8_t		reg[16];
+	uint8_t		carry;
+	uint8_t		zero;
+	uint8_t		sign;
+	uint8_t		icarry;
+} state_t;
+
+typedef struct
+{
+	uint8_t		src;
+	uint8_t		dest;
+	uint8_t		alu;
+	uint8_t		flags;					// 1 carry, 2 zero and sign
+} step_t;
+
+static const char *reg_name[16] =
+{
+	"B", "C", "D", "E", "H", "L", "M", "A", "PCH", "PCL", "SPH", "SPL", "MAH", "MAL", "FLAG", "IR"
+};
+
+static const char *alu_name[16] =
+{
+	"ADDOP", "ADCOP", "SUBOP", "SBBOP", "ANDOP", "XOROP", "OROP", "CMPOP",
+	"INCLOP", "INCHOP", "DECLOP", "DECHOP", "RAROP", "RRCOP", "ZEROOP", "BYPASS"
+};
+
+static const char *addr_name[4] = { "HL", "PC", "SP", "MA" };
+
+static bool uses_a (int op)
+{
+	return op <= ALU_CMP;
+}
+
+static bool uses_carry (int op)
+{
+	return (op == ALU_ADC) || (op == ALU_SBB) || (op == ALU_RAR);
+}
+
+static bool uses_icarry (int op)
+{
+	return (op == ALU_INCH) || (op == ALU_DECH);
+}
+
+// the register pair an address select puts on the bus
+static uint32_t pair (int addr)
+{
+	static const int high[4] = { REG_H, REG_PCH, REG_SPH, REG_MAH };
+	return (1u << high[addr]) | (1u << (high[addr] + 1));
+}
+
+static uint32_t word_reads (uint32_t w)
+{
+	int src = CW_SRC (w);
+	int dest = CW_DEST (w);
+	int op = CW_ALU (w);
+	uint32_t r = 0;
+
+	if ((src == REG_M) || (dest == REG_M))
+	{
+		r |= pair (CW_ADDR (w));
+	}
+	if (src == REG_FLAG)
+	{
+		r |= R_CARRY | R_ZS;
+	}
+	else if ((src != REG_M) && (src != REG_IR) && (op != ALU_ZERO))
+	{
+		r |= 1u << src;
+	}
+	if (uses_a (op))
+	{
+		r |= 1u << REG_A;
+	}
+	if (uses_carry (op) || ((w & CW_CMC) && (w & CW_CARRYF)))
+	{
+		r |= R_CARRY;
+	}
+	if (uses_icarry (op))
+	{
+		r |= R_ICARRY;
+	}
+	return r;
+}
+
+static uint32_t word_writes (uint32_t w)
+{
+	int dest = CW_DEST (w);
+	uint32_t r = R_ICARRY;
+
+	if (dest == REG_FLAG)
+	{
+		r |= R_CARRY | R_ZS;
+	}
+	else if ((dest != REG_M) && (dest != REG_IR))
+	{
+		r |= 1u << dest;
+	}
+	if (w & CW_CARRYF)
+	{
+		r |= R_CARRY;
+	}
+	if (w & CW_ZSF)
+	{
+		r |= R_ZS;
+	}
+	return r;
+}
+
+// a step that only moves bytes between registers through the alu
+static bool plain (uint32_t w)
+{
+	int src = CW_SRC (w);
+	int dest = CW_DEST (w);
+
+	return (src != REG_M) && (src != REG_FLAG) && (src != REG_IR)
+		&& (dest != REG_M) && (dest != REG_FLAG) && (dest != REG_IR)
+		&& !(w & (CW_INTON | CW_INTOFF | CW_STC | CW_CMC | CW_XCHG));
+}
+
+static step_t to_step (uint32_t w)
+{
+	step_t s = { CW_SRC (w), CW_DEST (w), CW_ALU (w), ((w & CW_CARRYF) ? 1 : 0) | ((w & CW_ZSF) ? 2 : 0) };
+	return s;
+}
+
+static uint32_t step_reads (step_t s)
+{
+	return word_reads (s.src | (s.dest << 4) | (s.alu << 10));
+}
+
+static uint32_t step_writes (step_t s)
+{
+	return (1u << s.dest) | R_ICARRY | ((s.flags & 1) ? R_CARRY : 0) | ((s.flags & 2) ? R_ZS : 0);
+}
+
+// the same microcycle as machine_step, for the steps plain() lets through
+static inline void run_step (state_t *st, step_t s)
+{
+	uint8_t cout;
+	uint8_t r = alu (s.alu, st->reg[REG_A], st->reg[s.src], st->carry, st->icarry, &cout);
+
+	st->reg[s.dest] = r;
+	if (s.flags & 1)
+	{
+		st->carry = cout;
+	}
+	if (s.flags & 2)
+	{
+		st->zero = (r == 0);
+		st->sign = r >> 7;
+	}
+	st->icarry = cout;
+}
+
+static bool same (const state_t *a, const state_t *b, uint32_t live)
+{
+	for (int r = 0; r < 16; r++)
+	{
+		if ((live & (1u << r)) && (a->reg[r] != b->reg[r]))
+		{
+			return false;
+		}
+	}
+	return !(((live & R_CARRY) && (a->carry != b->carry))
+		|| ((live & R_ZS) && ((a->zero != b->zero) || (a->sign != b->sign)))
+		|| ((live & R_ICARRY) && (a->icarry != b->icarry)));
+}
+
+static uint64_t seed = 0x9e3779b97f4a7c15ull;
+
+static uint64_t xorshift (void)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+// carries and borrows only show up at the ends of the range, so half the bytes are
+// taken from around them
+static uint8_t random_byte (void)
+{
+	static const uint8_t edge[] = { 0x00, 0x01, 0x7f, 0x80, 0xfe, 0xff };
+
+	uint32_t x = xorshift ();
+	if (x & 1)
+	{
+		return edge[(x >> 1) % sizeof (edge)];
+	}
+	return (uint8_t) (x >> 8);
+}
+
+static void random_state (state_t *st)
+{
+	for (int r = 0; r < 16; r++)
+	{
+		st->reg[r] = random_byte ();
+	}
+	st->carry = xorshift () & 1;
+	st->zero = xorshift () & 1;
+	st->sign = xorshift () & 1;
+	st->icarry = xorshift () & 1;
+}
+
+// the group being searched
+static struct
+{
+	step_t		target[32];
+	int			length;
+	uint32_t	live;					// what has to come out the same
+	step_t		alphabet[16 * 16 * 16 * 4];
+	int			letters;
+	state_t		in[VECTORS];
+	state_t		out[VECTORS];
+	step_t		cand[MAX_DEPTH];
+	int			depth;
+	uint32_t	relevant;				// what a candidate's next step could read
+	uint64_t	*seen;					// hashes of the states after each prefix
+	uint64_t	tried;
+	bool		found;
+	bool		proved;
+	int			proof_bits;
+} g;
+
+// over the whole run
+static int groups, shorter, unproved, saved;
+
+#define SEEN_SIZE		(1 << 21)
+
+static uint64_t fingerprint (const state_t *st)
+{
+	uint64_t h = 14695981039346656037ull;
+
+	for (int v = 0; v < VECTORS; v++)
+	{
+		for (int r = 0; r < 16; r++)
+		{
+			if (g.relevant & (1u << r))
+			{
+				h = (h ^ st[v].reg[r]) * 1099511628211ull;
+			}
+		}
+		h = (h ^ (st[v].carry | (st[v].zero << 1) | (st[v].sign << 2) | (st[v].icarry << 3))) * 1099511628211ull;
+	}
+	return h | 8;
+}
+
+// false if a prefix no longer than k steps has left the same states already; the
+// length is kept in the low bits of each hash
+static bool first_seen (const state_t *st, int k)
+{
+	uint64_t h = fingerprint (st) & ~7ull;
+	size_t i = (h >> 3) & (SEEN_SIZE - 1);
+
+	while (g.seen[i] != 0)
+	{
+		if ((g.seen[i] & ~7ull) == h)
+		{
+			if ((int) (g.seen[i] & 7) <= k)
+			{
+				return false;
+			}
+			g.seen[i] = h | k;
+			return true;
+		}
+		i = (i + 1) & (SEEN_SIZE - 1);
+	}
+	g.seen[i] = h | k;
+	return true;
+}
+
+static uint32_t exposed_reads (const step_t *s, int n)
+{
+	uint32_t written = 0;
+	uint32_t r = 0;
+
+	for (int i = 0; i < n; i++)
+	{
+		r |= step_reads (s[i]) & ~written;
+		written |= step_writes (s[i]);
+	}
+	return r;
+}
+
+static bool check (const step_t *s, int n, const state_t *in)
+{
+	state_t a = *in;
+	state_t b = *in;
+
+	for (int i = 0; i < g.length; i++)
+	{
+		run_step (&a, g.target[i]);
+	}
+	for (int i = 0; i < n; i++)
+	{
+		run_step (&b, s[i]);
+	}
+	return same (&a, &b, g.live);
+}
+
+// every value of every input either sequence reads, the rest held at random values
+static bool prove (const step_t *s, int n)
+{
+	uint32_t inputs = exposed_reads (g.target, g.length) | exposed_reads (s, n);
+	int bits = 0;
+	uint8_t *where[32];
+	int width[32];
+	int fields = 0;
+	state_t base;
+
+	random_state (&base);
+	for (int r = 0; r < 16; r++)
+	{
+		if (inputs & (1u << r))
+		{
+			where[fields] = &base.reg[r];
+			width[fields++] = 8;
+		}
+	}
+	if (inputs & R_CARRY)
+	{
+		where[fields] = &base.carry;
+		width[fields++] = 1;
+	}
+	if (inputs & R_ZS)
+	{
+		where[fields] = &base.zero;
+		width[fields++] = 1;
+		where[fields] = &base.sign;
+		width[fields++] = 1;
+	}
+	if (inputs & R_ICARRY)
+	{
+		where[fields] = &base.icarry;
+		width[fields++] = 1;
+	}
+	for (int f = 0; f < fields; f++)
+	{
+		bits += width[f];
+	}
+	g.proof_bits = bits;
+	if (bits > PROOF_BITS)
+	{
+		return false;
+	}
+
+	for (uint32_t x = 0; x < (1u << bits); x++)
+	{
+		uint32_t v = x;
+		for (int f = 0; f < fields; f++)
+		{
+			*where[f] = v & ((1u << width[f]) - 1);
+			v >>= width[f];
+		}
+		if (!check (s, n, &base))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+static void print_step (step_t s, int addr)
+{
+	printf ("\tS_%s + D_%s + %s + %s%s%s,\n", reg_name[s.src], reg_name[s.dest], addr_name[addr], alu_name[s.alu],
+		(s.flags & 1) ? " + CARRYF" : "", (s.flags & 2) ? " + ZSF" : "");
+}
+
+static void leaf (const state_t *st)
+{
+	g.tried++;
+	for (int v = 0; v < VECTORS; v++)
+	{
+		if (!same (&g.out[v], &st[v], g.live))
+		{
+			return;
+		}
+	}
+	for (int k = 0; k < CHECKS; k++)
+	{
+		state_t in;
+		random_state (&in);
+		if (!check (g.cand, g.depth, &in))
+		{
+			return;
+		}
+	}
+
+	// a counterexample from an exhaustive proof is as good as a failed check
+	bool proved = prove (g.cand, g.depth);
+	if (!proved && (g.proof_bits <= PROOF_BITS))
+	{
+		return;
+	}
+	if (g.found && (!proved || g.proved))
+	{
+		return;
+	}
+	g.found = true;
+	g.proved = proved;
+	printf ("    %d steps instead of %d, %s over %d input bits:\n", g.depth, g.length,
+		proved ? "proved" : "not proved", g.proof_bits);
+	for (int i = 0; i < g.depth; i++)
+	{
+		print_step (g.cand[i], ADDR_PC);
+	}
+}
+
+static void search (int k, const state_t *st)
+{
+	if (g.found && g.proved)
+	{
+		return;
+	}
+	if (k == g.depth)
+	{
+		leaf (st);
+		return;
+	}
+	if ((k > 0) && !first_seen (st, k))
+	{
+		return;
+	}
+
+	state_t next[VECTORS];
+	for (int a = 0; a < g.letters; a++)
+	{
+		step_t s = g.alphabet[a];
+
+		// the last step has to leave something that matters
+		if ((k == g.depth - 1) && !(step_writes (s) & g.live & ~R_ICARRY))
+		{
+			continue;
+		}
+		g.cand[k] = s;
+		for (int v = 0; v < VECTORS; v++)
+		{
+			next[v] = st[v];
+			run_step (&next[v], s);
+		}
+		search (k + 1, next);
+	}
+}
+
+// search for something shorter than the group's steps that leaves live the same
+static void optimise (const step_t *steps, int n, uint32_t live, uint32_t usable, int max_depth)
+{
+	uint32_t uses = 0;
+	uint32_t writes = 0;
+
+	g.length = n;
+	memcpy (g.target, steps, n * sizeof (step_t));
+	for (int i = 0; i < n; i++)
+	{
+		uses |= step_reads (steps[i]) | step_writes (steps[i]);
+		writes |= step_writes (steps[i]);
+	}
+	g.live = live & (writes | uses);
+
+	// destinations: what the group writes and the scratch it may use; sources: those and
+	// what the group reads. cmp is sub without the result, which is written anyway
+	uint32_t dests = (writes | usable) & R_REGS;
+	uint32_t srcs = (uses | usable) & R_REGS;
+	uint32_t flags = (writes | usable) & (R_CARRY | R_ZS);
+	g.letters = 0;
+	for (int op = 0; op < 16; op++)
+	{
+		if (op == ALU_CMP)
+		{
+			continue;
+		}
+		for (int src = 0; src < 16; src++)
+		{
+			// zero doesn't look at its source, so one will do
+			if (!(srcs & (1u << src)) || ((op == ALU_ZERO) && (src != __builtin_ctz (srcs))))
+			{
+				continue;
+			}
+			for (int dest = 0; dest < 16; dest++)
+			{
+				if (!(dests & (1u << dest)))
+				{
+					continue;
+				}
+				for (int f = 0; f < 4; f++)
+				{
+					if (((f & 1) && !(flags & R_CARRY)) || ((f & 2) && !(flags & R_ZS)))
+					{
+						continue;
+					}
+					g.alphabet[g.letters++] = (step_t) { src, dest, op, f };
+				}
+			}
+		}
+	}
+	g.relevant = srcs | dests;
+
+	for (int v = 0; v < VECTORS; v++)
+	{
+		random_state (&g.in[v]);
+		g.out[v] = g.in[v];
+		for (int i = 0; i < n; i++)
+		{
+			run_step (&g.out[v], steps[i]);
+		}
+	}
+
+	g.found = false;
+	g.proved = false;
+	g.tried = 0;
+	for (g.depth = 0; (g.depth < n) && (g.depth <= max_depth) && !g.proved; g.depth++)
+	{
+		memset (g.seen, 0, SEEN_SIZE * sizeof (uint64_t));
+		search (0, g.in);
+		if (g.found)
+		{
+			break;
+		}
+	}
+	groups++;
+	if (g.found)
+	{
+		shorter++;
+		unproved += !g.proved;
+		saved += n - g.depth;
+	}
+	else
+	{
+		printf ("    nothing shorter in up to %d steps (%llu tried, %d kinds of step)\n",
+			(n - 1 < max_depth) ? n - 1 : max_depth, (unsigned long long) g.tried, g.letters);
+	}
+}
+
+static int find (int *parent, int i)
+{
+	while (parent[i] != i)
+	{
+		i = parent[i] = parent[parent[i]];
+	}
+	return i;
+}
+
+// one half: find its runs of plain steps and the independent groups within them
+static void half (int h, int max_depth)
+{
+	const uint32_t *w = &control[h * 32];
+	int n = 0;
+	uint32_t live[33];
+
+	while ((n < 32) && !(w[n] & LAST))
+	{
+		n++;
+	}
+	if (n == 32)
+	{
+		printf ("  no LAST\n");
+		return;
+	}
+	n++;
+	for (int i = 0; i < n; i++)
+	{
+		if (w[i] & CW_XCHG)
+		{
+			printf ("  swaps de and hl part way through, not searched\n");
+			return;
+		}
+	}
+
+	// what is live after each step
+	live[n] = R_ARCH;
+	for (int i = n - 1; i >= 0; i--)
+	{
+		live[i] = (live[i + 1] & ~word_writes (w[i])) | word_reads (w[i]);
+	}
+
+	bool any = false;
+	for (int start = 1; start < n; )
+	{
+		if (!plain (w[start]))
+		{
+			start++;
+			continue;
+		}
+		int end = start;
+		while ((end < n) && plain (w[end]))
+		{
+			end++;
+		}
+
+		// group the steps that share a register or flag; an alu op that takes the carry
+		// from the step before has to stay next to it
+		int parent[32];
+		for (int i = start; i < end; i++)
+		{
+			parent[i] = i;
+			uint32_t mine = (word_reads (w[i]) | word_writes (w[i])) & ~R_ICARRY;
+			for (int j = start; j < i; j++)
+			{
+				uint32_t theirs = (word_reads (w[j]) | word_writes (w[j])) & ~R_ICARRY;
+				if ((mine & theirs) || ((j == i - 1) && (word_reads (w[i]) & R_ICARRY)))
+				{
+					parent[find (parent, i)] = find (parent, j);
+				}
+			}
+			if ((end < n) && (word_reads (w[end]) & R_ICARRY))
+			{
+				parent[find (parent, i)] = find (parent, end - 1);
+			}
+		}
+
+		for (int root = start; root < end; root++)
+		{
+			if (find (parent, root) != root)
+			{
+				continue;
+			}
+			step_t steps[32];
+			int count = 0;
+			uint32_t others = 0;
+			for (int i = start; i < end; i++)
+			{
+				if (find (parent, i) == root)
+				{
+					steps[count++] = to_step (w[i]);
+				}
+				else
+				{
+					others |= word_reads (w[i]) | word_writes (w[i]);
+				}
+			}
+			// scratch registers and flags that nothing after the run, or else in it, needs
+			uint32_t usable = (R_SCRATCH | R_CARRY | R_ZS) & ~live[end] & ~others;
+			uint32_t out = live[end];
+			if ((end < n) && (word_reads (w[end]) & R_ICARRY))
+			{
+				out |= R_ICARRY;
+			}
+
+			printf ("  steps");
+			for (int i = start; i < end; i++)
+			{
+				if (find (parent, i) == root)
+				{
+					printf (" %d", i);
+				}
+			}
+			printf (":\n");
+			optimise (steps, count, out, usable, max_depth);
+			any = true;
+		}
+		start = end;
+	}
+	if (!any)
+	{
+		printf ("  nothing but memory and special steps\n");
+	}
+}
+
+int main (int argc, char **argv)
+{
+	int max_depth = 3;
+	int only = -1;
+	int opt;
+
+	while ((opt = getopt (argc, argv, "d:o:")) != -1)
+	{
+		switch (opt)
+		{
+			case 'd':	max_depth = atoi (optarg);					break;
+			case 'o':	only = (int) strtol (optarg, NULL, 16);		break;
+			default:
+				fprintf (stderr, "usage: superopt [-d depth] [-o opcode]\n");
+				return 2;
+		}
+	}
+	if ((max_depth < 0) || (max_depth > MAX_DEPTH))
+	{
+		fprintf (stderr, "depth is 0 to %d\n", MAX_DEPTH);
+		return 2;
+	}
+	g.seen = malloc (SEEN_SIZE * sizeof (uint64_t));
+
+	// each distinct half once, with the opcodes that run it
+	for (int h = 0; h < 512; h++)
+	{
+		int first = 0;
+		while ((first < h) && (memcmp (&control[first * 32], &control[h * 32], 32 * sizeof (uint32_t)) != 0))
+		{
+			first++;
+		}
+		if ((first < h) || ((only >= 0) && (h / 2 != only)))
+		{
+			continue;
+		}
+		printf ("%02x/%d", h / 2, h % 2);
+		for (int o = h + 1; o < 512; o++)
+		{
+			if (memcmp (&control[o * 32], &control[h * 32], 32 * sizeof (uint32_t)) == 0)
+			{
+				printf (" %02x/%d", o / 2, o % 2);
+			}
+		}
+		printf ("\n");
+		half (h, max_depth);
+		fflush (stdout);
+	}
+	printf ("%d groups searched, %d could be shorter (%d of those not proved), %d steps saved\n",
+		groups, shorter, unproved, saved);
+	free (g.seen);
+	return 0;
+}
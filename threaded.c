@@ -0,0 +1,243 @@
+// threaded dispatch: the ROM compiled at load time into an array of handler records,
+// one per slot, run either by jumping straight from one handler to the next through
+// their label addresses (GCC labels-as-values) or by a portable switch
+
+#include <stdio.h>
+
+#include "fake8080.h"
+
+// pick the handler kind for one decoded slot; anything the specialised handlers don't
+// cover exactly goes to the generic one, which does the full microcycle
+static int classify (const microcode_t *mc, int i)
+{
+	int w = mc->word[i];
+	int src = mc->src[w];
+	int dest = mc->dest[w];
+	int op = mc->alu[w];
+	int flags = mc->flags[w];
+	bool src_reg = (src != REG_M) && (src != REG_FLAG) && (src != REG_IR);
+	bool dest_reg = (dest != REG_M) && (dest != REG_FLAG) && (dest != REG_IR);
+
+	if (((i & 31) == 31) && !mc->last[w])
+	{
+		return OP_GENERIC;						// the step counter wraps within the block
+	}
+	if ((src == REG_M) && (dest == REG_IR) && (op == ALU_PASS) && ((flags & ~MF_PCINC) == 0))
+	{
+		return OP_FETCH;
+	}
+	if (flags == 0)
+	{
+		if (op == ALU_PASS)
+		{
+			if (src_reg && dest_reg)
+			{
+				return OP_MOV;
+			}
+			if ((src == REG_M) && dest_reg)
+			{
+				return OP_LOAD;
+			}
+			if (src_reg && (dest == REG_M))
+			{
+				return OP_STORE;
+			}
+		}
+		if (src_reg && dest_reg)
+		{
+			switch (op)
+			{
+				case ALU_INCL:	return OP_INCL;
+				case ALU_INCH:	return OP_INCH;
+				case ALU_DECL:	return OP_DECL;
+				case ALU_DECH:	return OP_DECH;
+			}
+		}
+	}
+	if (((flags & ~(MF_CARRY | MF_ZS)) == 0) && (src_reg || (src == REG_M)) && dest_reg)
+	{
+		return OP_ALU;
+	}
+
+	// a step of the inc16 variant's pair incrementer, with nothing else going on, is
+	// the same work as the superoperator for the two alu steps it replaces
+	if (((flags == MF_INC16) || (flags == MF_DEC16)) && (src == dest) && (op == ALU_PASS)
+		&& dest_reg && (dest != REG_A))
+	{
+		return (flags == MF_INC16) ? OP_INC16 : OP_DEC16;
+	}
+	return OP_GENERIC;
+}
+
+// the register pairs as low codes, the high half being the code below
+static bool pair_low (int r)
+{
+	return (r == REG_C) || (r == REG_E) || (r == REG_L) || (r == REG_PCL) || (r == REG_SPL) || (r == REG_MAL);
+}
+
+// the registers dad can add to hl
+static bool addend (int r)
+{
+	return (r <= REG_L) || (r == REG_SPH) || (r == REG_SPL);
+}
+
+// a plain register transfer: no flags, src to dest through op
+static bool plain (const microcode_t *mc, int i, int src, int dest, int op)
+{
+	int w = mc->word[i];
+
+	return (mc->src[w] == src) && (mc->dest[w] == dest) && (mc->alu[w] == op) && (mc->flags[w] == 0);
+}
+
+// the superoperator starting at slot i, if there is one, with the slots it covers;
+// all but the last of them have to be in the same half and none of them LAST. In a
+// half with no LAST slot 31 is left out, since only the generic handler follows the
+// step counter round to step 0
+static int fuse (const microcode_t *mc, int i, int *span)
+{
+	const uint16_t *w = &mc->word[i];
+	int lo = mc->src[w[0]];
+	int hi = lo - 1;
+	int room = 32 - (i & 31);
+	bool ends = false;
+
+	for (int n = 0; (n < room) && !ends; n++)
+	{
+		if (mc->last[w[n]])
+		{
+			room = n + 1;
+			ends = true;
+		}
+	}
+	if (!ends)
+	{
+		room--;
+	}
+
+	if ((room >= 2) && pair_low (lo))
+	{
+		bool inc = plain (mc, i, lo, lo, ALU_INCL) && plain (mc, i + 1, hi, hi, ALU_INCH);
+		bool dec = plain (mc, i, lo, lo, ALU_DECL) && plain (mc, i + 1, hi, hi, ALU_DECH);
+
+		if (dec && (lo == REG_SPL) && (room >= 3) && (mc->dest[w[2]] == REG_M) && (mc->addr[w[2]] == ADDR_SP)
+			&& (mc->alu[w[2]] == ALU_PASS) && (mc->flags[w[2]] == 0)
+			&& (mc->src[w[2]] != REG_M) && (mc->src[w[2]] != REG_IR))
+		{
+			*span = 3;
+			return OP_PUSH;
+		}
+		if (inc || dec)
+		{
+			*span = 2;
+			return inc ? OP_INC16 : OP_DEC16;
+		}
+	}
+
+	// dad parks the accumulator in mah, adds a pair to hl through it and puts it back
+	if (room >= 6)
+	{
+		if (addend (mc->src[w[2]]) && addend (mc->src[w[4]]) && plain (mc, i, REG_A, REG_MAH, ALU_PASS) && plain (mc, i + 1, REG_L, REG_A, ALU_PASS)
+			&& (mc->dest[w[2]] == REG_L) && (mc->alu[w[2]] == ALU_ADD) && (mc->flags[w[2]] == MF_CARRY)
+			&& plain (mc, i + 3, REG_H, REG_A, ALU_PASS)
+			&& (mc->dest[w[4]] == REG_H) && (mc->alu[w[4]] == ALU_ADC) && (mc->flags[w[4]] == MF_CARRY)
+			&& plain (mc, i + 5, REG_MAH, REG_A, ALU_PASS))
+		{
+			*span = 6;
+			return OP_DAD;
+		}
+	}
+	return -1;
+}
+
+// the handler kinds for the last step of a sequence
+enum
+{
+	OP_GENERIC_LAST = OP_GENERIC + 1,
+	OP_FETCH_LAST = OP_FETCH + 1,
+	OP_MOV_LAST = OP_MOV + 1,
+	OP_LOAD_LAST = OP_LOAD + 1,
+	OP_STORE_LAST = OP_STORE + 1,
+	OP_INCL_LAST = OP_INCL + 1,
+	OP_INCH_LAST = OP_INCH + 1,
+	OP_DECL_LAST = OP_DECL + 1,
+	OP_DECH_LAST = OP_DECH + 1,
+	OP_ALU_LAST = OP_ALU + 1,
+	OP_INC16_LAST = OP_INC16 + 1,
+	OP_DEC16_LAST = OP_DEC16 + 1,
+	OP_PUSH_LAST = OP_PUSH + 1,
+	OP_DAD_LAST = OP_DAD + 1,
+};
+
+// a record for each slot of the decoded microcode, so halves that share a sequence
+// share its records too
+void thread_build (thread_t *t, const microcode_t *mc, bool fusion)
+{
+	for (int i = 0; i < mc->sequences * 32; i++)
+	{
+		thread_op_t *p = &t->op[i];
+		const uint16_t *w = &mc->word[i];
+		int span;
+		int kind = fuse (mc, i, &span);
+
+		p->handler = NULL;
+		p->src = mc->src[w[0]];
+		p->dest = mc->dest[w[0]];
+		p->addr = mc->addr[w[0]];
+		p->alu = mc->alu[w[0]];
+		p->flags = mc->flags[w[0]];
+		if (fusion && (kind >= 0))
+		{
+			p->op = kind | mc->last[w[span - 1]];
+			p->span = span;
+			switch (kind)
+			{
+				case OP_INC16:
+				case OP_DEC16:
+					p->dest = p->src - 1;
+					break;
+				case OP_PUSH:
+					p->src = mc->src[w[2]];
+					break;
+				case OP_DAD:
+					p->src = mc->src[w[2]];
+					p->dest = mc->src[w[4]];
+					break;
+			}
+		}
+		else
+		{
+			kind = classify (mc, i);
+			p->op = kind | mc->last[w[0]];
+			p->span = 1;
+			if ((kind == OP_INC16) || (kind == OP_DEC16))
+			{
+				p->src = p->dest | 1;
+				p->dest &= ~1;
+			}
+		}
+	}
+	t->mc = mc;
+#if defined(__GNUC__) && !defined(NO_COMPUTED_GOTO)
+	machine_run_threaded (NULL, t, NULL);
+#endif
+}
+
+#if defined(__GNUC__) && !defined(NO_COMPUTED_GOTO)
+const bool threaded_goto = true;
+#define ENGINE			machine_run_threaded
+#define THREADED_GOTO
+#include "threaded_body.h"
+#undef ENGINE
+#undef THREADED_GOTO
+#else
+// no labels-as-values: the threaded engine is the switch one
+const bool threaded_goto = false;
+int machine_run_threaded (machine_t *m, const thread_t *t, const run_limits_t *lim)
+{
+	return machine_run_switch (m, t, lim);
+}
+#endif
+
+#define ENGINE			machine_run_switch
+#include "threaded_body.h"
+#undef ENGINE
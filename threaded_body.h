@@ -0,0 +1,247 @@
+// the threaded engine, included twice by threaded.c: once with THREADED_GOTO defined,
+// where each handler jumps straight to the next through the label address stored in
+// its record, and once as a loop around a switch on the record's kind
+//
+// every handler has a second copy for the last step of a sequence, which finishes
+// the instruction instead of moving on to the next record
+
+#ifdef THREADED_GOTO
+#define TARGET(op)		L_##op
+#define DISPATCH()		goto *p->handler
+#else
+#define TARGET(op)		case op
+#define DISPATCH()		continue
+#endif
+
+#define STEP(op, body)											\
+	TARGET (op):												\
+		body;													\
+		m->cycles++;											\
+		p++;													\
+		DISPATCH ();											\
+	TARGET (op##_LAST):											\
+		body;													\
+		m->cycles++;											\
+		goto end_insn;
+
+// a handler that loads the instruction register works out the next record from the
+// new opcode's sequence rather than just moving along
+#define STEP_ADDRESSED(op, body)								\
+	TARGET (op):												\
+		body;													\
+		m->cycles++;											\
+		p = base + ((seq[(m->reg[REG_IR] << 1) | m->cond] << 5) | ((p - base + 1) & 31));	\
+		DISPATCH ();											\
+	TARGET (op##_LAST):											\
+		body;													\
+		m->cycles++;											\
+		goto end_insn;
+
+// a superoperator does the work of span slots and counts a cycle for each
+#define FUSED(op, body)											\
+	TARGET (op):												\
+		body;													\
+		m->cycles += p->span;									\
+		p += p->span;											\
+		DISPATCH ();											\
+	TARGET (op##_LAST):											\
+		body;													\
+		m->cycles += p->span;									\
+		goto end_insn;
+
+int ENGINE (machine_t *m, const thread_t *t, const run_limits_t *lim)
+{
+#ifdef THREADED_GOTO
+	static const void *const labels[OP_KINDS] =
+	{
+		&&L_OP_GENERIC,	&&L_OP_GENERIC_LAST,
+		&&L_OP_FETCH,	&&L_OP_FETCH_LAST,
+		&&L_OP_MOV,		&&L_OP_MOV_LAST,
+		&&L_OP_LOAD,	&&L_OP_LOAD_LAST,
+		&&L_OP_STORE,	&&L_OP_STORE_LAST,
+		&&L_OP_INCL,	&&L_OP_INCL_LAST,
+		&&L_OP_INCH,	&&L_OP_INCH_LAST,
+		&&L_OP_DECL,	&&L_OP_DECL_LAST,
+		&&L_OP_DECH,	&&L_OP_DECH_LAST,
+		&&L_OP_ALU,		&&L_OP_ALU_LAST,
+		&&L_OP_INC16,	&&L_OP_INC16_LAST,
+		&&L_OP_DEC16,	&&L_OP_DEC16_LAST,
+		&&L_OP_PUSH,	&&L_OP_PUSH_LAST,
+		&&L_OP_DAD,		&&L_OP_DAD_LAST,
+	};
+
+	// called with no machine to fill in the label addresses after thread_build
+	if (m == NULL)
+	{
+		thread_t *bind = (thread_t *) t;
+		for (int i = 0; i < bind->mc->sequences * 32; i++)
+		{
+			bind->op[i].handler = labels[bind->op[i].op];
+		}
+		return 0;
+	}
+#endif
+
+	const thread_op_t *base = t->op;
+	const uint16_t *seq = t->mc->seq;
+	const thread_op_t *p;
+	const uint8_t *map;
+	uint8_t cout;
+	uint8_t r;
+	unsigned v;
+	int why;
+
+	// finish off an instruction we were stopped in the middle of
+	while (m->step != 0)
+	{
+		if (lim->max_cycles && (m->cycles >= lim->max_cycles))
+		{
+			return STOP_CYCLES;
+		}
+		machine_step_decoded (m, t->mc);
+	}
+
+	for (;;)
+	{
+		// the cycle limit is only looked at between instructions here, so hand the
+		// last few over to an engine that can stop on the exact cycle
+		if (lim->max_cycles && (m->cycles + 64 > lim->max_cycles))
+		{
+			return machine_run_decoded (m, t->mc, lim);
+		}
+
+		map = xmap[m->flip];
+		p = base + (seq[(m->reg[REG_IR] << 1) | m->cond] << 5);
+#ifdef THREADED_GOTO
+		DISPATCH ();
+#else
+		for (;;)
+		switch (p->op)
+#endif
+		{
+			// machine_execute counts its own cycle
+			TARGET (OP_GENERIC):
+				machine_execute (m, t->mc, (int) (p - base));
+				map = xmap[m->flip];
+				p = base + ((seq[(m->reg[REG_IR] << 1) | m->cond] << 5) | ((p - base + 1) & 31));
+				if (((p - base) & 31) == 0)
+				{
+					goto wrapped;
+				}
+				DISPATCH ();
+			TARGET (OP_GENERIC_LAST):
+				machine_execute (m, t->mc, (int) (p - base));
+				goto end_insn;
+
+			// the pc counts on during the fetch in the seq -v overlap variant
+			STEP_ADDRESSED (OP_FETCH,
+				m->reg[REG_IR] = machine_read (m, machine_address (m, p->addr));
+				m->cond = machine_condition (m, m->reg[REG_IR]);
+				if (p->flags & MF_PCINC)
+				{
+					v = machine_pc (m) + 1;
+					m->reg[REG_PCL] = v;
+					m->reg[REG_PCH] = v >> 8;
+				}
+				m->icarry = 0)
+
+			STEP (OP_MOV,
+				m->reg[map[p->dest]] = m->reg[map[p->src]];
+				m->icarry = 0)
+
+			STEP (OP_LOAD,
+				m->reg[map[p->dest]] = machine_read (m, machine_address (m, p->addr));
+				m->icarry = 0)
+
+			STEP (OP_STORE,
+				machine_write (m, machine_address (m, p->addr), m->reg[map[p->src]]);
+				m->icarry = 0)
+
+			STEP (OP_INCL,
+				r = m->reg[map[p->src]] + 1;
+				m->icarry = (r == 0);
+				m->reg[map[p->dest]] = r)
+
+			STEP (OP_INCH,
+				r = m->reg[map[p->src]] + m->icarry;
+				m->icarry = m->icarry && (r == 0);
+				m->reg[map[p->dest]] = r)
+
+			STEP (OP_DECL,
+				r = m->reg[map[p->src]];
+				m->icarry = (r == 0);
+				m->reg[map[p->dest]] = r - 1)
+
+			STEP (OP_DECH,
+				r = m->reg[map[p->src]];
+				m->reg[map[p->dest]] = r - m->icarry;
+				m->icarry = m->icarry && (r == 0))
+
+			STEP (OP_ALU,
+				r = (p->src == REG_M) ? machine_read (m, machine_address (m, p->addr)) : m->reg[map[p->src]];
+				r = alu (p->alu, m->reg[REG_A], r, m->carry, m->icarry, &cout);
+				m->reg[map[p->dest]] = r;
+				if (p->flags & MF_CARRY)
+				{
+					m->carry = cout;
+				}
+				if (p->flags & MF_ZS)
+				{
+					m->zero = (r == 0);
+					m->sign = r >> 7;
+				}
+				m->icarry = cout)
+
+			// the carry out of the high half is the carry out of the pair
+			FUSED (OP_INC16,
+				v = ((m->reg[map[p->dest]] << 8) | m->reg[map[p->src]]) + 1;
+				m->reg[map[p->src]] = v;
+				m->reg[map[p->dest]] = v >> 8;
+				m->icarry = (v >> 16) & 1)
+
+			FUSED (OP_DEC16,
+				v = ((m->reg[map[p->dest]] << 8) | m->reg[map[p->src]]) - 1;
+				m->reg[map[p->src]] = v;
+				m->reg[map[p->dest]] = v >> 8;
+				m->icarry = (v >> 16) & 1)
+
+			FUSED (OP_PUSH,
+				v = (((m->reg[REG_SPH] << 8) | m->reg[REG_SPL]) - 1) & 0xffff;
+				m->reg[REG_SPL] = v;
+				m->reg[REG_SPH] = v >> 8;
+				machine_write (m, v, (p->src == REG_FLAG) ? machine_flags (m) : m->reg[map[p->src]]);
+				m->icarry = 0)
+
+			// the accumulator ends up where it started, by way of mah
+			FUSED (OP_DAD,
+				m->reg[REG_MAH] = m->reg[REG_A];
+				v = m->reg[map[REG_L]] + m->reg[map[p->src]];
+				m->reg[map[REG_L]] = v;
+				v = m->reg[map[REG_H]] + m->reg[map[p->dest]] + (v >> 8);
+				m->reg[map[REG_H]] = v;
+				m->carry = v >> 8;
+				m->icarry = 0)
+		}
+
+		// a sequence with no LAST came round to its step 0 again; going back round the
+		// loop looks at the cycle limit once a lap, as nothing else would stop it. Only
+		// the generic handler gets here: thread_build leaves slot 31 of such a half to it
+		// alone, unfused, so no other handler moves on from there
+	wrapped:
+		continue;
+
+	end_insn:
+		m->instructions++;
+		why = machine_limit (m, lim);
+		if (why >= 0)
+		{
+			return why;
+		}
+	}
+}
+
+#undef TARGET
+#undef DISPATCH
+#undef STEP
+#undef STEP_ADDRESSED
+#undef FUSED
@@ -0,0 +1,948 @@
+// time the gates of the Fake8080 design with the delays of 74HC parts
+//
+// usage: timing [-c file.circ] [-m microcode.raw] [-i keyboard.txt] [-n cycles] [-x stop_pc]
+//			[-w idle_polls] [-t rows] [-e] [-q] image.raw
+//
+// imports the Fake8080 circuit from the .circ file (ALU_181_base.circ unless -c names
+// another), loads the microcode into the sequencer ROM and the image into the RAM, and
+// runs it as gatesim does, but event by event: each element takes the delay of the part
+// it would be built from (the table below) to follow a change at its inputs, so every
+// net changes when it would on the board. Each edge of the clock is left until nothing
+// more changes before the next, and the last net to change is how long that edge needs
+// to settle. The microstep an edge settles is the sequencer ROM's address after it,
+// which is the opcode, condition and step the control word is for
+//
+// the report gives, for each edge, the microsteps that took longest to settle, with the
+// alu operation in their control word and the net that changed last, then the shortest
+// high and low times the clock could have, and the chain of changes from the clock to
+// that last net on the slowest edge of each. -t sets how many microsteps are listed, and
+// -e prints every edge on stdout: cycle, rise or fall, ROM address, ns and last net
+//
+// the delays are typical ones at 4.5 V and 50 pF and take no account of setup times,
+// fanout or wiring, so the clock rates are for comparing microsteps and designs, not a
+// guarantee for a board
+//
+//		cc -O2 -o timing timing.c netlist.c machine.c rom.c
+//		./timing -x 0 cpudiag.raw
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "fake8080.h"
+#include "netlist.h"
+
+#define WHEEL		256				// ns the timing wheel looks ahead, more than any delay
+#define NONE		UINT32_MAX
+#define PATH_MAX_STEPS	256
+
+// ns for each kind of element to follow its inputs: data is from the inputs it follows
+// or its clock, control from a select, enable, preset, reset, clear or output enable
+typedef struct
+{
+	uint8_t		data;
+	uint8_t		control;
+} delay_t;
+
+static const delay_t delays[NL_KINDS] =
+{
+	[NL_AND]		= { 9, 9 },			// 74HC08, 74HC11, 74HC21, and 74HC00 for a NAND
+	[NL_OR]			= { 9, 9 },			// 74HC32, 74HC4075, and 74HC02 for a NOR
+	[NL_XOR]		= { 11, 11 },		// 74HC86, and 74HC266 for an XNOR
+	[NL_NOT]		= { 8, 8 },			// 74HC04
+	[NL_TRI]		= { 10, 13 },		// 74HC244
+	[NL_MUX]		= { 8, 11 },		// and 3 more for each select bit: 74HC157, 153, 151
+	[NL_DECODER]	= { 9, 14 },		// and 2 more for each select bit: 74HC139, 138, 154
+	[NL_COMPARE]	= { 10, 10 },		// and 7 for each 8 bits: 74HC688s
+	[NL_DFF]		= { 16, 18 },		// 74HC74
+	[NL_JKFF]		= { 17, 18 },		// 74HC109
+	[NL_REG]		= { 16, 16 },		// 74HC574, or 74HC377 with an enable and 74HC273 with a clear
+	[NL_ROM]		= { 70, 70 },		// a 70 ns flash, four side by side for 32 bits
+	[NL_RAM]		= { 55, 25 },		// a 55 ns 62256
+	[NL_KEYBOARD]	= { 10, 10 },		// the terminal's latch
+};
+#define GATE_WIDE		5				// more for a gate of more than four inputs (74HC4078)
+
+static const char *const alu_name[16] =
+{
+	"add", "adc", "sub", "sbb", "and", "xor", "or", "cmp",
+	"incl", "inch", "decl", "dech", "rar", "rrc", "zero", "pass",
+};
+
+typedef struct
+{
+	uint32_t	pin;					// the output, in nl->pins, that changes
+	uint32_t	cause;					// the net whose change it follows
+	uint32_t	next;
+	uint8_t		value;
+} event_t;
+
+// the slowest settle of each half clock seen for a microstep
+typedef struct
+{
+	uint64_t	count;
+	uint32_t	ns[2];					// after the rising and falling edges
+	uint32_t	net[2];
+} micro_t;
+
+// one step of the chain of changes to the last net
+typedef struct
+{
+	uint32_t	net;
+	uint32_t	ns;
+} step_t;
+
+typedef struct
+{
+	uint32_t	ns;
+	uint32_t	addr;
+	uint64_t	cycle;
+	int			steps;
+	step_t		step[PATH_MAX_STEPS];
+} path_t;
+
+static netlist_t nl;
+static uint32_t rom[ROM_WORDS];
+static uint8_t ram[MEM_SIZE];
+
+// the nets, as they are and as they were at the start of the ns being worked through
+static uint8_t *val;
+static uint8_t *before;
+static uint8_t *touched;
+static uint64_t *changed_at;
+static uint32_t *cause;
+static uint32_t *changed;
+static uint32_t nchanged;
+
+// what drives and reads each net, as runs of output pins and of (element, input) pairs
+static uint32_t *driver_first;
+static uint32_t *driver;
+static uint32_t *reader_first;
+static uint32_t *reader;
+static uint16_t *reader_input;
+static uint32_t *element_of;			// the element each pin is on
+
+// the outputs: what each drives now, what it will once its events are done, and when
+static uint8_t *drive;
+static uint8_t *sched;
+static uint64_t *when;
+
+// the elements: state, delays and what has set them off in this ns
+static uint32_t *state;					// first byte in bits
+static uint8_t *bits;
+static uint8_t *delay_data;
+static uint8_t *delay_control;
+static uint64_t *stamp;
+static uint8_t *trigger_delay;
+static uint32_t *trigger_cause;
+static uint8_t *trigger_clock;
+static uint32_t *evaluate;
+static uint32_t nevaluate;
+
+// the timing wheel, with a free list of events
+static event_t *events;
+static uint32_t nevents;
+static uint32_t free_event = NONE;
+static uint32_t head[WHEEL];
+static uint32_t tail[WHEEL];
+static uint64_t pending;
+static uint64_t now;
+static uint64_t slots;
+static uint64_t total_events;
+
+// the last change since the edge
+static uint64_t last_time;
+static uint32_t last_net;
+
+// the terminal, with a machine to type its input and print its output
+static machine_t term;
+
+static double seconds (void)
+{
+	struct timespec ts;
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint8_t *read_file (const char *path, size_t *len)
+{
+	FILE *f = fopen (path, "rb");
+	if (f == NULL)
+	{
+		fprintf (stderr, "Can't open %s\n", path);
+		return NULL;
+	}
+	size_t cap = 4096;
+	uint8_t *buf = malloc (cap);
+	*len = 0;
+	size_t got;
+	while ((got = fread (buf + *len, 1, cap - *len, f)) > 0)
+	{
+		*len += got;
+		if (*len == cap)
+		{
+			cap *= 2;
+			buf = realloc (buf, cap);
+		}
+	}
+	fclose (f);
+	return buf;
+}
+
+// ---- the netlist
+
+static uint32_t bus_value (const uint8_t *v, const uint32_t *nets, uint32_t width)
+{
+	uint32_t x = 0;
+	for (uint32_t b = 0; b < width; b++)
+	{
+		x |= (uint32_t) v[nets[b]] << b;
+	}
+	return x;
+}
+
+static const nl_element_t *find_element (int kind, const char *name)
+{
+	for (uint32_t i = 0; i < nl.elements; i++)
+	{
+		if ((nl.element[i].kind == kind) && ((name == NULL) || (strcmp (nl.names + nl.element[i].name, name) == 0)))
+		{
+			return &nl.element[i];
+		}
+	}
+	fprintf (stderr, "There's no %s %s in %s\n", nl_kind_name[kind], name ? name : "", nl.top);
+	exit (1);
+}
+
+static uint32_t find_net (const char *name)
+{
+	for (uint32_t n = 0; n < nl.nets; n++)
+	{
+		if (nl.net_name[n] && (strcmp (nl.names + nl.net_name[n], name) == 0))
+		{
+			return n;
+		}
+	}
+	fprintf (stderr, "There's no net %s in %s\n", name, nl.top);
+	exit (1);
+}
+
+// a net's name, or failing that what drives it
+static void print_net (FILE *f, uint32_t n)
+{
+	if (n == NONE)
+	{
+		fprintf (f, "nothing changed");
+	}
+	else if (nl.net_name[n])
+	{
+		fprintf (f, "%s", nl.names + nl.net_name[n]);
+	}
+	else if (driver_first[n] < driver_first[n + 1])
+	{
+		const nl_element_t *e = &nl.element[element_of[driver[driver_first[n]]]];
+		fprintf (f, "net %u, %s in %s (%u,%u)", n, nl_kind_name[e->kind], nl.names + e->name, e->x, e->y);
+	}
+	else
+	{
+		fprintf (f, "net %u", n);
+	}
+}
+
+// which delay a change at input j of e takes to reach its outputs
+static bool is_control (const nl_element_t *e, uint32_t j)
+{
+	switch (e->kind)
+	{
+		case NL_TRI:		return j == e->width;
+		case NL_MUX:		return j >= (1u << e->arg) * e->width;
+		case NL_DECODER:	return j == e->arg;
+		case NL_DFF:		return j >= 2;
+		case NL_JKFF:		return j >= 3;
+		case NL_REG:		return j == (uint32_t) e->ins - 1;
+		case NL_RAM:		return j == e->arg + 1;
+		default:			return false;
+	}
+}
+
+static void build (void)
+{
+	uint32_t n = nl.nets;
+	val = calloc (n, 1);
+	before = calloc (n, 1);
+	touched = calloc (n, 1);
+	changed_at = calloc (n, sizeof (uint64_t));
+	cause = malloc (n * sizeof (uint32_t));
+	changed = malloc (n * sizeof (uint32_t));
+	driver_first = calloc (n + 1, sizeof (uint32_t));
+	reader_first = calloc (n + 1, sizeof (uint32_t));
+	driver = malloc ((nl.npins + 1) * sizeof (uint32_t));
+	reader = malloc ((nl.npins + 1) * sizeof (uint32_t));
+	reader_input = malloc ((nl.npins + 1) * sizeof (uint16_t));
+	element_of = malloc ((nl.npins + 1) * sizeof (uint32_t));
+	drive = calloc (nl.npins + 1, 1);
+	sched = calloc (nl.npins + 1, 1);
+	when = calloc (nl.npins + 1, sizeof (uint64_t));
+	state = calloc (nl.elements + 1, sizeof (uint32_t));
+	delay_data = calloc (nl.elements + 1, 1);
+	delay_control = calloc (nl.elements + 1, 1);
+	stamp = malloc ((nl.elements + 1) * sizeof (uint64_t));
+	trigger_delay = calloc (nl.elements + 1, 1);
+	trigger_cause = calloc (nl.elements + 1, sizeof (uint32_t));
+	trigger_clock = calloc (nl.elements + 1, 1);
+	evaluate = malloc ((nl.elements + 1) * sizeof (uint32_t));
+	memset (cause, 0xff, n * sizeof (uint32_t));
+	memset (stamp, 0xff, (nl.elements + 1) * sizeof (uint64_t));
+	memset (head, 0xff, sizeof (head));
+
+	// count, then fill
+	uint32_t nbits = 0;
+	for (uint32_t i = 0; i < nl.elements; i++)
+	{
+		const nl_element_t *e = &nl.element[i];
+		for (uint32_t j = 0; j < e->ins; j++)
+		{
+			reader_first[nl_in (&nl, e)[j] + 1] += nl_follows (e, j) || ((int) j == nl_clock (e));
+		}
+		for (uint32_t j = 0; j < e->outs; j++)
+		{
+			driver_first[nl_out (&nl, e)[j] + 1]++;
+			element_of[e->pin + e->ins + j] = i;
+		}
+		if ((e->kind == NL_DFF) || (e->kind == NL_JKFF) || (e->kind == NL_REG))
+		{
+			state[i] = nbits;
+			nbits += e->width;
+		}
+
+		int extra = 0;
+		if ((e->kind == NL_AND) || (e->kind == NL_OR) || (e->kind == NL_XOR))
+		{
+			extra = (e->ins > 4) ? GATE_WIDE : 0;
+		}
+		else if (e->kind == NL_MUX)
+		{
+			extra = 3 * e->arg;
+		}
+		else if (e->kind == NL_DECODER)
+		{
+			extra = 2 * e->arg;
+		}
+		else if (e->kind == NL_COMPARE)
+		{
+			extra = 7 * ((e->width + 7) / 8);
+		}
+		delay_data[i] = delays[e->kind].data + extra;
+		delay_control[i] = delays[e->kind].control + ((e->kind == NL_DECODER) ? 0 : extra);
+	}
+	bits = calloc (nbits + 1, 1);
+	for (uint32_t i = 0; i < n; i++)
+	{
+		reader_first[i + 1] += reader_first[i];
+		driver_first[i + 1] += driver_first[i];
+	}
+	for (uint32_t i = 0; i < nl.elements; i++)
+	{
+		const nl_element_t *e = &nl.element[i];
+		for (uint32_t j = 0; j < e->ins; j++)
+		{
+			uint32_t net = nl_in (&nl, e)[j];
+			if (nl_follows (e, j) || ((int) j == nl_clock (e)))
+			{
+				reader_input[reader_first[net]] = j;
+				reader[reader_first[net]++] = i;
+			}
+		}
+		for (uint32_t j = 0; j < e->outs; j++)
+		{
+			driver[driver_first[nl_out (&nl, e)[j]]++] = e->pin + e->ins + j;
+		}
+	}
+	// the firsts have moved on to the next net's
+	for (uint32_t i = n; i > 0; i--)
+	{
+		reader_first[i] = reader_first[i - 1];
+		driver_first[i] = driver_first[i - 1];
+	}
+	reader_first[0] = 0;
+	driver_first[0] = 0;
+	val[NL_HIGH] = before[NL_HIGH] = 1;
+}
+
+// ---- the timing wheel
+
+// output pin takes value at time at, after whatever it is already to do
+static void post (uint32_t pin, uint8_t value, uint64_t at, uint32_t why)
+{
+	if (sched[pin] == value)
+	{
+		return;
+	}
+	sched[pin] = value;
+	at = (at > when[pin]) ? at : when[pin];
+	when[pin] = at;
+
+	if (free_event == NONE)
+	{
+		events = realloc (events, (nevents + 1024) * sizeof (event_t));
+		for (uint32_t k = 0; k < 1024; k++)
+		{
+			events[nevents + k].next = free_event;
+			free_event = nevents + k;
+		}
+		nevents += 1024;
+	}
+	uint32_t k = free_event;
+	free_event = events[k].next;
+	events[k] = (event_t) { pin, why, NONE, value };
+	uint32_t slot = at % WHEEL;
+	if (head[slot] == NONE)
+	{
+		head[slot] = k;
+	}
+	else
+	{
+		events[tail[slot]].next = k;
+	}
+	tail[slot] = k;
+	pending++;
+	total_events++;
+}
+
+static void post_outputs (uint32_t i, const uint8_t *out, uint64_t at)
+{
+	const nl_element_t *e = &nl.element[i];
+	for (uint32_t j = 0; j < e->outs; j++)
+	{
+		post (e->pin + e->ins + j, out[j], at, trigger_cause[i]);
+	}
+}
+
+static bool edge (const nl_element_t *e, uint32_t clock)
+{
+	return (e->flags & NL_FALLING) ? (before[clock] && !val[clock]) : (!before[clock] && val[clock]);
+}
+
+// works out e's outputs from its inputs now, or clocks it, and posts what changes
+static void eval (uint32_t i, uint64_t t)
+{
+	const nl_element_t *e = &nl.element[i];
+	const uint32_t *in = nl_in (&nl, e);
+	uint8_t out[256];
+	uint64_t at = t + trigger_delay[i];
+	uint8_t *s = &bits[state[i]];
+	uint32_t v, w;
+
+	switch (e->kind)
+	{
+		case NL_AND:
+		case NL_OR:
+		case NL_XOR:
+			v = (e->kind == NL_AND);
+			for (uint32_t j = 0; j < e->ins; j++)
+			{
+				v = (e->kind == NL_AND) ? v & val[in[j]] : (e->kind == NL_OR) ? v | val[in[j]] : v ^ val[in[j]];
+			}
+			out[0] = v ^ (e->flags & NL_INVERT);
+			break;
+
+		case NL_NOT:
+			out[0] = val[in[0]] ^ 1;
+			break;
+
+		case NL_TRI:
+			for (uint32_t b = 0; b < e->width; b++)
+			{
+				out[b] = val[in[b]] & val[in[e->width]];
+			}
+			break;
+
+		case NL_MUX:
+			v = bus_value (val, &in[(1u << e->arg) * e->width], e->arg);
+			for (uint32_t b = 0; b < e->width; b++)
+			{
+				out[b] = val[in[v * e->width + b]];
+			}
+			break;
+
+		case NL_DECODER:
+			v = bus_value (val, in, e->arg);
+			for (uint32_t b = 0; b < e->outs; b++)
+			{
+				out[b] = val[in[e->arg]] & (v == b);
+			}
+			break;
+
+		case NL_COMPARE:
+		{
+			uint32_t flip = (e->flags & NL_SIGNED) ? 1u << (e->width - 1) : 0;
+			v = bus_value (val, in, e->width) ^ flip;
+			w = bus_value (val, &in[e->width], e->width) ^ flip;
+			out[0] = v > w;
+			out[1] = v == w;
+			out[2] = v < w;
+			break;
+		}
+
+		case NL_DFF:
+		case NL_JKFF:
+		{
+			uint32_t clock = in[nl_clock (e)];
+			if (trigger_clock[i] && edge (e, clock))
+			{
+				s[0] = (e->kind == NL_DFF) ? before[in[0]] : (before[in[0]] & (s[0] ^ 1)) | ((before[in[1]] ^ 1) & s[0]);
+			}
+			if (val[in[e->ins - 1]])
+			{
+				s[0] = 0;
+			}
+			else if (val[in[e->ins - 2]])
+			{
+				s[0] = 1;
+			}
+			out[0] = s[0];
+			out[1] = s[0] ^ 1;
+			break;
+		}
+
+		case NL_REG:
+			if (trigger_clock[i] && edge (e, in[e->width + 1]) && before[in[e->width]])
+			{
+				for (uint32_t b = 0; b < e->width; b++)
+				{
+					s[b] = before[in[b]];
+				}
+			}
+			if (val[in[e->ins - 1]])
+			{
+				memset (s, 0, e->width);
+			}
+			memcpy (out, s, e->width);
+			break;
+
+		case NL_ROM:
+			v = rom[bus_value (val, in, e->arg) & (ROM_WORDS - 1)];
+			for (uint32_t b = 0; b < e->width; b++)
+			{
+				out[b] = (v >> b) & 1;
+			}
+			break;
+
+		case NL_RAM:
+			if (trigger_clock[i] && edge (e, in[e->arg + 2]) && before[in[e->arg]])
+			{
+				ram[bus_value (before, in, e->arg) & (MEM_SIZE - 1)] = bus_value (before, &in[e->arg + 3], e->width);
+			}
+			v = val[in[e->arg + 1]] ? ram[bus_value (val, in, e->arg) & (MEM_SIZE - 1)] : 0;
+			for (uint32_t b = 0; b < e->width; b++)
+			{
+				out[b] = (v >> b) & 1;
+			}
+			break;
+
+		case NL_TTY:
+			if (trigger_clock[i] && edge (e, in[7]) && before[in[8]])
+			{
+				machine_write_io (&term, bus_value (before, in, 7));
+			}
+			return;
+
+		case NL_KEYBOARD:
+			if (trigger_clock[i] && edge (e, in[0]) && before[in[1]])
+			{
+				machine_read_io (&term);
+			}
+			v = (term.kbd_pos < term.kbd_len) ? term.kbd[term.kbd_pos] | 0x100 : 0;
+			out[0] = v >> 8;
+			for (uint32_t b = 0; b < 7; b++)
+			{
+				out[b + 1] = (v >> b) & 1;
+			}
+			break;
+
+		default:
+			return;
+	}
+	post_outputs (i, out, at);
+}
+
+// works through the wheel until nothing is left to change
+static void run (void)
+{
+	while (pending > 0)
+	{
+		uint32_t slot = now % WHEEL;
+		uint32_t k = head[slot];
+		head[slot] = NONE;
+		slots++;
+
+		// the outputs change, and with them the nets they drive
+		while (k != NONE)
+		{
+			event_t *ev = &events[k];
+			uint32_t next = ev->next;
+			uint32_t net = nl.pins[ev->pin];
+			uint8_t v = ev->value;
+			drive[ev->pin] = v;
+			for (uint32_t d = driver_first[net]; (d < driver_first[net + 1]) && (driver_first[net + 1] - driver_first[net] > 1); d++)
+			{
+				v |= drive[driver[d]];
+			}
+			if (v != val[net])
+			{
+				if (!touched[net])
+				{
+					touched[net] = 1;
+					changed[nchanged++] = net;
+				}
+				val[net] = v;
+				cause[net] = ev->cause;
+				changed_at[net] = now;
+			}
+			ev->next = free_event;
+			free_event = k;
+			pending--;
+			k = next;
+		}
+
+		// then everything reading them takes another look, once, with the longest of
+		// the delays from the inputs that changed
+		nevaluate = 0;
+		for (uint32_t c = 0; c < nchanged; c++)
+		{
+			uint32_t net = changed[c];
+			if (val[net] == before[net])
+			{
+				continue;
+			}
+			last_time = now;
+			last_net = net;
+			for (uint32_t r = reader_first[net]; r < reader_first[net + 1]; r++)
+			{
+				uint32_t i = reader[r];
+				const nl_element_t *e = &nl.element[i];
+				uint32_t j = reader_input[r];
+				uint8_t d = is_control (e, j) ? delay_control[i] : delay_data[i];
+				if (stamp[i] != now)
+				{
+					stamp[i] = now;
+					evaluate[nevaluate++] = i;
+					trigger_delay[i] = 0;
+					trigger_clock[i] = 0;
+				}
+				if (d >= trigger_delay[i])
+				{
+					trigger_delay[i] = d;
+					trigger_cause[i] = net;
+				}
+				trigger_clock[i] |= ((int) j == nl_clock (e));
+			}
+		}
+		for (uint32_t k = 0; k < nevaluate; k++)
+		{
+			eval (evaluate[k], now);
+		}
+		for (uint32_t c = 0; c < nchanged; c++)
+		{
+			before[changed[c]] = val[changed[c]];
+			touched[changed[c]] = 0;
+		}
+		nchanged = 0;
+		now++;
+	}
+}
+
+// an INPUT or the CLOCK takes a new value at once
+static void set_input (const nl_element_t *e, uint32_t value)
+{
+	for (uint32_t b = 0; b < e->outs; b++)
+	{
+		post (e->pin + e->ins + b, (value >> b) & 1, now, NONE);
+	}
+}
+
+// the chain of changes, last first, that led to net changing at the end of an edge
+static void trace (path_t *p, uint32_t net, uint64_t edge_time)
+{
+	p->steps = 0;
+	while ((net != NONE) && (p->steps < PATH_MAX_STEPS))
+	{
+		p->step[p->steps++] = (step_t) { net, (uint32_t) (changed_at[net] - edge_time) };
+		uint32_t from = cause[net];
+		if ((from == NONE) || (changed_at[from] > changed_at[net]) || (changed_at[from] < edge_time))
+		{
+			break;
+		}
+		net = from;
+	}
+}
+
+static void print_path (const path_t *p, const char *edge)
+{
+	printf ("\nthe slowest %s edge, %u ns, at cycle %llu in op %02x cond %u step %u:\n", edge, p->ns,
+		(unsigned long long) p->cycle, (p->addr >> 6) & 0xff, (p->addr >> 5) & 1, p->addr & 0x1f);
+	for (int k = p->steps - 1; k >= 0; k--)
+	{
+		printf ("    %4u  ", p->step[k].ns);
+		print_net (stdout, p->step[k].net);
+		printf ("\n");
+	}
+}
+
+static micro_t micro[ROM_WORDS];
+
+static int by_rise (const void *a, const void *b)
+{
+	const micro_t *x = &micro[*(const uint32_t *) a];
+	const micro_t *y = &micro[*(const uint32_t *) b];
+	return (x->ns[0] != y->ns[0]) ? ((x->ns[0] < y->ns[0]) ? 1 : -1) : ((*(const uint32_t *) a > *(const uint32_t *) b) ? 1 : -1);
+}
+
+static int by_fall (const void *a, const void *b)
+{
+	const micro_t *x = &micro[*(const uint32_t *) a];
+	const micro_t *y = &micro[*(const uint32_t *) b];
+	return (x->ns[1] != y->ns[1]) ? ((x->ns[1] < y->ns[1]) ? 1 : -1) : ((*(const uint32_t *) a > *(const uint32_t *) b) ? 1 : -1);
+}
+
+static void print_micro (int half, int rows)
+{
+	static uint32_t order[ROM_WORDS];
+	int used = 0;
+	for (uint32_t a = 0; a < ROM_WORDS; a++)
+	{
+		if (micro[a].count)
+		{
+			order[used++] = a;
+		}
+	}
+	qsort (order, used, sizeof (order[0]), half ? by_fall : by_rise);
+
+	printf ("\nafter the %s edge, the slowest microsteps:\n", half ? "falling" : "rising");
+	printf ("      ns  op  cond  step  alu       times  last to settle\n");
+	for (int k = 0; (k < used) && (k < rows); k++)
+	{
+		uint32_t a = order[k];
+		printf ("    %4u  %02x  %4u  %4u  %-5s %9llu  ", micro[a].ns[half], (a >> 6) & 0xff, (a >> 5) & 1, a & 0x1f,
+			alu_name[CW_ALU (rom[a])], (unsigned long long) micro[a].count);
+		print_net (stdout, micro[a].net[half]);
+		printf ("\n");
+	}
+}
+
+static void usage (void)
+{
+	fprintf (stderr, "usage: timing [-c file.circ] [-m microcode.raw] [-i keyboard.txt] [-n cycles] [-x stop_pc]\n"
+					 "              [-w idle_polls] [-t rows] [-e] [-q] image.raw\n");
+	exit (2);
+}
+
+int main (int argc, char **argv)
+{
+	const char *circ = "ALU_181_base.circ";
+	const char *micro_path = "seq.raw";
+	const char *input = NULL;
+	run_limits_t lim = { 0, -1, 0 };
+	int rows = 10;
+	bool edges = false;
+	bool quiet = false;
+	int opt;
+
+	while ((opt = getopt (argc, argv, "c:m:i:n:x:w:t:eq")) != -1)
+	{
+		switch (opt)
+		{
+			case 'c':	circ = optarg;								break;
+			case 'm':	micro_path = optarg;						break;
+			case 'i':	input = optarg;								break;
+			case 'n':	lim.max_cycles = strtoull (optarg, NULL, 0);	break;
+			case 'x':	lim.stop_pc = (int) strtol (optarg, NULL, 16);	break;
+			case 'w':	lim.idle_polls = strtoull (optarg, NULL, 0);	break;
+			case 't':	rows = atoi (optarg);						break;
+			case 'e':	edges = true;								break;
+			case 'q':	quiet = true;								break;
+			default:	usage ();
+		}
+	}
+	if (optind != argc - 1)
+	{
+		usage ();
+	}
+
+	if ((load_raw (micro_path, rom, ROM_WORDS, 4) < 0) || (load_raw (argv[optind], ram, MEM_SIZE, 1) < 0))
+	{
+		return 1;
+	}
+	if (input != NULL)
+	{
+		size_t len;
+		uint8_t *text = read_file (input, &len);
+		if (text == NULL)
+		{
+			return 1;
+		}
+		machine_input (&term, text, len);
+		free (text);
+	}
+	term.echo = !quiet && !edges;
+	if (!nl_import (&nl, circ, "Fake8080"))
+	{
+		return 1;
+	}
+	build ();
+
+	const nl_element_t *clock = find_element (NL_CLOCK, NULL);
+	const nl_element_t *seq_rom = find_element (NL_ROM, NULL);
+	const nl_element_t *pch = find_element (NL_REG, "Processor/Registers/PCH");
+	const nl_element_t *pcl = find_element (NL_REG, "Processor/Registers/PCL");
+	const nl_element_t *switches = NULL;
+	for (uint32_t i = 0; i < nl.elements; i++)
+	{
+		const nl_element_t *e = &nl.element[i];
+		if ((e->kind == NL_INPUT) && (strcmp (nl.names + e->name, "run") == 0))
+		{
+			for (uint32_t b = 0; b < e->outs; b++)
+			{
+				val[nl_out (&nl, e)[b]] = 1;
+			}
+		}
+		if ((e->kind == NL_INPUT) && (e->outs == 16))
+		{
+			switches = e;
+		}
+	}
+	if (switches == NULL)
+	{
+		fprintf (stderr, "There are no halt switches in %s\n", nl.top);
+		return 1;
+	}
+	uint32_t clk = find_net ("Processor/Clk");
+	uint32_t last = find_net ("Processor/last");
+	uint32_t address[16];
+	for (int b = 0; b < 16; b++)
+	{
+		char name[32];
+		snprintf (name, sizeof (name), "Address_Bus[%d]", b);
+		address[b] = find_net (name);
+	}
+
+	// power on: everything at zero but run, then every element has a look at its inputs
+	double t0 = seconds ();
+	uint32_t halt = 0x8000;
+	memcpy (before, val, nl.nets);
+	for (uint32_t i = 0; i < nl.elements; i++)
+	{
+		const nl_element_t *e = &nl.element[i];
+		for (uint32_t j = 0; j < e->outs; j++)
+		{
+			drive[e->pin + e->ins + j] = sched[e->pin + e->ins + j] = val[nl_out (&nl, e)[j]];
+		}
+	}
+	set_input (switches, halt);
+	for (uint32_t i = 0; i < nl.elements; i++)
+	{
+		trigger_delay[i] = (delay_data[i] > delay_control[i]) ? delay_data[i] : delay_control[i];
+		trigger_cause[i] = NONE;
+		eval (i, now);
+	}
+	run ();
+
+	static const char *reason[] = { "cycle limit", "stop address", "idle", "halt address" };
+	static path_t worst[2], path;
+	uint32_t slowest[2] = { 0, 0 };
+	uint64_t cycles = 0;
+	uint64_t instructions = 0;
+	int why = -1;
+	while (why < 0)
+	{
+		// the halt switches are kept off the address bus, as in gatesim
+		uint32_t at = bus_value (val, address, 16);
+		if (at == halt)
+		{
+			halt = at ^ 0x8000;
+			set_input (switches, halt);
+			run ();
+		}
+		bool ending = val[last];
+
+		for (int half = 0; half < 2; half++)
+		{
+			uint64_t edge_time = now;
+			last_time = now;
+			last_net = NONE;
+			set_input (clock, half ^ 1);
+			run ();
+			if ((half == 0) && !val[clk])
+			{
+				why = 3;
+				break;
+			}
+
+			uint32_t ns = (uint32_t) (last_time - edge_time);
+			uint32_t addr = bus_value (val, nl_in (&nl, seq_rom), seq_rom->arg) & (ROM_WORDS - 1);
+			micro_t *m = &micro[addr];
+			m->count += (half == 0);
+			if ((ns > m->ns[half]) || (m->count == 1))
+			{
+				m->ns[half] = ns;
+				m->net[half] = last_net;
+			}
+			if (ns > slowest[half])
+			{
+				slowest[half] = ns;
+				trace (&path, last_net, edge_time);
+				path.ns = ns;
+				path.addr = addr;
+				path.cycle = cycles;
+				worst[half] = path;
+			}
+			if (edges)
+			{
+				printf ("%llu %s %04x %u ", (unsigned long long) cycles, half ? "fall" : "rise", addr, ns);
+				print_net (stdout, last_net);
+				printf ("\n");
+			}
+		}
+		if (why >= 0)
+		{
+			break;
+		}
+		cycles++;
+
+		if (lim.max_cycles && (cycles >= lim.max_cycles))
+		{
+			why = STOP_CYCLES;
+		}
+		else if (ending)
+		{
+			instructions++;
+			uint16_t pc = (bus_value (val, nl_out (&nl, pch), 8) << 8) | bus_value (val, nl_out (&nl, pcl), 8);
+			if ((lim.stop_pc >= 0) && (pc == lim.stop_pc))
+			{
+				why = STOP_PC;
+			}
+			else if (lim.idle_polls && (term.kbd_pos == term.kbd_len) && (term.idle >= lim.idle_polls))
+			{
+				why = STOP_IDLE;
+			}
+		}
+	}
+	double t = seconds () - t0;
+
+	fflush (stdout);
+	fprintf (stderr, "\nstopped (%s) after %llu microcycles, %llu instructions, %.1f M events in %.3f s\n",
+		reason[why], (unsigned long long) cycles, (unsigned long long) instructions, total_events * 1e-6, t);
+	for (int half = 0; half < 2; half++)
+	{
+		print_micro (half, rows);
+	}
+	uint32_t period = slowest[0] + slowest[1];
+	printf ("\nthe clock needs %u ns high and %u ns low, a period of %u ns or %.2f MHz, before setup times\n",
+		slowest[0], slowest[1], period, period ? 1e3 / period : 0.0);
+	print_path (&worst[0], "rising");
+	print_path (&worst[1], "falling");
+	nl_free (&nl);
+	return 0;
+}